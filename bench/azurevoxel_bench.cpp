@@ -0,0 +1,1652 @@
+// Headless throughput benchmark for the chunk pipeline (generation, meshing, save/load).
+// Links only azurevoxel_core, so it runs on machines without a GPU or display.
+//
+// Usage: azurevoxel_bench [--workload flat|planet150|planet1000|load|mesher|edit|light|raycast|query|physics|bulkedit|atlas|registry|reload|all] [--radius N]
+//                         [--threads N] [--seed N] [--edits N]
+//        azurevoxel_bench --workload replay --path camera_path.txt [--report replay_report.json] [--unpaced]
+//                         [--prefetch-lookahead seconds] [--frame-budget ms]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "headers/chunk.h"
+#include "headers/world.h"
+#include "headers/block_registry.h"
+#include "headers/block_definition_watcher.h"
+#include "headers/logger.h"
+#include "headers/mesh_scratch.h"
+#include "headers/camera.h"
+#include "headers/camera_path.h"
+#include "headers/replay_report.h"
+#include "headers/texture_atlas.h"
+#include "headers/light_engine.h"
+#include "headers/chunk_residency_cache.h"
+#include "headers/voxel_raycast.h"
+#include "headers/voxel_physics.h"
+
+namespace {
+
+struct BenchOptions {
+    std::string workload = "all";
+    int radius = 14;        // In chunks; matches the planet streaming radius used in game
+    size_t threads = 0;     // 0 = hardware concurrency
+    int seed = 123;
+    std::string pathFile;                        // Camera path for the replay workload
+    std::string reportFile = "replay_report.json";
+    bool paced = true;                           // Replay in real time, like the game would
+    float prefetchLookahead = -1.0f;             // Seconds; < 0 keeps the World default, 0 disables prefetch
+    double frameBudgetMs = -1.0;                 // < 0 keeps the World default, 0 fixes the render distance
+    int edits = 2000;                            // Block edits made by the edit workload
+    int bodies = 4000;                           // Bodies stepped by the physics workload
+};
+
+struct StageResult {
+    std::string workload;
+    std::string stage;
+    size_t chunks = 0;
+    double seconds = 0.0;
+    size_t bytes = 0;
+};
+
+constexpr size_t CHUNK_DATA_BYTES = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z * sizeof(BlockInfo::type);
+const char* BENCH_WORLD_NAME = "azurevoxel_bench";
+
+// Peak resident set size of this process in MiB (ru_maxrss is in KiB on Linux); 0 where
+// getrusage is not available
+double peakRssMiB() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#else
+    return 0.0;
+#endif
+}
+
+// Run fn(i) for i in [0, count) on the pool and block until every task finished
+double runParallel(ChunkThreadPool& pool, size_t count, const std::function<void(size_t)>& fn) {
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    size_t remaining = count;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        pool.enqueueTask([&, i]() {
+            fn(i);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--remaining == 0) {
+                doneCondition.notify_one();
+            }
+        });
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [&]() { return remaining == 0; });
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct ChunkSet {
+    std::vector<glm::vec3> positions;
+    std::optional<glm::vec3> planetCenter;
+    std::optional<float> planetRadius;
+};
+
+// Flat world: one layer of chunks in a (2r+1)^2 square around the origin
+ChunkSet flatChunkSet(int radius) {
+    ChunkSet set;
+    for (int x = -radius; x <= radius; ++x) {
+        for (int z = -radius; z <= radius; ++z) {
+            set.positions.emplace_back(x * CHUNK_SIZE_X, 0.0f, z * CHUNK_SIZE_Z);
+        }
+    }
+    return set;
+}
+
+// Planet: the chunks Planet::update would stream in for a camera standing on the north pole
+ChunkSet planetChunkSet(float planetRadius, int radius) {
+    ChunkSet set;
+    set.planetCenter = glm::vec3(0.0f);
+    set.planetRadius = planetRadius;
+
+    const float chunkSizeF = static_cast<float>(CHUNK_SIZE_X);
+    const glm::ivec3 cameraChunkKey(0, static_cast<int>(std::floor(planetRadius / chunkSizeF)), 0);
+    for (int x = -radius; x <= radius; ++x) {
+        for (int y = -radius; y <= radius; ++y) {
+            for (int z = -radius; z <= radius; ++z) {
+                if (glm::length(glm::vec3(x, y, z)) > static_cast<float>(radius)) {
+                    continue;
+                }
+                glm::ivec3 key = cameraChunkKey + glm::ivec3(x, y, z);
+                glm::vec3 chunkCenterOffset = (glm::vec3(key) + glm::vec3(0.5f)) * chunkSizeF;
+                if (glm::length(chunkCenterOffset) <= planetRadius + chunkSizeF * 1.732f) {
+                    set.positions.push_back(glm::vec3(key) * chunkSizeF);
+                }
+            }
+        }
+    }
+    return set;
+}
+
+std::vector<std::shared_ptr<Chunk>> makeChunks(const ChunkSet& set) {
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    chunks.reserve(set.positions.size());
+    for (const glm::vec3& position : set.positions) {
+        chunks.push_back(std::make_shared<Chunk>(position));
+    }
+    return chunks;
+}
+
+// Generate (or load, when a World is given) and mesh every chunk in the set
+void runPipeline(const std::string& name, const ChunkSet& set, const World* world, int seed,
+                 ChunkThreadPool& pool, std::vector<StageResult>& results, bool mesh = true) {
+    std::vector<std::shared_ptr<Chunk>> chunks = makeChunks(set);
+
+    StageResult data{name, world ? "load" : "generate", chunks.size(), 0.0, chunks.size() * CHUNK_DATA_BYTES};
+    data.seconds = runParallel(pool, chunks.size(), [&](size_t i) {
+        chunks[i]->generateDataAsync(world, seed, set.planetCenter, set.planetRadius);
+    });
+    results.push_back(data);
+
+    if (!mesh) {
+        return;
+    }
+    StageResult meshing{name, "mesh", chunks.size(), 0.0, 0};
+    meshing.seconds = runParallel(pool, chunks.size(), [&](size_t i) {
+        chunks[i]->buildMeshAsync(world);
+    });
+    for (const auto& chunk : chunks) {
+        meshing.bytes += chunk->getMeshDataBytes();
+    }
+    results.push_back(meshing);
+}
+
+// Ask the kernel to drop cached pages of the saved chunk files so the next read hits the disk.
+// Only POSIX systems with posix_fadvise can do this; elsewhere the cold load reads warm pages.
+void evictFromPageCache(const std::filesystem::path& directory) {
+#ifdef __unix__
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        int fd = open(entry.path().c_str(), O_RDONLY);
+        if (fd < 0) {
+            continue;
+        }
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#else
+    (void)directory;
+    std::cerr << "load: cold-cache runs are not supported on this platform, load_cold reads from the page cache" << std::endl;
+#endif
+}
+
+// Cold vs warm load of the radius-150 planet set from chunk_data/azurevoxel_bench
+void runLoadWorkload(const BenchOptions& options, ChunkThreadPool& pool, std::vector<StageResult>& results) {
+    const std::filesystem::path dataPath = std::filesystem::path("chunk_data") / BENCH_WORLD_NAME;
+    std::filesystem::remove_all(dataPath);
+
+    {
+        World world(BENCH_WORLD_NAME, options.seed);
+        ChunkSet set = planetChunkSet(150.0f, options.radius);
+
+        // First pass finds no files: generate + save
+        runPipeline("load_populate", set, &world, options.seed, pool, results, false);
+        results.back().stage = "generate+save";
+
+        evictFromPageCache(dataPath);
+        runPipeline("load_cold", set, &world, options.seed, pool, results, false);
+
+        runPipeline("load_warm", set, &world, options.seed, pool, results, false);
+    }
+
+    std::filesystem::remove_all(dataPath);
+}
+
+// Sorted quads (4 vertices x pos3/uv2/light) of a chunk's CPU mesh, so meshes that emit the same
+// faces in a different order compare equal
+using CanonicalFace = std::array<float, 4 * CHUNK_VERTEX_FLOATS>;
+std::vector<CanonicalFace> canonicalFaces(const Chunk& chunk) {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    chunk.copyMeshData(vertices, indices);
+    std::vector<CanonicalFace> faces;
+    faces.reserve(indices.size() / 6);
+    for (size_t i = 0; i + 5 < indices.size(); i += 6) {
+        // A quad split along its other diagonal starts at its second vertex
+        const unsigned int first = *std::min_element(indices.begin() + i, indices.begin() + i + 6);
+        CanonicalFace face;
+        std::copy_n(vertices.begin() + first * CHUNK_VERTEX_FLOATS, face.size(), face.begin());
+        faces.push_back(face);
+    }
+    std::sort(faces.begin(), faces.end());
+    return faces;
+}
+
+// Both meshers on the same planet chunks, with neighbour culling between them: times each one and
+// checks that the bitmask mesher emits exactly the faces of the per-voxel reference. The bitmask
+// mesher runs again without ambient occlusion, which shows what the baked occlusion costs.
+bool runMesherWorkload(const BenchOptions& options, ChunkThreadPool& pool, std::vector<StageResult>& results) {
+    ChunkSet set = planetChunkSet(150.0f, options.radius);
+    std::vector<std::shared_ptr<Chunk>> chunks = makeChunks(set);
+    runParallel(pool, chunks.size(), [&](size_t i) {
+        chunks[i]->generateDataAsync(nullptr, options.seed, set.planetCenter, set.planetRadius);
+    });
+
+    std::unordered_map<glm::ivec3, size_t, IVec3Hash> chunkByKey;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunkByKey[glm::ivec3(glm::floor(chunks[i]->getPosition() / static_cast<float>(CHUNK_SIZE_X)))] = i;
+    }
+    const glm::ivec3 faceOffsets[6] = {{0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}};
+    std::vector<ChunkNeighbors> neighbors(chunks.size());
+    for (const auto& [key, i] : chunkByKey) {
+        for (int face = 0; face < 6; ++face) {
+            auto it = chunkByKey.find(key + faceOffsets[face]);
+            if (it != chunkByKey.end()) {
+                neighbors[i].faces[face] = chunks[it->second]->getVoxelSnapshot();
+            }
+        }
+    }
+
+    struct MesherRun {
+        ChunkMesher mesher;
+        bool ambientOcclusion;
+        const char* name;
+    };
+    const MesherRun runs[] = {{ChunkMesher::PER_VOXEL, true, "per_voxel"}, {ChunkMesher::BITMASK, true, "bitmask"},
+                              {ChunkMesher::BITMASK, false, "bitmask_no_ao"}};
+    std::vector<std::vector<CanonicalFace>> reference(chunks.size());
+    size_t mismatches = 0;
+    size_t corners = 0;
+    size_t occludedCorners = 0;
+    for (const auto& [mesher, ambientOcclusion, name] : runs) {
+        Chunk::setMesher(mesher);
+        Chunk::setAmbientOcclusion(ambientOcclusion);
+        StageResult meshing{"mesher", name, chunks.size(), 0.0, 0};
+        meshing.seconds = runParallel(pool, chunks.size(), [&](size_t i) {
+            chunks[i]->buildMeshAsync(nullptr, neighbors[i]);
+        });
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            meshing.bytes += chunks[i]->getMeshDataBytes();
+            std::vector<CanonicalFace> faces = canonicalFaces(*chunks[i]);
+            if (mesher == ChunkMesher::PER_VOXEL) {
+                reference[i] = std::move(faces);
+            } else if (ambientOcclusion) {
+                mismatches += faces != reference[i] ? 1 : 0;
+                for (const CanonicalFace& face : faces) {
+                    for (int corner = 0; corner < 4; ++corner) {
+                        ++corners;
+                        occludedCorners += face[corner * CHUNK_VERTEX_FLOATS + 5] < CHUNK_VERTEX_AO_OPEN * CHUNK_VERTEX_AO_SCALE ? 1 : 0;
+                    }
+                }
+            }
+            chunks[i]->releaseCpuMesh(); // Back to DATA_READY for the next mesher
+        }
+        results.push_back(meshing);
+    }
+    Chunk::setMesher(ChunkMesher::BITMASK);
+    Chunk::setAmbientOcclusion(true);
+
+    if (mismatches > 0) {
+        std::cerr << "mesher: bitmask output differs from per_voxel in " << mismatches << " of " << chunks.size() << " chunks" << std::endl;
+        return false;
+    }
+    std::cout << "mesher: bitmask output matches per_voxel in all " << chunks.size() << " chunks; ambient occlusion darkens "
+              << occludedCorners << " of " << corners << " face corners" << std::endl;
+    return true;
+}
+
+// Streams a fixed region of the world's planet (centred at the origin) around a camera just above
+// its north pole until the pipeline is idle, and returns the height of the surface at the pole
+float streamPlanetSurface(World& world, float planetRadius, int renderDistance) {
+    StreamingBudgetSettings budget = world.getStreamingBudget().getSettings();
+    budget.enabled = false;
+    budget.initialRenderDistance = renderDistance;
+    budget.initialChunksPerFrame = budget.maxChunksPerFrame;
+    world.getStreamingBudget().setSettings(budget);
+
+    Camera camera;
+    camera.setPosition(glm::vec3(0.0f, planetRadius + 4.0f, 0.0f));
+    int idleFrames = 0;
+    for (int frame = 0; frame < 5000 && idleFrames < 10; ++frame) {
+        world.update(camera, 1.0f / 60.0f);
+        world.processMainThreadTasks();
+        idleFrames = world.getPipelineBacklog().total() == 0 ? idleFrames + 1 : 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    float surfaceY = planetRadius + 24.0f;
+    while (surfaceY > planetRadius - 24.0f && !world.getBlockAtWorldPos(glm::vec3(0.5f, surfaceY, 0.5f))) {
+        surfaceY -= 1.0f;
+    }
+    return surfaceY;
+}
+
+// Runs a workload on a fresh world holding one planet of planetRadius at the origin, with the
+// surface around its north pole streamed in. The world's chunk data is removed before and after.
+// body(world, surfaceY) returns whether the workload passed.
+bool runOnStreamedPlanet(const BenchOptions& options, const std::string& name, float planetRadius, int renderDistance,
+                         const std::function<bool(World&, float)>& body) {
+    const std::string worldName = "azurevoxel_bench_" + name;
+    const std::filesystem::path dataPath = std::filesystem::path("chunk_data") / worldName;
+    std::filesystem::remove_all(dataPath);
+    bool ok = false;
+    {
+        World world(worldName, options.seed);
+        world.addPlanet(glm::vec3(0.0f), planetRadius, options.seed, worldName);
+        ok = body(world, streamPlanetSurface(world, planetRadius, renderDistance));
+    }
+    std::filesystem::remove_all(dataPath);
+    return ok;
+}
+
+// Single-block edits on the streamed surface of a planet, each made visible (re-meshed and handed
+// to the render backend) before the next one, as a player breaking and placing blocks would
+bool runEditWorkload(const BenchOptions& options) {
+    const float planetRadius = 150.0f;
+    std::vector<double> latenciesUs;
+    size_t borderEdits = 0;
+    double editSeconds = 0.0;
+    // A small fixed region is enough to surround the edits and keeps the warm-up short
+    runOnStreamedPlanet(options, "edit", planetRadius, 3, [&](World& world, float surfaceY) {
+        const uint16_t stone = BlockRegistry::getInstance().getBlockId("azurevoxel:stone");
+        std::mt19937 rng(static_cast<unsigned int>(options.seed));
+        std::uniform_int_distribution<int> horizontal(-12, 12);
+        std::uniform_int_distribution<int> vertical(-4, 2);
+        latenciesUs.reserve(static_cast<size_t>(options.edits));
+
+        for (int attempt = 0; attempt < options.edits * 4 && static_cast<int>(latenciesUs.size()) < options.edits; ++attempt) {
+            glm::vec3 pos(horizontal(rng) + 0.5f, surfaceY + vertical(rng) + 0.5f, horizontal(rng) + 0.5f);
+            uint16_t type = world.getBlockAtWorldPos(pos) ? 0 : stone;
+
+            auto start = std::chrono::steady_clock::now();
+            if (!world.setBlockAtWorldPos(pos, type)) {
+                continue;
+            }
+            world.rebuildEditedChunks();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            editSeconds += seconds;
+            latenciesUs.push_back(seconds * 1e6);
+
+            glm::ivec3 local = glm::ivec3(glm::floor(pos)) - glm::ivec3(glm::floor(pos / static_cast<float>(CHUNK_SIZE_X))) * CHUNK_SIZE_X;
+            if (local.x == 0 || local.x == CHUNK_SIZE_X - 1 || local.y == 0 || local.y == CHUNK_SIZE_Y - 1 ||
+                local.z == 0 || local.z == CHUNK_SIZE_Z - 1) {
+                ++borderEdits;
+            }
+        }
+        return true;
+    });
+
+    if (latenciesUs.empty()) {
+        std::cerr << "edit workload: no block could be edited (surface not streamed in?)" << std::endl;
+        return false;
+    }
+    std::vector<double> sorted = latenciesUs;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) { return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))]; };
+    std::cout << std::fixed << std::setprecision(1)
+              << "edit: " << sorted.size() << " edits (" << borderEdits << " on chunk borders), "
+              << static_cast<double>(sorted.size()) / editSeconds << " edits/s\n"
+              << "edit-to-upload latency: p50 " << percentile(0.5) << " us, p99 " << percentile(0.99)
+              << " us, max " << sorted.back() << " us" << std::endl;
+    return true;
+}
+
+// Flood-fill lighting on a closed 4x4x4 box of planet chunks around the pole. Times first lighting
+// per chunk, then makes random digs, placements and light sources and relights them
+// incrementally the way Planet does (batches over the chunks around the seeds, spills carried
+// to the next batch), and checks the result against relighting the whole box from scratch.
+bool runLightWorkload(const BenchOptions& options) {
+    const float planetRadius = 150.0f;
+    const glm::vec3 planetCenter(0.0f);
+    const float chunkSizeF = static_cast<float>(CHUNK_SIZE_X);
+    BlockRegistry& registry = BlockRegistry::getInstance();
+    auto secondsSince = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    std::unordered_map<glm::ivec3, std::shared_ptr<Chunk>, IVec3Hash> chunks;
+    std::vector<glm::ivec3> keys;
+    for (int x = -2; x <= 1; ++x) {
+        for (int y = 7; y <= 10; ++y) {
+            for (int z = -2; z <= 1; ++z) {
+                glm::ivec3 key(x, y, z);
+                auto chunk = std::make_shared<Chunk>(glm::vec3(key) * chunkSizeF);
+                chunk->setPlanetContext(planetCenter, planetRadius);
+                chunk->generateDataAsync(nullptr, options.seed, planetCenter, planetRadius);
+                chunks[key] = chunk;
+                keys.push_back(key);
+            }
+        }
+    }
+    auto regionMember = [&](const glm::ivec3& key, const LightSnapshot& light) {
+        LightRegionChunk member;
+        member.key = key;
+        member.voxels = chunks[key]->getVoxelSnapshot();
+        member.light = light;
+        member.sky = skyContextForChunk(chunks[key]->getPosition(), planetCenter, planetRadius);
+        return member;
+    };
+
+    // First lighting of a chunk on its own, as a mesh build does it
+    constexpr int LIGHT_ROUNDS = 20;
+    LightData scratch;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < LIGHT_ROUNDS; ++round) {
+        for (const glm::ivec3& key : keys) {
+            LightEngine::lightChunk(*chunks[key]->getVoxelSnapshot(), ChunkNeighbors(),
+                                    skyContextForChunk(chunks[key]->getPosition(), planetCenter, planetRadius), scratch);
+        }
+    }
+    const double chunkSeconds = secondsSince(start);
+
+    auto relightBox = [&](std::unordered_map<glm::ivec3, LightSnapshot, IVec3Hash>& lights) {
+        std::vector<LightRegionChunk> region;
+        for (const glm::ivec3& key : keys) {
+            region.push_back(regionMember(key, nullptr));
+        }
+        LightBatchResult result = LightEngine::relight(region);
+        lights.clear();
+        for (const LightUpdate& update : result.updates) {
+            if (update.light) {
+                lights[update.key] = update.light;
+            }
+        }
+        for (const glm::ivec3& key : keys) {
+            if (!lights.count(key)) {
+                lights[key] = std::make_shared<LightData>();
+            }
+        }
+    };
+    std::unordered_map<glm::ivec3, LightSnapshot, IVec3Hash> lights;
+    start = std::chrono::steady_clock::now();
+    relightBox(lights);
+    const double relightSeconds = secondsSince(start);
+
+    // Emitters (15 and 12 in the stock definitions) and a solid block to place
+    std::vector<uint16_t> emitters;
+    for (uint16_t id = 1; id < 64; ++id) {
+        if (registry.getBlockLightLevel(id) > 0 && registry.getBlockDefinition(id)) {
+            emitters.push_back(id);
+        }
+    }
+    const uint16_t stone = registry.getBlockId("azurevoxel:stone");
+
+    std::mt19937 rng(static_cast<unsigned int>(options.seed));
+    std::uniform_int_distribution<int> pickChunk(0, static_cast<int>(keys.size()) - 1);
+    std::uniform_int_distribution<int> pickLocal(0, CHUNK_SIZE_X - 1);
+    std::uniform_int_distribution<int> pickKind(0, 3);
+    const int edits = std::min(options.edits, 1000);
+    constexpr int EDITS_PER_FRAME = 8;
+
+    std::vector<LightSeed> pending;
+    size_t batches = 0;
+    size_t spilled = 0;
+    size_t changedVoxels = 0;
+    double batchSeconds = 0.0;
+    // One Planet::dispatchLightUpdates: every chunk of the box within one chunk of a seed
+    auto runBatch = [&]() {
+        std::unordered_set<glm::ivec3, IVec3Hash> regionKeys;
+        for (const LightSeed& seed : pending) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dz = -1; dz <= 1; ++dz) {
+                        glm::ivec3 key = seed.chunk + glm::ivec3(dx, dy, dz);
+                        if (chunks.count(key)) {
+                            regionKeys.insert(key);
+                        }
+                    }
+                }
+            }
+        }
+        std::vector<LightRegionChunk> region;
+        for (const glm::ivec3& key : regionKeys) {
+            region.push_back(regionMember(key, lights[key]));
+        }
+        std::vector<LightSeed> seeds;
+        seeds.swap(pending);
+        auto batchStart = std::chrono::steady_clock::now();
+        LightBatchResult result = LightEngine::propagate(region, seeds);
+        batchSeconds += secondsSince(batchStart);
+        ++batches;
+        changedVoxels += result.changedVoxels;
+        for (const LightUpdate& update : result.updates) {
+            if (update.light) {
+                lights[update.key] = update.light;
+            }
+        }
+        // Light leaving the box is dropped, as Planet drops it for chunks that are not loaded
+        for (const LightSeed& spill : result.spills) {
+            if (chunks.count(spill.chunk)) {
+                pending.push_back(spill);
+                ++spilled;
+            }
+        }
+    };
+
+    int made = 0;
+    for (int attempt = 0; attempt < edits * 4 && made < edits; ++attempt) {
+        const glm::ivec3 key = keys[static_cast<size_t>(pickChunk(rng))];
+        const int x = pickLocal(rng), y = pickLocal(rng), z = pickLocal(rng);
+        const uint16_t current = static_cast<uint16_t>(chunks[key]->getVoxelSnapshot()->at(x, y, z).type);
+        const int kind = pickKind(rng);
+        uint16_t type;
+        if (current != 0) {
+            type = 0; // Dig
+        } else if (kind == 0 && !emitters.empty()) {
+            type = emitters[static_cast<size_t>(made) % emitters.size()];
+        } else {
+            type = stone;
+        }
+        if (!chunks[key]->setBlockTypeAtLocal(x, y, z, type)) {
+            continue;
+        }
+        LightSeed seed;
+        seed.chunk = key;
+        seed.index = static_cast<uint16_t>(VoxelData::index(x, y, z));
+        pending.push_back(seed);
+        if (++made % EDITS_PER_FRAME == 0) {
+            runBatch();
+        }
+    }
+    while (!pending.empty()) {
+        runBatch();
+    }
+
+    std::unordered_map<glm::ivec3, LightSnapshot, IVec3Hash> reference;
+    relightBox(reference);
+    size_t mismatches = 0;
+    for (const glm::ivec3& key : keys) {
+        for (size_t i = 0; i < VoxelData::VOLUME; ++i) {
+            if (lights[key]->values[i] != reference[key]->values[i]) {
+                if (mismatches == 0) {
+                    std::cerr << "light: incremental light differs from a full relight in chunk " << key.x << "," << key.y << ","
+                              << key.z << " voxel " << i << ": sky " << int(lights[key]->sky(i)) << " vs "
+                              << int(reference[key]->sky(i)) << ", block " << int(lights[key]->block(i)) << " vs "
+                              << int(reference[key]->block(i)) << std::endl;
+                }
+                ++mismatches;
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "light: first lighting " << keys.size() * LIGHT_ROUNDS / chunkSeconds << " chunks/s, full relight of "
+              << keys.size() << " chunks " << relightSeconds * 1000.0 << " ms\n"
+              << "light: " << made << " edits in " << batches << " batches (" << spilled << " spilled seeds, "
+              << changedVoxels << " voxels relit), " << made / batchSeconds << " edits/s, "
+              << batchSeconds / batches * 1e6 << " us per batch" << std::endl;
+    if (mismatches > 0) {
+        std::cerr << "light: " << mismatches << " voxels differ from the reference" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Block picking the way the query existed before World::raycast: Amanatides-Woo steps with a
+// World::getBlockAtWorldPos lookup (planet scan, hash lookup, chunk lock) for every block
+RaycastHit referenceRaycast(const World& world, const glm::vec3& gridOrigin, const glm::vec3& origin, const glm::vec3& dir,
+                            float maxDistance) {
+    RaycastHit result;
+    const glm::vec3 start = origin - gridOrigin;
+    glm::ivec3 block(glm::floor(start));
+    glm::ivec3 step(0);
+    glm::vec3 nextBoundary(std::numeric_limits<float>::infinity());
+    glm::vec3 boundarySpacing(std::numeric_limits<float>::infinity());
+    for (int axis = 0; axis < 3; ++axis) {
+        if (dir[axis] != 0.0f) {
+            step[axis] = dir[axis] > 0.0f ? 1 : -1;
+            boundarySpacing[axis] = std::abs(1.0f / dir[axis]);
+            nextBoundary[axis] = (dir[axis] > 0.0f ? block[axis] + 1.0f - start[axis] : start[axis] - block[axis]) * boundarySpacing[axis];
+        }
+    }
+    float distance = 0.0f;
+    int enteredAxis = -1;
+    while (true) {
+        if (world.getBlockAtWorldPos(gridOrigin + glm::vec3(block) + glm::vec3(0.5f))) {
+            result.hit = true;
+            result.block = block;
+            if (enteredAxis >= 0) {
+                result.normal[enteredAxis] = -step[enteredAxis];
+            }
+            result.distance = distance;
+            return result;
+        }
+        const int axis = nextBoundary.x < nextBoundary.y ? (nextBoundary.x < nextBoundary.z ? 0 : 2)
+                                                         : (nextBoundary.y < nextBoundary.z ? 1 : 2);
+        distance = nextBoundary[axis];
+        if (distance > maxDistance) {
+            return result;
+        }
+        nextBoundary[axis] += boundarySpacing[axis];
+        block[axis] += step[axis];
+        enteredAxis = axis;
+    }
+}
+
+// Rays from above the streamed surface of a planet in random directions, as picking, line of
+// sight and AI queries would cast them. Times World::raycast against per-block
+// getBlockAtWorldPos lookups and fails if the two disagree on any ray.
+bool runRaycastWorkload(const BenchOptions& options) {
+    const float planetRadius = 150.0f;
+    const float maxDistance = 48.0f;
+    const size_t rayCount = 20000;
+    const int fastRepeats = 10; // The fast path is timed over more rays for a stable rate
+    return runOnStreamedPlanet(options, "raycast", planetRadius, 4, [&](World& world, float surfaceY) {
+        bool ok = true;
+
+        std::mt19937 rng(static_cast<unsigned int>(options.seed));
+        std::uniform_real_distribution<float> horizontal(-20.0f, 20.0f);
+        std::uniform_real_distribution<float> height(1.5f, 12.0f);
+        std::normal_distribution<float> gaussian(0.0f, 1.0f);
+        std::vector<std::pair<glm::vec3, glm::vec3>> rays(rayCount);
+        for (auto& [origin, dir] : rays) {
+            origin = glm::vec3(horizontal(rng), surfaceY + height(rng), horizontal(rng));
+            do {
+                dir = glm::vec3(gaussian(rng), gaussian(rng), gaussian(rng));
+            } while (glm::length(dir) < 1e-3f);
+            dir = glm::normalize(dir);
+        }
+
+        std::vector<RaycastHit> hits(rayCount);
+        auto start = std::chrono::steady_clock::now();
+        for (int repeat = 0; repeat < fastRepeats; ++repeat) {
+            for (size_t i = 0; i < rayCount; ++i) {
+                hits[i] = world.raycast(rays[i].first, rays[i].second, maxDistance);
+            }
+        }
+        const double fastSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t hitCount = 0;
+        size_t mismatches = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rayCount; ++i) {
+            const RaycastHit reference = referenceRaycast(world, glm::vec3(0.0f), rays[i].first, rays[i].second, maxDistance);
+            hitCount += hits[i].hit ? 1 : 0;
+            if (reference.hit != hits[i].hit ||
+                (reference.hit && (reference.block != hits[i].block || reference.normal != hits[i].normal))) {
+                ++mismatches;
+            }
+        }
+        const double referenceSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Unlimited rays end where they leave the planet: the same hits as a distance past its far side
+        size_t unlimitedMismatches = 0;
+        for (size_t i = 0; i < rayCount; i += 10) {
+            const RaycastHit unlimited = world.raycast(rays[i].first, rays[i].second, std::numeric_limits<float>::infinity());
+            const RaycastHit bounded = world.raycast(rays[i].first, rays[i].second, 4.0f * planetRadius);
+            if (unlimited.hit != bounded.hit || unlimited.block != bounded.block) {
+                ++unlimitedMismatches;
+            }
+        }
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "raycast: " << rayCount << " rays up to " << maxDistance << " blocks (" << hitCount << " hit)\n"
+                  << "raycast: World::raycast " << fastRepeats * rayCount / fastSeconds << " rays/s, getBlockAtWorldPos steps "
+                  << rayCount / referenceSeconds << " rays/s" << std::endl;
+        if (mismatches > 0) {
+            std::cerr << "raycast: " << mismatches << " rays differ from the per-block lookup" << std::endl;
+            ok = false;
+        }
+        if (unlimitedMismatches > 0) {
+            std::cerr << "raycast: " << unlimitedMismatches << " rays with an infinite maxDistance differ from bounded ones" << std::endl;
+            ok = false;
+        }
+        return ok;
+    });
+}
+
+// Box and sphere queries around a streamed planet surface, sized like collision, AI sensing and
+// explosion queries. Times World::queryBlocks against a getBlockAtWorldPos call per block and
+// fails if any block differs.
+bool runQueryWorkload(const BenchOptions& options) {
+    const float planetRadius = 150.0f;
+    return runOnStreamedPlanet(options, "query", planetRadius, 4, [&](World& world, float surfaceY) {
+        bool ok = true;
+
+        auto referenceId = [&](const glm::vec3& pos) -> uint16_t {
+            std::shared_ptr<Block> block = world.getBlockAtWorldPos(pos);
+            return block ? static_cast<uint16_t>(block->getBlockType()) : 0;
+        };
+
+        std::mt19937 rng(static_cast<unsigned int>(options.seed));
+        std::uniform_real_distribution<float> horizontal(-24.0f, 24.0f);
+        std::uniform_real_distribution<float> vertical(-8.0f, 4.0f);
+        std::vector<uint16_t> blocks;
+        BlockQueryRegion region;
+        size_t mismatches = 0;
+
+        struct QueryShape {
+            const char* name;
+            float extent;   // Box edge or sphere diameter, in blocks
+            bool sphere;
+            int queries;
+        };
+        const QueryShape shapes[] = {{"box 3", 3.0f, false, 20000}, {"box 8", 8.0f, false, 4000},
+                                     {"box 32", 32.0f, false, 200}, {"sphere 12", 12.0f, true, 1000}};
+        std::cout << std::fixed << std::setprecision(1);
+        for (const QueryShape& shape : shapes) {
+            std::vector<glm::vec3> centers(static_cast<size_t>(shape.queries));
+            for (glm::vec3& center : centers) {
+                center = glm::vec3(horizontal(rng), surfaceY + vertical(rng), horizontal(rng));
+            }
+            const glm::vec3 half(shape.extent * 0.5f);
+
+            size_t blockCount = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (const glm::vec3& center : centers) {
+                if (shape.sphere) {
+                    world.queryBlocksInSphere(center, half.x, blocks, region);
+                } else {
+                    world.queryBlocks(center - half, center + half, blocks, region);
+                }
+                blockCount += blocks.size();
+            }
+            const double bulkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            // Per-block lookups over the same boxes, checked against a fresh bulk query
+            double referenceSeconds = 0.0;
+            std::vector<uint16_t> reference;
+            for (const glm::vec3& center : centers) {
+                if (shape.sphere) {
+                    world.queryBlocksInSphere(center, half.x, blocks, region);
+                } else {
+                    world.queryBlocks(center - half, center + half, blocks, region);
+                }
+                reference.assign(blocks.size(), 0);
+                start = std::chrono::steady_clock::now();
+                size_t i = 0;
+                for (int x = 0; x < region.size.x; ++x) {
+                    for (int y = 0; y < region.size.y; ++y) {
+                        for (int z = 0; z < region.size.z; ++z, ++i) {
+                            const glm::vec3 blockCenter = region.worldOrigin + glm::vec3(x, y, z) + glm::vec3(0.5f);
+                            const glm::vec3 offset = blockCenter - center;
+                            if (!shape.sphere || glm::dot(offset, offset) <= half.x * half.x) {
+                                reference[i] = referenceId(blockCenter);
+                            }
+                        }
+                    }
+                }
+                referenceSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                mismatches += reference != blocks ? 1 : 0;
+            }
+
+            std::cout << "query " << shape.name << ": " << shape.queries << " queries, "
+                      << shape.queries / bulkSeconds << " queries/s, " << blockCount / bulkSeconds / 1e6 << " M blocks/s (getBlockAtWorldPos: "
+                      << blockCount / referenceSeconds / 1e6 << " M blocks/s)" << std::endl;
+        }
+        if (mismatches > 0) {
+            std::cerr << "query: " << mismatches << " queries differ from per-block lookups" << std::endl;
+            ok = false;
+        }
+        return ok;
+    });
+}
+
+// Headless server tick: --bodies N boxes the size of players and small mobs dropped onto a
+// streamed planet surface and walking in random directions, stepped against voxel occupancy.
+// Fails if any body ends a tick inside a solid block (checked with getBlockAtWorldPos).
+bool runPhysicsWorkload(const BenchOptions& options) {
+    const float planetRadius = 150.0f;
+    const int ticks = 200;
+    const float tickSeconds = 1.0f / 20.0f;
+    return runOnStreamedPlanet(options, "physics", planetRadius, 4, [&](World& world, float surfaceY) {
+        bool ok = true;
+        const BlockRegistry& registry = BlockRegistry::getInstance();
+
+        std::mt19937 rng(static_cast<unsigned int>(options.seed));
+        std::uniform_real_distribution<float> horizontal(-40.0f, 40.0f);
+        std::uniform_real_distribution<float> height(2.0f, 20.0f);
+        std::uniform_real_distribution<float> walk(-4.0f, 4.0f);
+        auto solidAt = [&](const glm::vec3& worldPos) {
+            std::shared_ptr<Block> block = world.getBlockAtWorldPos(worldPos);
+            return block && registry.isBlockSolid(static_cast<uint16_t>(block->getBlockType()));
+        };
+        // Top of the highest solid column under any corner of a footprint
+        auto groundUnder = [&](float x, float z, float halfWidth) {
+            float ground = surfaceY - 24.0f;
+            for (float cx : {x - halfWidth, x + halfWidth}) {
+                for (float cz : {z - halfWidth, z + halfWidth}) {
+                    float y = surfaceY + 24.0f;
+                    while (y > ground && !solidAt(glm::vec3(cx, y + 0.5f, cz))) {
+                        y -= 1.0f;
+                    }
+                    ground = std::max(ground, std::floor(y) + 1.0f);
+                }
+            }
+            return ground;
+        };
+
+        std::vector<PhysicsBody> bodies(static_cast<size_t>(options.bodies));
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            PhysicsBody& body = bodies[i];
+            body.halfExtents = i % 2 == 0 ? glm::vec3(0.3f, 0.9f, 0.3f) : glm::vec3(0.25f, 0.25f, 0.25f);
+            const float x = horizontal(rng);
+            const float z = horizontal(rng);
+            body.position = glm::vec3(x, groundUnder(x, z, body.halfExtents.x) + body.halfExtents.y + height(rng), z);
+            body.velocity = glm::vec3(walk(rng), 0.0f, walk(rng));
+        }
+
+        // Independent of the collider: every block the box overlaps, through the per-block query
+        auto insideSolid = [&](const PhysicsBody& body) {
+            const glm::ivec3 first(glm::floor(body.position - body.halfExtents + 0.01f));
+            const glm::ivec3 last(glm::floor(body.position + body.halfExtents - 0.01f));
+            for (int x = first.x; x <= last.x; ++x) {
+                for (int y = first.y; y <= last.y; ++y) {
+                    for (int z = first.z; z <= last.z; ++z) {
+                        if (solidAt(glm::vec3(x, y, z) + glm::vec3(0.5f))) {
+                            return true;
+                        }
+                    }
+                }
+            }
+            return false;
+        };
+
+        PhysicsSettings settings;
+        settings.planetCenter = glm::vec3(0.0f);
+        VoxelCollider collider = world.getPlanetAt(glm::vec3(0.0f, surfaceY, 0.0f))->makeCollider();
+        size_t overlapping = 0;
+        double stepSeconds = 0.0;
+        for (int tick = 0; tick < ticks; ++tick) {
+            auto start = std::chrono::steady_clock::now();
+            VoxelPhysics::step(collider, bodies, tickSeconds, settings);
+            stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (tick % 20 == 19) {
+                overlapping += static_cast<size_t>(std::count_if(bodies.begin(), bodies.end(), insideSolid));
+            }
+        }
+        const size_t grounded = static_cast<size_t>(std::count_if(bodies.begin(), bodies.end(),
+                                                                  [](const PhysicsBody& body) { return body.onGround; }));
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "physics: " << bodies.size() << " bodies x " << ticks << " ticks (" << grounded << " on the ground at the end), "
+                  << ticks / stepSeconds << " ticks/s, " << bodies.size() * ticks / stepSeconds / 1e6 << " M body-steps/s, "
+                  << stepSeconds / ticks * 1e3 << " ms per tick" << std::endl;
+        if (overlapping > 0) {
+            std::cerr << "physics: " << overlapping << " body checks found a body inside a solid block" << std::endl;
+            ok = false;
+        }
+        return ok;
+    });
+}
+
+// Tool-sized edits on a streamed planet surface: box and sphere fills and a replace through the
+// World bulk edits (one voxel version and one re-mesh per touched chunk), against the same blocks
+// set one setBlockAtWorldPos at a time. Each stage starts from the original terrain and fails if
+// the two leave different blocks. An explosion is then checked against its breaking rule.
+bool runBulkEditWorkload(const BenchOptions& options) {
+    const float planetRadius = 150.0f;
+    return runOnStreamedPlanet(options, "bulkedit", planetRadius, 4, [&](World& world, float surfaceY) {
+        bool ok = true;
+        const BlockRegistry& registry = BlockRegistry::getInstance();
+        const uint16_t stone = registry.getBlockId("azurevoxel:stone");
+        const uint16_t grass = registry.getBlockId("azurevoxel:grass");
+
+        auto secondsSince = [](std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        // Put back saved blocks one at a time (untimed) and re-mesh them
+        auto restore = [&](const BlockQueryRegion& region, const std::vector<uint16_t>& types) {
+            size_t i = 0;
+            for (int x = 0; x < region.size.x; ++x) {
+                for (int y = 0; y < region.size.y; ++y) {
+                    for (int z = 0; z < region.size.z; ++z, ++i) {
+                        world.setBlockAtWorldPos(region.worldOrigin + glm::vec3(x, y, z) + glm::vec3(0.5f), types[i]);
+                    }
+                }
+            }
+            world.rebuildEditedChunks();
+        };
+
+        enum class Shape { FILL_BOX, FILL_SPHERE, REPLACE };
+        struct BulkStage {
+            const char* name;
+            Shape shape;
+            glm::vec3 extent;  // Box size; a sphere's diameter in x
+            uint16_t type;     // Fill type, or the type REPLACE writes over stone
+        };
+        const BulkStage stages[] = {{"sphere 16 air", Shape::FILL_SPHERE, glm::vec3(16.0f), 0},
+                                    {"sphere 48 air", Shape::FILL_SPHERE, glm::vec3(48.0f), 0},
+                                    {"box 48x16x48 stone", Shape::FILL_BOX, glm::vec3(48.0f, 16.0f, 48.0f), stone},
+                                    {"replace 64x32x64 stone->grass", Shape::REPLACE, glm::vec3(64.0f, 32.0f, 64.0f), grass}};
+        const glm::vec3 center(0.5f, surfaceY, 0.5f);
+        std::vector<uint16_t> original;
+        std::vector<uint16_t> expected;
+        std::vector<uint16_t> result;
+        BlockQueryRegion region;
+        std::cout << std::fixed << std::setprecision(1);
+        for (const BulkStage& stage : stages) {
+            const glm::vec3 boxMin = center - stage.extent * 0.5f;
+            const glm::vec3 boxMax = center + stage.extent * 0.5f;
+            const float radius = stage.extent.x * 0.5f;
+            world.queryBlocks(boxMin, boxMax, original, region);
+            auto newType = [&](const glm::vec3& blockCenter, uint16_t current) -> uint16_t {
+                switch (stage.shape) {
+                    case Shape::FILL_BOX: return stage.type;
+                    case Shape::FILL_SPHERE: return glm::length(blockCenter - center) <= radius ? stage.type : current;
+                    case Shape::REPLACE: return current == stone ? stage.type : current;
+                }
+                return current;
+            };
+
+            // One setBlockAtWorldPos per changed block, then the re-mesh
+            size_t referenceChanged = 0;
+            auto start = std::chrono::steady_clock::now();
+            size_t i = 0;
+            for (int x = 0; x < region.size.x; ++x) {
+                for (int y = 0; y < region.size.y; ++y) {
+                    for (int z = 0; z < region.size.z; ++z, ++i) {
+                        const glm::vec3 blockCenter = region.worldOrigin + glm::vec3(x, y, z) + glm::vec3(0.5f);
+                        const uint16_t type = newType(blockCenter, original[i]);
+                        if (type != original[i] && world.setBlockAtWorldPos(blockCenter, type)) {
+                            ++referenceChanged;
+                        }
+                    }
+                }
+            }
+            const double referenceWriteSeconds = secondsSince(start);
+            start = std::chrono::steady_clock::now();
+            world.rebuildEditedChunks();
+            const double referenceMeshSeconds = secondsSince(start);
+            world.queryBlocks(boxMin, boxMax, expected, region);
+            restore(region, original);
+
+            start = std::chrono::steady_clock::now();
+            size_t changed = 0;
+            switch (stage.shape) {
+                case Shape::FILL_BOX: changed = world.fillBox(boxMin, boxMax, stage.type); break;
+                case Shape::FILL_SPHERE: changed = world.fillSphere(center, radius, stage.type); break;
+                case Shape::REPLACE: changed = world.replaceBlocks(boxMin, boxMax, stone, stage.type); break;
+            }
+            const double writeSeconds = secondsSince(start);
+            start = std::chrono::steady_clock::now();
+            world.rebuildEditedChunks();
+            const double meshSeconds = secondsSince(start);
+            world.queryBlocks(boxMin, boxMax, result, region);
+            // The bulk path leaves Block objects to be rebuilt from the voxels when asked for
+            size_t staleBlocks = 0;
+            i = 0;
+            for (int x = 0; x < region.size.x; ++x) {
+                for (int y = 0; y < region.size.y; ++y) {
+                    for (int z = 0; z < region.size.z; ++z, ++i) {
+                        const std::shared_ptr<Block> block = world.getBlockAtWorldPos(region.worldOrigin + glm::vec3(x, y, z) + glm::vec3(0.5f));
+                        staleBlocks += (block ? block->getBlockType() : 0) != result[i] ? 1 : 0;
+                    }
+                }
+            }
+            restore(region, original);
+
+            std::cout << "bulkedit " << stage.name << ": " << changed << " blocks, " << writeSeconds * 1e3 << " ms write + "
+                      << meshSeconds * 1e3 << " ms re-mesh (setBlockAtWorldPos: " << referenceWriteSeconds * 1e3 << " ms + "
+                      << referenceMeshSeconds * 1e3 << " ms), " << changed / (writeSeconds + meshSeconds) / 1e6 << " M blocks/s" << std::endl;
+            if (result != expected || changed != referenceChanged) {
+                std::cerr << "bulkedit " << stage.name << ": bulk edit differs from per-block edits" << std::endl;
+                ok = false;
+            }
+            if (staleBlocks > 0) {
+                std::cerr << "bulkedit " << stage.name << ": " << staleBlocks << " Block objects differ from their voxels" << std::endl;
+                ok = false;
+            }
+        }
+
+        // Explosion at the surface: no block the blast should break may be left standing
+        const float blastRadius = 12.0f;
+        const float power = 100.0f;
+        auto start = std::chrono::steady_clock::now();
+        const size_t destroyed = world.explode(center, blastRadius, power);
+        const double writeSeconds = secondsSince(start);
+        start = std::chrono::steady_clock::now();
+        world.rebuildEditedChunks();
+        const double meshSeconds = secondsSince(start);
+        world.queryBlocksInSphere(center, blastRadius, result, region);
+        size_t survivors = 0;
+        size_t i = 0;
+        for (int x = 0; x < region.size.x; ++x) {
+            for (int y = 0; y < region.size.y; ++y) {
+                for (int z = 0; z < region.size.z; ++z, ++i) {
+                    const BlockDefinition* definition = registry.getBlockDefinition(result[i]);
+                    if (result[i] == 0 || !definition || definition->hardness < 0.0f) {
+                        continue;
+                    }
+                    const float distance = glm::length(region.worldOrigin + glm::vec3(x, y, z) + glm::vec3(0.5f) - center);
+                    survivors += definition->blast_resistance < power * (1.0f - distance / blastRadius) ? 1 : 0;
+                }
+            }
+        }
+        std::cout << "bulkedit explode " << blastRadius << ": " << destroyed << " blocks, " << writeSeconds * 1e3 << " ms write + "
+                  << meshSeconds * 1e3 << " ms re-mesh" << std::endl;
+        if (destroyed == 0 || survivors > 0) {
+            std::cerr << "bulkedit explode: " << destroyed << " blocks broken, " << survivors << " breakable blocks left" << std::endl;
+            ok = false;
+        }
+        return ok;
+    });
+}
+
+// Headless fixed-timestep replay of a recorded camera path through the same planets as the game
+bool runReplayWorkload(const BenchOptions& options) {
+    CameraPath path;
+    if (options.pathFile.empty() || !path.loadFromFile(options.pathFile) || path.empty()) {
+        std::cerr << "replay workload needs a camera path: --path <file>" << std::endl;
+        return false;
+    }
+
+    const double timestep = 1.0 / 60.0;
+    const std::string worldName = "azurevoxel_bench_replay";
+    const std::filesystem::path dataPath = std::filesystem::path("chunk_data") / worldName;
+    std::filesystem::remove_all(dataPath); // Always stream from a cold start
+
+    ReplayReport report;
+    std::ostringstream budgetStatus;
+    {
+        World world(worldName);
+        // Same planets as main.cpp
+        world.addPlanet(glm::vec3(0.0f, 0.0f, 0.0f), 150.0f, 123, "Terra");
+        world.addPlanet(glm::vec3(150.0f, 0.0f, 0.0f), 25.0f, 456, "Luna");
+        if (options.prefetchLookahead >= 0.0f) {
+            world.getPrefetchSettings().lookaheadSeconds = options.prefetchLookahead;
+            world.getPrefetchSettings().enabled = options.prefetchLookahead > 0.0f;
+        }
+        if (options.frameBudgetMs >= 0.0) {
+            StreamingBudgetSettings budget = world.getStreamingBudget().getSettings();
+            budget.enabled = options.frameBudgetMs > 0.0;
+            if (options.frameBudgetMs > 0.0) {
+            budget.targetFrameMs = options.frameBudgetMs;
+        }
+            world.getStreamingBudget().setSettings(budget);
+        }
+
+        Camera camera;
+        auto replayStart = std::chrono::steady_clock::now();
+        for (long long frameIndex = 0;; ++frameIndex) {
+            double simTime = static_cast<double>(frameIndex) * timestep;
+            auto frameStart = std::chrono::steady_clock::now();
+
+            path.applyTo(camera, simTime);
+            world.update(camera, static_cast<float>(timestep));
+            world.processMainThreadTasks();
+
+            ReplayReport::Frame frame;
+            frame.simTime = simTime;
+            frame.frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            world.recordFrameTime(frame.frameMs);
+            frame.chunksStreamed = world.getPipelineMetrics().completedChunks();
+            frame.backlog = world.getPipelineBacklog();
+            report.recordFrame(frame);
+
+            if (simTime >= path.duration()) {
+                break;
+            }
+            if (options.paced) {
+                std::this_thread::sleep_until(replayStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                                std::chrono::duration<double>(simTime + timestep)));
+            }
+        }
+        world.getStreamingBudget().printStatus(budgetStatus);
+    }
+    std::filesystem::remove_all(dataPath);
+
+    report.printReport(std::cout);
+    std::cout << "Streaming budget at end: " << budgetStatus.str() << std::endl;
+    report.writeJSONFile(options.reportFile);
+    return true;
+}
+
+// Uncompressed 32-bit TGA (stb_image reads it; no encoder needed): a solid tile with a darker border
+void writeTestTile(const std::filesystem::path& path, int size, uint8_t r, uint8_t g, uint8_t b) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const uint8_t header[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                static_cast<uint8_t>(size & 0xFF), static_cast<uint8_t>(size >> 8),
+                                static_cast<uint8_t>(size & 0xFF), static_cast<uint8_t>(size >> 8), 32, 0x28};
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            const uint8_t pixel[4] = {static_cast<uint8_t>(border ? b / 2 : b), static_cast<uint8_t>(border ? g / 2 : g),
+                                      static_cast<uint8_t>(border ? r / 2 : r), 255};
+            out.write(reinterpret_cast<const char*>(pixel), sizeof(pixel));
+        }
+    }
+}
+
+// Texture atlas builder on one tile per registered texture name (one left out to exercise the
+// missing tile): cold build, cached rebuild that must decode nothing, and a rebuild after one
+// tile changes. Checks the cached atlas is identical and the registry's face UVs point into it.
+bool runAtlasWorkload() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "azurevoxel_bench_atlas";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    BlockRegistry& registry = BlockRegistry::getInstance();
+    std::vector<std::string> names = registry.getTextureNames();
+    const std::string leftOut = names.back();
+    for (size_t i = 0; i + 1 < names.size(); ++i) {
+        writeTestTile(directory / (names[i] + ".tga"), 80, static_cast<uint8_t>(40 + i * 9), static_cast<uint8_t>(200 - i * 7), 120);
+    }
+
+    TextureAtlasSettings settings;
+    settings.sourceDirectory = directory.string();
+    settings.cachePath = (directory / "atlas.cache").string();
+    auto timedBuild = [&](TextureAtlas& atlas, TextureAtlasBuilder& builder) {
+        auto start = std::chrono::steady_clock::now();
+        bool built = builder.build(names, atlas);
+        return built ? std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() : -1.0;
+    };
+
+    TextureAtlas cold, warm, touched;
+    TextureAtlasBuilder coldBuilder(settings), warmBuilder(settings), touchedBuilder(settings);
+    double coldMs = timedBuild(cold, coldBuilder);
+    double warmMs = timedBuild(warm, warmBuilder);
+    writeTestTile(directory / (names.front() + ".tga"), 80, 255, 255, 255);
+    double touchedMs = timedBuild(touched, touchedBuilder);
+
+    bool ok = coldMs >= 0.0 && warmMs >= 0.0 && touchedMs >= 0.0;
+    ok = ok && !coldBuilder.loadedFromCache() && coldBuilder.decodedImages() == names.size() - 1;
+    ok = ok && warmBuilder.loadedFromCache() && warmBuilder.decodedImages() == 0;
+    ok = ok && warm.width == cold.width && warm.height == cold.height && warm.pixels == cold.pixels &&
+         warm.rects.size() == cold.rects.size() && cold.rects.count(leftOut) == 0;
+    ok = ok && !touchedBuilder.loadedFromCache() && touched.pixels != cold.pixels;
+
+    // The registry must hand the mesher rectangles from this atlas, and the missing tile for the left-out name
+    registry.applyTextureAtlas(cold);
+    for (uint16_t id = 1; ok && id < BlockRegistry::MAX_BLOCK_TYPES; ++id) {
+        const BlockDefinition* definition = registry.getBlockDefinition(id);
+        if (!definition || definition->id.empty()) {
+            continue;
+        }
+        auto it = cold.rects.find(definition->default_texture);
+        const BlockFaceUV& expected = it != cold.rects.end() ? it->second : cold.missing;
+        const BlockFaceUV& actual = registry.getFaceUV(id, 0);
+        ok = actual.u0 == expected.u0 && actual.v0 == expected.v0 && actual.u1 == expected.u1 && actual.v1 == expected.v1;
+    }
+    registry.bakeFaceUVs(0, 0); // Back to plain UVs for the other workloads
+    std::filesystem::remove_all(directory);
+
+    if (!ok) {
+        std::cerr << "atlas: cache reuse, invalidation or registry UVs did not behave as expected" << std::endl;
+        return false;
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "atlas: " << cold.rects.size() << " textures, " << cold.width << "x" << cold.height << ", mip levels 0-"
+              << cold.maxMipLevel << "; cold build " << coldMs << " ms, cached " << warmMs << " ms (0 images decoded), after one change "
+              << touchedMs << " ms" << std::endl;
+    return true;
+}
+
+// selectBlock throughput: the numeric overload over random (block, biome, planet) triples, and the
+// name overload the terrain generator calls per surface voxel. Also checks the known variant and
+// that contexts no longer alias (biome*16 + planet used to map (1, 16) onto (2, 0)), and compares
+// the per-property bitsets with the BlockRenderData lookups they replace on the hot paths.
+bool runRegistryWorkload() {
+    BlockRegistry& registry = BlockRegistry::getInstance();
+    const uint16_t grass = registry.getBlockId("azurevoxel:grass");
+    const uint16_t snow = registry.getBlockId("azurevoxel:snow");
+    if (registry.selectBlock(grass, 2, 0) != snow || registry.selectBlock(grass, 1, 16) != grass ||
+        registry.selectBlock(grass, 0, 0) != grass) {
+        std::cerr << "registry: selectBlock returned the wrong variant" << std::endl;
+        return false;
+    }
+
+    constexpr size_t LOOKUPS = 1 << 24;
+    std::mt19937 rng(7);
+    std::vector<uint32_t> queries(1 << 16);
+    for (uint32_t& query : queries) {
+        query = rng();
+    }
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < LOOKUPS; ++i) {
+        uint32_t query = queries[i & (queries.size() - 1)];
+        uint16_t block = static_cast<uint16_t>(query % 24);
+        checksum += registry.selectBlock(block, static_cast<uint8_t>(query >> 8 & 15), static_cast<uint8_t>(query >> 16 & 3));
+    }
+    double numericSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    constexpr size_t NAMED_LOOKUPS = 1 << 20;
+    const BiomeContext biomes[] = {BiomeContext("temperate", 0.2f, 0.5f), BiomeContext("cold", -0.7f, 0.3f),
+                                   BiomeContext("mountain", -0.3f, 0.2f), BiomeContext("desert", 0.9f, -0.8f)};
+    const PlanetContext planet("earth");
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NAMED_LOOKUPS; ++i) {
+        checksum += registry.selectBlock("azurevoxel:grass", biomes[queries[i & (queries.size() - 1)] & 3], planet);
+    }
+    double namedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Property queries: the bitsets must agree with the render data they are copied from, then the
+    // mesher's face test and the physics/lighting lookups are timed both ways
+    for (uint32_t id = 0; id <= BlockRegistry::MAX_BLOCK_TYPES; ++id) {
+        const uint16_t block = static_cast<uint16_t>(id);
+        const BlockRenderData& renderData = registry.getRenderData(block);
+        const bool registered = registry.getBlockDefinition(block) != nullptr;
+        if (registry.isBlockSolid(block) != renderData.isSolid() ||
+            registry.isBlockTransparent(block) != renderData.isTransparent() ||
+            registry.isBlockLightSource(block) != renderData.isLightSource() ||
+            registry.getBlockLightLevel(block) != renderData.light_level ||
+            registry.isBlockOpaque(block) != (registered && id != 0 && !renderData.isTransparent())) {
+            std::cerr << "registry: property bits of block " << id << " disagree with its render data" << std::endl;
+            return false;
+        }
+    }
+    constexpr size_t PROPERTY_QUERIES = 1 << 26;
+    std::vector<uint16_t> propertyIds(1 << 16);
+    for (uint16_t& id : propertyIds) {
+        id = static_cast<uint16_t>(rng() % 32); // Registered blocks and a few unused ids, like real terrain
+    }
+    auto timeProperties = [&](auto&& faceVisible, auto&& solidLight) {
+        auto propertyStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < PROPERTY_QUERIES; ++i) {
+            const uint16_t current = propertyIds[i & (propertyIds.size() - 1)];
+            const uint16_t neighbor = propertyIds[(i + 1) & (propertyIds.size() - 1)];
+            checksum += faceVisible(current, neighbor) + solidLight(neighbor);
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - propertyStart).count();
+    };
+    const double structSeconds = timeProperties(
+        [&](uint16_t current, uint16_t neighbor) {
+            if (current == 0 || current >= BlockRegistry::MAX_BLOCK_TYPES) return false;
+            if (neighbor == 0) return true;
+            return registry.getRenderData(neighbor).isTransparent() && registry.getRenderData(current).isSolid();
+        },
+        [&](uint16_t id) {
+            const BlockRenderData& renderData = registry.getRenderData(id);
+            return (renderData.isSolid() ? 16u : 0u) + renderData.light_level;
+        });
+    const double bitsetSeconds = timeProperties(
+        [&](uint16_t current, uint16_t neighbor) { return registry.shouldRenderFace(current, neighbor); },
+        [&](uint16_t id) { return (registry.isBlockSolid(id) ? 16u : 0u) + registry.getBlockLightLevel(id); });
+
+    // Startup: a full BlockRegistry::initialize parsing the JSON sources, then reusing the compiled snapshot
+    constexpr int STARTUPS = 200;
+    auto timeStartups = [&](bool cacheEnabled) {
+        registry.setDefinitionCacheEnabled(cacheEnabled);
+        double seconds = 0.0;
+        for (int i = 0; i < STARTUPS; ++i) {
+            registry.shutdown();
+            auto startupStart = std::chrono::steady_clock::now();
+            registry.initialize("res/blocks/");
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startupStart).count();
+        }
+        return seconds / STARTUPS * 1e6;
+    };
+    Logger::getInstance().setLevel(LogCategory::Registry, LogLevel::Off); // The sample definitions log ID conflicts on every load
+    double parseUs = timeStartups(false);
+    timeStartups(true); // Writes the snapshot
+    double cachedUs = timeStartups(true);
+    bool fromCache = registry.loadedDefinitionsFromCache();
+
+    // Variants from a definition file must reach selectBlock, parsed and from the snapshot alike
+    const std::filesystem::path variantsDir = std::filesystem::temp_directory_path() / "azurevoxel_bench_variants";
+    std::filesystem::remove_all(variantsDir);
+    std::filesystem::create_directories(variantsDir);
+    for (const auto& entry : std::filesystem::directory_iterator("res/blocks/")) {
+        if (entry.path().extension() == ".json") {
+            std::filesystem::copy_file(entry.path(), variantsDir / entry.path().filename());
+        }
+    }
+    std::ofstream(variantsDir / "variants.json")
+        << "{\"blocks\": [{\"id\": \"bench:frost\", \"numeric_id\": 301, \"display_name\": \"Frost\", \"variants\": {"
+        << "\"arctic\": {\"block\": \"azurevoxel:snow\"}, \"mars\": {\"block\": \"azurevoxel:gravel\"}, "
+        << "\"desert@mars\": {\"block\": \"azurevoxel:sand\"}}}]}\n";
+    bool variantsApplied = true;
+    bool variantsFromCache = false;
+    for (bool cacheEnabled : {false, true, true}) { // Parse, parse and write the snapshot, read it
+        registry.setDefinitionCacheEnabled(cacheEnabled);
+        registry.shutdown();
+        registry.initialize(variantsDir.string());
+        const uint16_t frost = registry.getBlockId("bench:frost");
+        variantsApplied = variantsApplied && frost != BlockRegistry::INVALID_BLOCK_ID &&
+                          registry.selectBlock("bench:frost", BiomeContext("arctic", -0.9f, 0.1f)) == snow &&
+                          registry.selectBlock("bench:frost", BiomeContext{}, PlanetContext("mars")) == registry.getBlockId("azurevoxel:gravel") &&
+                          registry.selectBlock("bench:frost", BiomeContext("desert", 0.9f, -0.8f), PlanetContext("mars")) == registry.getBlockId("azurevoxel:sand") &&
+                          registry.selectBlock("bench:frost", BiomeContext("temperate", 0.2f, 0.5f), PlanetContext("earth")) == frost;
+        variantsFromCache = registry.loadedDefinitionsFromCache();
+    }
+    registry.shutdown();
+    registry.initialize("res/blocks/");
+    std::filesystem::remove_all(variantsDir);
+    Logger::getInstance().setLevel(LogCategory::Registry, LogLevel::Warn);
+    if (!fromCache || !variantsFromCache) {
+        std::cerr << "registry: the definition snapshot was not reused" << std::endl;
+        return false;
+    }
+    if (!variantsApplied) {
+        std::cerr << "registry: variants from the definition file did not reach selectBlock" << std::endl;
+        return false;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "registry: initialize " << parseUs << " us parsing JSON, " << cachedUs << " us from the snapshot\n"
+              << "registry: selectBlock(id) " << LOOKUPS / numericSeconds / 1e6 << " M lookups/s, selectBlock(name) "
+              << NAMED_LOOKUPS / namedSeconds / 1e6 << " M lookups/s\n"
+              << "registry: face + solid/light queries " << PROPERTY_QUERIES / bitsetSeconds / 1e6 << " M/s from bitsets, "
+              << PROPERTY_QUERIES / structSeconds / 1e6 << " M/s from render data (checksum " << checksum << ")" << std::endl;
+    return true;
+}
+
+// Block definition for the reload workload's marker block, placed into a few chunks by hand
+void writeMarkerDefinition(const std::filesystem::path& path, const std::string& texture, bool transparent, int lightEmission = 0) {
+    std::ofstream out(path, std::ios::trunc);
+    out << "{\n  \"blocks\": [\n    {\n"
+        << "      \"id\": \"bench:marker\",\n      \"numeric_id\": 300,\n      \"display_name\": \"Marker\",\n"
+        << "      \"texture\": \"" << texture << "\",\n      \"solid\": true,\n"
+        << "      \"transparent\": " << (transparent ? "true" : "false") << ",\n"
+        << "      \"light_emission\": " << lightEmission << "\n    }\n  ]\n}\n";
+}
+
+// Hot reload of block definitions on a streamed planet: a marker block is placed into a few
+// chunks, then its definition file is edited (texture, transparency, then light emission) and
+// picked up by the watcher. Checks that only the chunks using the marker (plus, for the
+// transparency change, the neighbouring chunks whose border faces cull against it) are
+// re-meshed or relit.
+bool runReloadWorkload(const BenchOptions& options) {
+    const std::filesystem::path blocksDir = std::filesystem::temp_directory_path() / "azurevoxel_bench_blocks";
+    std::filesystem::remove_all(blocksDir);
+    std::filesystem::create_directories(blocksDir);
+    for (const auto& entry : std::filesystem::directory_iterator("res/blocks/")) {
+        if (entry.path().extension() == ".json") {
+            std::filesystem::copy_file(entry.path(), blocksDir / entry.path().filename());
+        }
+    }
+    const std::filesystem::path markerPath = blocksDir / "marker.json";
+    writeMarkerDefinition(markerPath, "stone", false);
+
+    BlockRegistry& registry = BlockRegistry::getInstance();
+    Logger::getInstance().setLevel(LogCategory::Registry, LogLevel::Off); // The sample definitions log ID conflicts on every load
+    registry.reloadDefinitions(blocksDir.string());
+    registry.bakeFaceUVs(800, 800); // Spritesheet layout, so a texture change moves the face UVs
+    const uint16_t marker = registry.getBlockId("bench:marker");
+
+    const float planetRadius = 150.0f;
+    bool ok = marker != BlockRegistry::INVALID_BLOCK_ID;
+    size_t markerChunks = 0, textureRemeshed = 0, cullingRemeshed = 0, lightRelit = 0, unchangedRemeshed = 0;
+    uint64_t residentChunks = 0;
+    double textureMs = 0.0, cullingMs = 0.0, lightMs = 0.0;
+    if (ok) {
+        ok = runOnStreamedPlanet(options, "reload", planetRadius, 3, [&](World& world, float) {
+            bool allReported = true;
+            Camera camera; // Where streamPlanetSurface left it, for the frames of the light batch
+            camera.setPosition(glm::vec3(0.0f, planetRadius + 4.0f, 0.0f));
+            residentChunks = world.getPipelineMetrics().completedChunks();
+
+            // One marker on the surface of a few columns, each in a different chunk
+            std::unordered_set<glm::ivec3, IVec3Hash> markedKeys;
+            for (float x : {-20.5f, 4.5f, 25.5f}) {
+                float y = planetRadius + 24.0f;
+                while (y > planetRadius - 24.0f && !world.getBlockAtWorldPos(glm::vec3(x, y, 4.5f))) {
+                    y -= 1.0f;
+                }
+                glm::vec3 pos(x, y, 4.5f);
+                if (world.setBlockAtWorldPos(pos, marker)) {
+                    markedKeys.insert(glm::ivec3(glm::floor(pos / static_cast<float>(CHUNK_SIZE_X))));
+                }
+            }
+            world.rebuildEditedChunks();
+            markerChunks = markedKeys.size();
+
+            BlockDefinitionWatcher watcher(blocksDir.string(), std::chrono::milliseconds(0));
+            auto reloadAfterEdit = [&](const std::string& texture, bool transparent, int lightEmission, double& ms) {
+                writeMarkerDefinition(markerPath, texture, transparent, lightEmission);
+                // The first poll sees the change, the next one (files unchanged) reports it
+                bool reported = !watcher.poll() && watcher.poll();
+                auto start = std::chrono::steady_clock::now();
+                size_t remeshed = reported ? world.reloadBlockDefinitions(watcher.getDirectory()) : 0;
+                ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                allReported = allReported && reported;
+                return remeshed;
+            };
+            textureRemeshed = reloadAfterEdit("dirt", false, 0, textureMs);
+            cullingRemeshed = reloadAfterEdit("dirt", true, 0, cullingMs);
+            lightRelit = reloadAfterEdit("dirt", true, 12, lightMs);
+            for (int frame = 0; frame < 20; ++frame) { // Let the light batch run
+                world.update(camera, 1.0f / 60.0f);
+                world.processMainThreadTasks();
+            }
+            unchangedRemeshed = world.reloadBlockDefinitions(blocksDir.string());
+            return allReported;
+        });
+    }
+    std::filesystem::remove_all(blocksDir);
+    registry.reloadDefinitions("res/blocks/");
+    registry.bakeFaceUVs(0, 0); // Back to plain UVs for the other workloads
+    Logger::getInstance().setLevel(LogCategory::Registry, LogLevel::Warn);
+
+    if (!ok || markerChunks == 0 || textureRemeshed != markerChunks || cullingRemeshed <= markerChunks ||
+        lightRelit != markerChunks || unchangedRemeshed != 0) {
+        std::cerr << "reload: expected " << markerChunks << " chunks re-meshed for a texture change (got " << textureRemeshed
+                  << "), more for a transparency change (got " << cullingRemeshed << "), " << markerChunks
+                  << " relit for a light change (got " << lightRelit << ") and none without a change (got "
+                  << unchangedRemeshed << ")" << std::endl;
+        return false;
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "reload: " << residentChunks << " chunks resident, marker in " << markerChunks << "; texture change re-meshed "
+              << textureRemeshed << " chunks in " << textureMs << " ms, transparency change " << cullingRemeshed
+              << " chunks in " << cullingMs << " ms, light change relit " << lightRelit << " chunks in " << lightMs << " ms" << std::endl;
+    return true;
+}
+
+void printResults(const std::vector<StageResult>& results) {
+    std::cout << std::left << std::setw(15) << "workload" << std::setw(15) << "stage"
+              << std::right << std::setw(10) << "chunks" << std::setw(12) << "seconds"
+              << std::setw(14) << "chunks/s" << std::setw(12) << "MB/s" << "\n";
+    std::cout << std::fixed;
+    for (const StageResult& r : results) {
+        double perSecond = r.seconds > 0.0 ? static_cast<double>(r.chunks) / r.seconds : 0.0;
+        double mbPerSecond = r.seconds > 0.0 ? static_cast<double>(r.bytes) / (1024.0 * 1024.0) / r.seconds : 0.0;
+        std::cout << std::left << std::setw(15) << r.workload << std::setw(15) << r.stage
+                  << std::right << std::setw(10) << r.chunks
+                  << std::setw(12) << std::setprecision(3) << r.seconds
+                  << std::setw(14) << std::setprecision(1) << perSecond
+                  << std::setw(12) << std::setprecision(1) << mbPerSecond << "\n";
+    }
+    std::cout << "mesh scratch: ";
+    MeshScratch::getStats().printStatus(std::cout);
+    std::cout << "\npeak RSS: " << std::setprecision(1) << peakRssMiB() << " MiB" << std::endl;
+}
+
+bool parseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* value = nullptr;
+        if (arg == "--workload" && (value = next())) {
+            options.workload = value;
+        } else if (arg == "--radius" && (value = next())) {
+            options.radius = std::max(1, std::atoi(value));
+        } else if (arg == "--threads" && (value = next())) {
+            options.threads = static_cast<size_t>(std::max(1, std::atoi(value)));
+        } else if (arg == "--seed" && (value = next())) {
+            options.seed = std::atoi(value);
+        } else if (arg == "--path" && (value = next())) {
+            options.pathFile = value;
+        } else if (arg == "--report" && (value = next())) {
+            options.reportFile = value;
+        } else if (arg == "--prefetch-lookahead" && (value = next())) {
+            options.prefetchLookahead = static_cast<float>(std::atof(value));
+        } else if (arg == "--frame-budget" && (value = next())) {
+            options.frameBudgetMs = std::atof(value);
+        } else if (arg == "--edits" && (value = next())) {
+            options.edits = std::max(1, std::atoi(value));
+        } else if (arg == "--bodies" && (value = next())) {
+            options.bodies = std::max(1, std::atoi(value));
+        } else if (arg == "--unpaced") {
+            options.paced = false;
+        } else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--workload flat|planet150|planet1000|load|mesher|edit|light|raycast|query|physics|bulkedit|atlas|registry|reload|replay|all] [--radius N] [--threads N] [--seed N]"
+                      << " [--edits N] [--bodies N]"
+                      << " [--path camera_path.txt] [--report replay_report.json] [--unpaced]"
+                      << " [--prefetch-lookahead seconds] [--frame-budget ms]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        return 1;
+    }
+
+    // Keep the report readable unless the caller asked for logging explicitly
+    if (!std::getenv("AZUREVOXEL_LOG")) {
+        Logger::getInstance().setLevel(LogLevel::Warn);
+    }
+
+    if (!BlockRegistry::getInstance().initialize("res/blocks/")) {
+        AZV_LOG_WARN(General) << "Failed to initialize Block Registry. Continuing with defaults...";
+    }
+
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    ChunkThreadPool pool(options.threads, "BenchWorker");
+
+    std::cout << "azurevoxel_bench: workload=" << options.workload << " radius=" << options.radius
+              << " threads=" << options.threads << " seed=" << options.seed << std::endl;
+
+    const bool all = options.workload == "all";
+    bool ranAny = false;
+    std::vector<StageResult> results;
+    if (all || options.workload == "flat") {
+        runPipeline("flat", flatChunkSet(options.radius), nullptr, options.seed, pool, results);
+        ranAny = true;
+    }
+    if (all || options.workload == "planet150") {
+        runPipeline("planet150", planetChunkSet(150.0f, options.radius), nullptr, options.seed, pool, results);
+        ranAny = true;
+    }
+    if (all || options.workload == "planet1000") {
+        runPipeline("planet1000", planetChunkSet(1000.0f, options.radius), nullptr, options.seed, pool, results);
+        ranAny = true;
+    }
+    if (all || options.workload == "load") {
+        runLoadWorkload(options, pool, results);
+        ranAny = true;
+    }
+    if (all || options.workload == "mesher") {
+        if (!runMesherWorkload(options, pool, results)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+    pool.shutdown();
+
+    if (all || options.workload == "edit") {
+        if (!runEditWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "light") {
+        if (!runLightWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "raycast") {
+        if (!runRaycastWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "query") {
+        if (!runQueryWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "physics") {
+        if (!runPhysicsWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "bulkedit") {
+        if (!runBulkEditWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "atlas") {
+        if (!runAtlasWorkload()) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "registry") {
+        if (!runRegistryWorkload()) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (all || options.workload == "reload") {
+        if (!runReloadWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    // Not part of "all": it needs a recorded path and runs in (simulated) real time
+    if (options.workload == "replay") {
+        if (!runReplayWorkload(options)) {
+            return 1;
+        }
+        ranAny = true;
+    }
+
+    if (!ranAny) {
+        std::cerr << "Unknown workload: " << options.workload << std::endl;
+        return 1;
+    }
+
+    if (!results.empty()) {
+        printResults(results);
+    } else {
+        std::cout << std::fixed << "peak RSS: " << std::setprecision(1) << peakRssMiB() << " MiB" << std::endl;
+    }
+
+    BlockRegistry::getInstance().shutdown();
+    Logger::getInstance().shutdown();
+    return 0;
+}
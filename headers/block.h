@@ -1,21 +1,19 @@
 #pragma once
 
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include "texture.h"
 #include <memory>
 #include <string>
 
 // Forward declaration to avoid circular dependency
 class BlockRegistry;
+class Texture;
 
 class Block {
 private:
     // OpenGL objects for individual block rendering (less common with chunk meshing)
-    GLuint VAO = 0, VBO = 0, EBO = 0, texCoordVBO = 0;
+    unsigned int VAO = 0, VBO = 0, EBO = 0, texCoordVBO = 0;
     
     // Block properties
     glm::vec3 position;
@@ -24,21 +22,25 @@ private:
     uint16_t block_type_id = 0;  // New: block type ID for registry lookup
     
     // Texture (can be shared or represent a sub-texture from an atlas)
-    Texture texture; // For individual block texture or as a template
+    std::shared_ptr<Texture> texture; // For individual block texture or as a template
     bool hasTexture = false; 
     
     float speed = 0.05f; // Example property, adjust as needed
     
 public:
     // Public Static Members:
-    static GLuint shaderProgram;      // Shared shader program for all blocks
+    static unsigned int shaderProgram; // Shared shader program for all blocks
     static Texture spritesheetTexture; // Global spritesheet for atlas texturing
     static bool spritesheetLoaded;    // Flag to check if the global spritesheet is loaded
+    static int spritesheetWidth;      // Spritesheet size in pixels; the registry bakes face UVs from it
+    static int spritesheetHeight;
 
     // Static method to initialize the shared shader program
     static void InitBlockShader();
     // Static method to initialize the global spritesheet texture
     static void InitSpritesheet(const std::string& path);
+    // Rebuild the global spritesheet after a block definition reload (new texture names get tiles)
+    static void ReloadSpritesheet(const std::string& path);
     // Static method to clean up the shared shader program
     static void CleanupBlockShader();
     
@@ -80,9 +82,9 @@ public:
     glm::vec3 getColor() const;
     
     // Methods needed by Chunk for mesh rendering or general block info
-    GLuint getShaderProgram() const { return Block::shaderProgram; } 
+    unsigned int getShaderProgram() const { return Block::shaderProgram; } 
     bool   hasTextureState() const { return hasTexture; } 
-    GLuint getTextureID() const { return texture.getID(); }
+    unsigned int getTextureID() const;
     
     // Public helpers used internally and potentially by Chunk for individual block rendering
     void useBlockShader() const; 
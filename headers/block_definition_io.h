@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "block_registry.h"
+
+/**
+ * Read-only memory mapping of a whole file. Empty (and false) if the file could not be
+ * opened or mapped; a zero-length file maps as valid but empty.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    explicit operator bool() const { return valid_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool valid_ = false;
+};
+
+// One block definition source file and the hash of its contents
+struct BlockSourceHash {
+    std::string path;
+    uint64_t hash = 0;
+};
+
+// FNV-1a over the file contents; any edit to a source changes it
+uint64_t hashBlockSource(const char* data, size_t size);
+
+// Single-pass parse of a {"blocks": [ {...}, ... ]} document. Every block object is appended
+// to definitions as written (required fields are validated by the registry). Unknown keys are
+// skipped whatever their type. Per-face textures come from "texture_<face>" keys or a nested
+// "textures" object. On a syntax error, returns false with a message naming the byte offset;
+// the objects before the error have been appended.
+bool parseBlockDefinitionsJSON(const char* data, size_t size, std::vector<BlockDefinition>& definitions, std::string& error);
+
+// Compiled registry snapshot (<blocks_directory>/registry.cache) of the definitions parsed from
+// every source, valid only while the source list and every source hash match. The file is a
+// header, fixed-size records and a string pool, so it is read in place from the mapping: open
+// checks the header, the sources and every record's bounds once, and nothing is decoded into an
+// intermediate copy. It is a per-machine cache (host byte order), not an interchange format.
+class BlockRegistryCache {
+public:
+    // Map and validate the snapshot; false (and empty) if it is missing, malformed or stale
+    bool open(const std::string& path, const std::vector<BlockSourceHash>& sources);
+    size_t size() const { return blockCount_; }
+    // Definition i, built straight from its record and the pool (the registry owns its definitions)
+    BlockDefinition definition(size_t i) const;
+
+    static bool write(const std::string& path, const std::vector<BlockSourceHash>& sources,
+                      const std::vector<BlockDefinition>& definitions);
+
+    // On-disk records, defined with the reader
+    struct Header;
+    struct String;
+    struct Source;
+    struct BlockRecord;
+    struct FaceTexture;
+    struct VariantEntry;
+
+private:
+    std::unique_ptr<MappedFile> file_;
+    const BlockRecord* blocks_ = nullptr;
+    const FaceTexture* faceTextures_ = nullptr;
+    const VariantEntry* variants_ = nullptr;
+    const char* strings_ = nullptr;
+    size_t blockCount_ = 0;
+
+    std::string_view string(const String& s) const;
+};
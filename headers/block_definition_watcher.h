@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Watches the block definition directory for added, removed or edited definition files, so
+ * the game can hot-reload content (see World::reloadBlockDefinitions).
+ *
+ * Polls file sizes and modification times instead of using OS notifications: there are only
+ * a handful of files, and the same code works on every platform. A change is reported once the
+ * files have stayed the same for a whole interval, so an editor that saves in several writes
+ * triggers one reload of the finished file.
+ *
+ * Main thread only.
+ */
+class BlockDefinitionWatcher {
+public:
+    explicit BlockDefinitionWatcher(const std::string& directory,
+                                    std::chrono::milliseconds interval = std::chrono::milliseconds(500),
+                                    const std::string& extension = ".json");
+
+    // Cheap to call every frame: the directory is scanned at most once per interval. Returns
+    // true once per settled change.
+    bool poll();
+
+    // Take the current files as the baseline without reporting them
+    void reset();
+
+    const std::string& getDirectory() const { return directory_; }
+
+private:
+    struct FileStamp {
+        std::string path;
+        uint64_t size = 0;
+        int64_t modified = 0;
+
+        bool operator==(const FileStamp& other) const {
+            return path == other.path && size == other.size && modified == other.modified;
+        }
+    };
+
+    std::string directory_;
+    std::string extension_;
+    std::chrono::milliseconds interval_;
+    std::chrono::steady_clock::time_point lastScan_;
+    std::vector<FileStamp> stamps_;
+    bool pending_ = false; // Files changed at the last scan; reported once they settle
+
+    std::vector<FileStamp> scan() const;
+};
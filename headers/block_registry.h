@@ -13,6 +13,7 @@
 // Forward declarations
 class World;
 class Planet;
+struct TextureAtlas;
 
 /**
  * Core block definition structure containing immutable block properties
@@ -34,7 +35,8 @@ struct BlockDefinition {
     std::string default_texture = "stone";
     std::unordered_map<std::string, std::string> per_face_textures; // Optional per-face textures
     
-    // Variant definitions for different contexts
+    // Context variants from "variants": context ("<biome>", "<planet>" or "<biome>@<planet>")
+    // -> {"block": "<block id>"}, registered by BlockRegistry::buildOptimizationTables
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> variants;
     
     BlockDefinition() = default;
@@ -92,6 +94,17 @@ struct BlockRenderData {
     }
 };
 
+/**
+ * Atlas rectangle for one block face, in normalized texture coordinates.
+ * (u0, v0) maps to the quad's first corner and (u1, v1) to the opposite one.
+ */
+struct BlockFaceUV {
+    float u0 = 0.0f;
+    float v0 = 0.0f;
+    float u1 = 1.0f;
+    float v1 = 1.0f;
+};
+
 /**
  * Biome context for environmental block selection
  */
@@ -136,6 +149,17 @@ struct ContextKey {
     bool operator==(const ContextKey& other) const {
         return biome_id == other.biome_id && planet_id == other.planet_id;
     }
+    
+    // All 16 bits, so every (biome, planet) pair is distinct
+    uint16_t packed() const { return static_cast<uint16_t>(biome_id << 8 | planet_id); }
+};
+
+/**
+ * One entry of the context variant index: the block used for a base block in one context
+ */
+struct ContextVariant {
+    uint16_t context;   // ContextKey::packed()
+    uint16_t block_id;
 };
 
 // Hash function for ContextKey
@@ -157,6 +181,12 @@ public:
     static constexpr uint16_t MAX_CONTEXTS = 256;
     static constexpr uint16_t INVALID_BLOCK_ID = 0xFFFF;
     
+    // Block faces, in the mesher's order: -Z, +Z, -X, +X, -Y, +Y
+    static constexpr int FACE_COUNT = 6;
+    // Hand-authored spritesheet layout: square tiles of ATLAS_TILE_SIZE pixels, ATLAS_TILES_PER_ROW to a row
+    static constexpr int ATLAS_TILES_PER_ROW = 10;
+    static constexpr float ATLAS_TILE_SIZE = 80.0f;
+    
     // Singleton access
     static BlockRegistry& getInstance() {
         static BlockRegistry instance;
@@ -175,11 +205,18 @@ public:
     uint8_t registerBiome(const BiomeContext& biome);
     uint8_t registerPlanet(const PlanetContext& planet);
     
-    // Hot-path block lookups (O(1) performance)
+    // Hot-path block lookups (O(1) performance). The property queries read one bit of a dense
+    // per-property bitset (4096 blocks = 512 bytes each), so the mesher, lighting, physics and
+    // raycasts keep every table they touch in L1. Out-of-range ids report false / 0.
     const BlockRenderData& getRenderData(uint16_t block_id) const;
-    bool isBlockSolid(uint16_t block_id) const;
-    bool isBlockTransparent(uint16_t block_id) const;
-    uint8_t getBlockLightLevel(uint16_t block_id) const;
+    inline bool isBlockSolid(uint16_t block_id) const { return testBit(solid_bits_, block_id); }
+    inline bool isBlockTransparent(uint16_t block_id) const { return testBit(transparent_bits_, block_id); }
+    inline bool isBlockLightSource(uint16_t block_id) const { return testBit(light_source_bits_, block_id); }
+    // Registered, non-air and not transparent: hides every face behind it
+    inline bool isBlockOpaque(uint16_t block_id) const { return testBit(opaque_bits_, block_id); }
+    inline uint8_t getBlockLightLevel(uint16_t block_id) const {
+        return block_id < MAX_BLOCK_TYPES ? light_levels_[block_id] : 0;
+    }
     
     // Context-aware block selection
     uint16_t selectBlock(const std::string& base_block_name, 
@@ -200,6 +237,23 @@ public:
     uint16_t getTextureIndex(const std::string& texture_name) const;
     bool loadTextureAtlas(const std::string& atlas_path);
     
+    // Re-bakes every block's face UVs for a spritesheet of the given size in pixels. Call from the
+    // main thread once the atlas is loaded, before meshing starts; a size of 0 means no atlas
+    // (faces then span the whole texture).
+    void bakeFaceUVs(int atlas_width, int atlas_height);
+    
+    // Switches face UVs to a runtime-built atlas: names resolve through its rectangles, and
+    // names it has no image for get its "missing" tile
+    void applyTextureAtlas(const TextureAtlas& atlas);
+    
+    // Every texture name the registered blocks use (default and per-face), for the atlas builder
+    std::vector<std::string> getTextureNames() const;
+    
+    // Baked atlas rectangle for one face of a block; the only texture lookup the mesher does
+    inline const BlockFaceUV& getFaceUV(uint16_t block_id, int face) const {
+        return face_uvs_[block_id < MAX_BLOCK_TYPES ? block_id : 0][face];
+    }
+    
     // Optimized face culling - render face only if neighbor is air or transparent
     inline bool shouldRenderFace(uint16_t block_id, uint16_t neighbor_id) const {
         // Always render if current block is invalid
@@ -215,11 +269,17 @@ public:
         if (neighbor_id >= MAX_BLOCK_TYPES) return false;
         
         // Render if neighbor is transparent and current is solid
-        return render_data_[neighbor_id].isTransparent() && render_data_[block_id].isSolid();
+        return isBlockTransparent(neighbor_id) && isBlockSolid(block_id);
     }
     
+    // Compiled definition snapshot (<blocks_directory>/registry.cache), reused while every
+    // source file's hash matches. Enabled by default; takes effect on the next initialize.
+    void setDefinitionCacheEnabled(bool enabled) { definition_cache_enabled_ = enabled; }
+    bool loadedDefinitionsFromCache() const { return loaded_definitions_from_cache_; }
+    
     // Debug and development tools
     void printRegistryStats() const;
+    // Hot reload: re-reads every definition in place. Main thread, with no worker using the registry.
     bool reloadDefinitions(const std::string& blocks_directory);
     
 private:
@@ -241,19 +301,50 @@ private:
     
     // Hot-path optimization arrays
     BlockRenderData render_data_[MAX_BLOCK_TYPES];
-    uint16_t context_map_[MAX_BLOCK_TYPES][MAX_CONTEXTS];  // Pre-computed context lookups
+    int render_data_extent_ = 0;  // One past the highest ID registerBlock has written (render_data_, face_uvs_, light_levels_)
+    
+    // Structure-of-arrays copies of the render_data_ flags for the hot queries: bit (id % 64) of
+    // word (id / 64), plus one light level byte per block
+    static constexpr int PROPERTY_WORDS = MAX_BLOCK_TYPES / 64;
+    uint64_t solid_bits_[PROPERTY_WORDS] = {};
+    uint64_t transparent_bits_[PROPERTY_WORDS] = {};
+    uint64_t light_source_bits_[PROPERTY_WORDS] = {};
+    uint64_t opaque_bits_[PROPERTY_WORDS] = {};
+    uint8_t light_levels_[MAX_BLOCK_TYPES] = {};
+    
+    static inline bool testBit(const uint64_t* bits, uint16_t block_id) {
+        return block_id < MAX_BLOCK_TYPES && (bits[block_id >> 6] >> (block_id & 63) & 1u);
+    }
+    static inline void assignBit(uint64_t* bits, uint16_t block_id, bool value) {
+        const uint64_t mask = uint64_t(1) << (block_id & 63);
+        bits[block_id >> 6] = value ? (bits[block_id >> 6] | mask) : (bits[block_id >> 6] & ~mask);
+    }
+    
+    // Context variants in compressed-row form: the variants of base block b are
+    // context_variants_[variant_offsets_[b] .. variant_offsets_[b + 1]), sorted by context.
+    // Most blocks have none, so a lookup is usually two loads from the offset array.
+    uint16_t variant_offsets_[MAX_BLOCK_TYPES + 1] = {};
+    std::vector<ContextVariant> context_variants_;
+    std::vector<std::pair<uint16_t, ContextVariant>> pending_variants_;  // (base block, variant) before rebuildContextMap
     
     // Texture management
     std::unordered_map<std::string, uint16_t> texture_name_to_index_;
+    BlockFaceUV face_uvs_[MAX_BLOCK_TYPES][FACE_COUNT];  // [block][face] atlas rectangles
+    int atlas_width_ = 0;
+    int atlas_height_ = 0;
+    std::unordered_map<std::string, BlockFaceUV> atlas_rects_;  // Built atlas; empty for the spritesheet layout
+    BlockFaceUV atlas_missing_rect_;
     
     // Private helpers
-    bool loadBlockDefinitionFile(const std::string& file_path);
-    bool loadBlockDefinitionFromJSON(std::ifstream& file);
-    bool loadBlockDefinitionFromText(std::ifstream& file);
-    std::string parseJSONString(const std::string& json, const std::string& key, const std::string& default_value = "");
-    double parseJSONNumber(const std::string& json, const std::string& key, double default_value = 0.0);
-    bool parseJSONBool(const std::string& json, const std::string& key, bool default_value = false);
+    bool loadBlockDefinitionDirectory(const std::string& blocks_directory);
+    bool loadBlockDefinitionFile(const std::string& file_path, std::vector<BlockDefinition>& parsed);
+    bool loadBlockDefinitionFromText(std::ifstream& file, std::vector<BlockDefinition>& parsed);
+    void registerParsedDefinition(const BlockDefinition& definition);
     void buildOptimizationTables();
+    void bakeBlockFaceUVs(uint16_t block_id);
+    void updateBlockProperties(uint16_t block_id);
+    void addContextVariant(uint16_t base_block_id, uint8_t biome_id, uint8_t planet_id, uint16_t variant_id);
+    void addDefinitionVariants(const BlockDefinition& definition);
     void rebuildContextMap();
     uint16_t findOrCreateVariant(uint16_t base_block_id, uint8_t biome_id, uint8_t planet_id);
     
@@ -261,6 +352,8 @@ private:
     void createDefaultBlocks();
     
     bool initialized_ = false;
+    bool definition_cache_enabled_ = true;
+    bool loaded_definitions_from_cache_ = false;
     uint16_t next_block_id_ = 1;  // 0 reserved for air
     uint8_t next_biome_id_ = 1;   // 0 reserved for default
     uint8_t next_planet_id_ = 1;  // 0 reserved for default
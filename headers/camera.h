@@ -1,10 +1,10 @@
 #pragma once
 
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+struct GLFWwindow;
+
 class Camera {
 private:
     // Camera vectors
@@ -47,10 +47,14 @@ public:
     glm::vec3 getPosition() const;
     glm::vec3 getFront() const;
     float getFov() const;
+    float getYaw() const { return yaw; }
+    float getPitch() const { return pitch; }
     
     // Setters
     void setPosition(const glm::vec3& newPosition);
     void setMovementSpeed(float speed);
     void setMouseSensitivity(float sensitivity);
     void setFov(float newFov);
+    // Set yaw/pitch directly (e.g. camera path replay) and recompute the camera vectors
+    void setOrientation(float newYaw, float newPitch);
 }; 
\ No newline at end of file
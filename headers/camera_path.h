@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Camera;
+
+// Camera pose at a point in time, relative to the start of the recording
+struct CameraPathSample {
+    double time = 0.0; // Seconds
+    glm::vec3 position{0.0f};
+    float yaw = -90.0f;
+    float pitch = 0.0f;
+};
+
+/**
+ * Recorded camera flythrough. Samples are kept in time order; playback interpolates
+ * linearly between them, so a path replayed with a fixed timestep always produces the
+ * same camera poses regardless of the frame rate it was recorded at.
+ *
+ * File format is plain text, one sample per line: "time x y z yaw pitch". Lines starting
+ * with '#' are comments.
+ */
+class CameraPath {
+public:
+    void clear() { samples_.clear(); }
+    // Samples older than the last one are ignored
+    void addSample(const CameraPathSample& sample);
+    // Append the camera's current pose at `time` seconds into the recording
+    void record(double time, const Camera& camera);
+
+    bool empty() const { return samples_.empty(); }
+    size_t size() const { return samples_.size(); }
+    double duration() const { return samples_.empty() ? 0.0 : samples_.back().time; }
+    const std::vector<CameraPathSample>& samples() const { return samples_; }
+
+    // Interpolated pose at `time`, clamped to the ends of the path
+    CameraPathSample sampleAt(double time) const;
+    void applyTo(Camera& camera, double time) const;
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+private:
+    std::vector<CameraPathSample> samples_;
+};
@@ -4,32 +4,53 @@
 #include <memory>
 #include <string>
 #include <glm/glm.hpp>
-#include <GL/glew.h>
 #include "block.h"
-#include "shader.h"
+#include "chunk_pipeline_metrics.h"
+#include "voxel_data.h" // Chunk dimensions, BlockInfo and copy-on-write voxel versions
+#include "light_engine.h" // Light versions and the seeds a mesh build leaves for its neighbours
 #include <optional> // For optional planet context
 #include <atomic>
+#include <functional>
 #include <mutex>
-
-// Constants for chunk dimensions
-constexpr int CHUNK_SIZE_X = 16;
-constexpr int CHUNK_SIZE_Y = 16;
-constexpr int CHUNK_SIZE_Z = 16;
+#include <array>
 
 // Forward declaration
 class World;
 
+// GPU handles of an uploaded chunk mesh, owned and interpreted by the RenderBackend
 struct ChunkMesh {
-    GLuint VAO = 0;
-    GLuint VBO = 0;
-    GLuint EBO = 0;
-    GLsizei indexCount = 0;
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    unsigned int EBO = 0;
+    int indexCount = 0;
+};
+
+// Voxel versions of the six face-adjacent chunks, in mesher face order (-Z, +Z, -X, +X, -Y, +Y).
+// The mesher culls border faces against them; a missing neighbour leaves its border faces visible.
+// Their light (null until a neighbour is lit) feeds the chunk's first lighting and the light
+// baked into border faces.
+struct ChunkNeighbors {
+    std::array<VoxelSnapshot, 6> faces;
+    std::array<LightSnapshot, 6> light;
 };
 
-// NEW: Simple struct to hold block type information during data-only phase
-struct BlockInfo {
-    int type = 0; // 0 for air, 1 for stone, 2 for grass, etc.
-    // Add other non-OpenGL properties if needed (e.g. light level from world gen)
+// Meshing sections: the chunk is split into 2x2x2 cubes of 8 blocks so an edit re-meshes only
+// the sections whose faces it can change
+constexpr int CHUNK_SECTION_SIZE = 8;
+constexpr int CHUNK_SECTIONS_PER_AXIS = CHUNK_SIZE_X / CHUNK_SECTION_SIZE;
+constexpr int CHUNK_SECTION_COUNT = CHUNK_SECTIONS_PER_AXIS * CHUNK_SECTIONS_PER_AXIS * CHUNK_SECTIONS_PER_AXIS;
+
+// One block changed by a bulk edit
+struct BlockChange {
+    uint16_t index = 0;    // VoxelData::index of the block
+    uint16_t oldType = 0;
+    uint16_t newType = 0;
+};
+
+// Face extraction used when building chunk meshes
+enum class ChunkMesher {
+    PER_VOXEL, // Reference: six neighbour lookups and a registry check per block
+    BITMASK    // Occupancy bitmask per row; whole rows are culled with shifts and masks (default)
 };
 
 // Chunk processing states for multi-threading
@@ -42,6 +63,8 @@ enum class ChunkState {
     OPENGL_INITIALIZING,// OpenGL objects being created (main thread)
     FULLY_INITIALIZED   // Ready for rendering
 };
+static_assert(ChunkStateTimeline::STATE_COUNT == static_cast<int>(ChunkState::FULLY_INITIALIZED) + 1,
+              "ChunkStateTimeline::STATE_COUNT must match the number of ChunkState values");
 
 class Chunk : public std::enable_shared_from_this<Chunk> {
 private:
@@ -50,34 +73,88 @@ private:
     
     // Thread-safe state management
     std::atomic<ChunkState> state_;
-    mutable std::mutex dataMutex_;  // Protects block data access
+    mutable std::mutex dataMutex_;  // Protects blocks_, compressedVoxels_, lightSpills_ and litVoxels_ (never held while meshing)
     mutable std::mutex meshMutex_;  // Protects mesh data access
+    std::mutex voxelWriteMutex_;    // Serializes voxel writers; readers never take it
+    
+    // Time each pipeline state was entered, for latency metrics. Each slot is written by the
+    // thread performing that transition, before the new state is published.
+    ChunkStateTimeline timeline_;
     
-    // Store BlockInfo during the data-only phase (populated by worker thread)
-    std::vector<std::vector<std::vector<BlockInfo>>> blockDataForInitialization_;
+    // Stamp the timeline and publish the new state
+    void transitionTo(ChunkState newState);
     
-    // Store actual Block objects (populated by main thread in openglInitialize)
-    std::vector<std::vector<std::vector<std::shared_ptr<Block>>>> blocks_;
+    // Current voxel version (populated by worker thread, replaced by edits). Null until the
+    // chunk has data and while it is compressed. Read and written with std::atomic_load/store.
+    VoxelSnapshot voxels_;
+    
+    // Current light version; null until the first mesh build lights the chunk, and while it is
+    // compressed. Read and written with std::atomic_load/store like voxels_.
+    LightSnapshot light_;
+    // ADD seeds for lit neighbours left by the first lighting (keys relative to this chunk),
+    // collected by the planet; protected by dataMutex_
+    std::vector<LightSeed> lightSpills_;
+    // Voxel version the first lighting read, until takeLightSpills compares it with the current
+    // one: an edit published while the build ran is not in that light, and its own seed was
+    // dropped because the chunk was not lit yet. Protected by dataMutex_.
+    VoxelSnapshot litVoxels_;
+    
+    // Publish a complete new version (generation, load, decompression)
+    void publishVoxels(std::shared_ptr<VoxelData> voxels);
+    // Copy the current version, apply the edit to the copy and publish it
+    void editVoxels(const std::function<void(VoxelData&)>& edit);
+    // Publish the bulk edit changes from firstChange on as one voxel version and mark the
+    // sections within one block of them (the non-template half of editBlocks)
+    size_t publishBlockChanges(const std::vector<BlockChange>& changes, size_t firstChange);
+    
+    // Block objects built from the voxel version (populated by main thread in openglInitialize).
+    // A cache: getBlockAtLocal rebuilds an entry whose type no longer matches its voxel, so bulk
+    // edits only publish voxels. Protected by dataMutex_.
+    mutable std::vector<std::vector<std::vector<std::shared_ptr<Block>>>> blocks_;
     
     // Flag to indicate if chunk mesh needs to be rebuilt
     std::atomic<bool> needsRebuild_;
     
+    // Sections changed by edits since their faces were last built, one bit per section. An edit
+    // publishes its voxel version before setting the bits. A full build's dispatcher clears them
+    // before it takes the neighbour snapshots, so an edit made after that (in this chunk or on a
+    // neighbour's border) keeps its bits and is re-meshed by rebuildDirtySections.
+    std::atomic<uint32_t> dirtySections_{0};
+    
     // Mesh data for rendering visible faces
     ChunkMesh surfaceMesh;
     
-    // Vertex and index data for mesh building (protected by meshMutex_)
+    // Where each section's faces sit in meshVertices / meshIndices (in vertices and indices)
+    struct MeshSectionRange {
+        uint32_t firstVertex = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+    };
+    
+    // Vertex and index data for mesh building (protected by meshMutex_). Faces are grouped by
+    // section so an edit can replace one section's range and keep the rest.
     std::vector<float> meshVertices;
     std::vector<unsigned int> meshIndices;
+    std::array<MeshSectionRange, CHUNK_SECTION_COUNT> sectionRanges_;
+    
+    // Run-length encoded voxel types ([count, type] pairs) while the chunk sits in the
+    // compressed residency tier; decoded by generateDataAsync instead of regenerating
+    std::vector<uint16_t> compressedVoxels_;
     
     // Planet context (optional)
     std::optional<glm::vec3> planetCenter_;
     std::optional<float> planetRadius_;
     
+    // Publish a single-block change and mark the sections it affects; false if the type is unchanged
+    bool writeVoxel(int x, int y, int z, uint16_t blockType);
+    
     // Check if a block exists at local chunk coordinates (thread-safe)
     bool hasBlockAtLocal(int x, int y, int z) const;
     
     // Build the surface mesh for the chunk (can be called from worker thread)
-    void buildSurfaceMesh(const World* world, const std::optional<glm::vec3>& planetCenter, const std::optional<float>& planetRadius);
+    void buildSurfaceMesh(const World* world, const std::optional<glm::vec3>& planetCenter, const std::optional<float>& planetRadius,
+                          const ChunkNeighbors& neighbors = ChunkNeighbors());
     
     // Helper to add a face to the mesh data vectors
     void addFace(const glm::vec3& corner, const glm::vec3& side1, const glm::vec3& side2, 
@@ -92,6 +169,21 @@ private:
     bool loadFromFile_DataOnly(const std::string& directoryPath, World* world);
 
 public:
+    // Section holding a local block
+    static int sectionIndex(int x, int y, int z) {
+        return ((x / CHUNK_SECTION_SIZE) * CHUNK_SECTIONS_PER_AXIS + y / CHUNK_SECTION_SIZE) * CHUNK_SECTIONS_PER_AXIS
+               + z / CHUNK_SECTION_SIZE;
+    }
+
+    // Mesher used by every mesh build and edit re-mesh from now on (any thread)
+    static void setMesher(ChunkMesher mesher);
+    static ChunkMesher getMesher();
+
+    // Bake per-vertex ambient occlusion into chunk meshes (on by default). Like the mesher, it
+    // applies to builds started from now on; meshes already built keep their occlusion.
+    static void setAmbientOcclusion(bool enabled);
+    static bool getAmbientOcclusion();
+
     // Constructor
     Chunk(const glm::vec3& position);
     
@@ -100,7 +192,7 @@ public:
     
     // Multi-threaded initialization phases
     void generateDataAsync(const World* world, int seed, const std::optional<glm::vec3>& planetCenter = std::nullopt, const std::optional<float>& planetRadius = std::nullopt);
-    void buildMeshAsync(const World* world);
+    void buildMeshAsync(const World* world, const ChunkNeighbors& neighbors = ChunkNeighbors());
     void initializeOpenGL(World* world);
     
     // Legacy methods for compatibility
@@ -112,6 +204,7 @@ public:
     ChunkState getState() const { return state_.load(); }
     bool isReadyForRendering() const { return state_.load() == ChunkState::FULLY_INITIALIZED; }
     bool isInitialized() const { return state_.load() == ChunkState::FULLY_INITIALIZED; }
+    const ChunkStateTimeline& getStateTimeline() const { return timeline_; }
     
     // Render the chunk's surface mesh
     void renderSurface(const glm::mat4& projection, const glm::mat4& view, bool wireframeState) const;
@@ -119,6 +212,18 @@ public:
     // Render all blocks individually (for the current player chunk)
     void renderAllBlocks(const glm::mat4& projection, const glm::mat4& view);
     
+    // Lock-free view of the current voxel version (null if the chunk has no data right now)
+    VoxelSnapshot getVoxelSnapshot() const { return std::atomic_load(&voxels_); }
+    
+    // Lock-free view of the current light version (null if the chunk is not lit yet)
+    LightSnapshot getLightSnapshot() const { return std::atomic_load(&light_); }
+    // Replace the light version (light engine batches; any thread). The caller marks the sections
+    // whose faces sample the changed light.
+    void publishLight(LightSnapshot light) { std::atomic_store(&light_, std::move(light)); }
+    // Move out the seeds the first lighting left for the neighbours, plus an EDIT seed for every
+    // voxel edited since the version that lighting read (keys relative to this chunk)
+    void takeLightSpills(std::vector<LightSeed>& out);
+    
     // Get block at local chunk coordinates (thread-safe)
     std::shared_ptr<Block> getBlockAtLocal(int x, int y, int z) const;
     
@@ -128,14 +233,48 @@ public:
     // Remove block at local chunk coordinates (marks for rebuild, thread-safe)
     void removeBlockAtLocal(int x, int y, int z);
     
+    // Set the block type at local chunk coordinates (0 = air) and mark the sections whose faces
+    // it can change. Returns false if nothing changed or the chunk has no editable data.
+    bool setBlockTypeAtLocal(int x, int y, int z, uint16_t blockType);
+    
+    // Bulk edit of the local box [localMin, localMax] (main thread).
+    // rule(const glm::ivec3& block, uint16_t currentType) -> uint16_t gives each block's new type,
+    // called with its local coordinates plus gridOffset; it is a template parameter so it inlines
+    // into the loop. Every change is published as one voxel version; Block objects are not built.
+    // The sections within one block of a change are marked; neighbouring chunks are the caller's.
+    // Appends the changes to changes and returns how many there were (0 if the chunk has no
+    // editable data).
+    template <typename Rule>
+    size_t editBlocks(const glm::ivec3& localMin, const glm::ivec3& localMax, const glm::ivec3& gridOffset,
+                      Rule&& rule, std::vector<BlockChange>& changes);
+    
+    // Mark the section holding a local block dirty, e.g. when a face-adjacent block in a
+    // neighbouring chunk changed
+    void markDirtyAt(int x, int y, int z);
+    // Mark every section overlapping the local box [localMin, localMax], clamped to the chunk
+    void markDirtyInBox(const glm::ivec3& localMin, const glm::ivec3& localMax);
+    // Mark every section dirty, e.g. when a block type the chunk uses changed its look
+    void markAllSectionsDirty();
+    // Mark the given sections dirty (one bit per section), e.g. after a light change
+    void markSectionsDirty(uint32_t sections) { dirtySections_.fetch_or(sections); }
+    bool hasDirtySections() const { return dirtySections_.load() != 0; }
+    // Main thread, when a full build is dispatched: it covers every section, so the bits are
+    // cleared right before its neighbour snapshots are gathered (see dirtySections_)
+    void clearDirtySections() { dirtySections_.store(0); }
+    
+    // Main thread only. Re-mesh the dirty sections of a chunk whose mesh is built (MESH_READY or
+    // FULLY_INITIALIZED), splice them into the mesh and re-upload it if it is on the GPU.
+    // Returns false if the chunk is in another state; the dirty sections are kept for later.
+    bool rebuildDirtySections(const ChunkNeighbors& neighbors);
+    
     // Get chunk position
     glm::vec3 getPosition() const;
     
     // Check if the mesh needs rebuilding
-    bool needsMeshRebuild() const { return needsRebuild_.load(); }
+    bool needsMeshRebuild() const { return needsRebuild_.load() || dirtySections_.load() != 0; }
     void markMeshRebuilt() { needsRebuild_.store(false); }
     
-    // Cleanup OpenGL resources
+    // Release GPU resources (deferred by the backend, so safe on any thread) and the CPU mesh
     void cleanupMesh();
 
     // Save and load chunk data
@@ -144,8 +283,53 @@ public:
     // Method to set planet context
     void setPlanetContext(const glm::vec3& planetCenter, float planetRadius);
 
-    GLuint getSurfaceMeshVAO() const { return surfaceMesh.VAO; }
+    unsigned int getSurfaceMeshVAO() const { return surfaceMesh.VAO; }
+
+    // Size of the CPU-side mesh (vertices + indices) produced by the last mesh build
+    size_t getMeshDataBytes() const;
+    // Copy of the CPU-side mesh, for tools that inspect or compare meshes
+    void copyMeshData(std::vector<float>& vertices, std::vector<unsigned int>& indices) const;
+    // Approximate memory held by voxel data and materialized Block objects
+    size_t getVoxelDataBytes() const;
+    size_t getCompressedDataBytes() const;
+    bool isCompressed() const;
+
+    // Residency demotion (main thread only). Each step drops one layer of derived data and
+    // moves the chunk back one pipeline state, so the normal pipeline rebuilds only what was
+    // dropped. Returns false if the chunk is not in the expected state (e.g. a worker owns it).
+    bool releaseGpuMesh();      // FULLY_INITIALIZED -> MESH_READY
+    bool releaseCpuMesh();      // MESH_READY -> DATA_READY
+    bool compressVoxelData();   // DATA_READY -> UNINITIALIZED (compressed)
 
     // OpenGL-specific initialization, should be called from the main thread.
     void openglInitialize(World* world);
 };
+
+template <typename Rule>
+size_t Chunk::editBlocks(const glm::ivec3& localMin, const glm::ivec3& localMax, const glm::ivec3& gridOffset,
+                         Rule&& rule, std::vector<BlockChange>& changes) {
+    if (state_.load() < ChunkState::DATA_READY) {
+        return 0; // A worker is about to publish the generated version over any edit
+    }
+    VoxelSnapshot current = getVoxelSnapshot();
+    if (!current) {
+        return 0;
+    }
+    const glm::ivec3 lo = glm::max(localMin, glm::ivec3(0));
+    const glm::ivec3 hi = glm::min(localMax, glm::ivec3(CHUNK_SIZE_X - 1, CHUNK_SIZE_Y - 1, CHUNK_SIZE_Z - 1));
+    const size_t firstChange = changes.size();
+    glm::ivec3 local;
+    for (local.x = lo.x; local.x <= hi.x; ++local.x) {
+        for (local.y = lo.y; local.y <= hi.y; ++local.y) {
+            size_t index = VoxelData::index(local.x, local.y, lo.z);
+            for (local.z = lo.z; local.z <= hi.z; ++local.z, ++index) {
+                const uint16_t oldType = static_cast<uint16_t>(current->atIndex(index).type);
+                const uint16_t newType = rule(local + gridOffset, oldType);
+                if (newType != oldType) {
+                    changes.push_back({static_cast<uint16_t>(index), oldType, newType});
+                }
+            }
+        }
+    }
+    return publishBlockChanges(changes, firstChange);
+}
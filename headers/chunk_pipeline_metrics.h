@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * Lock-free latency histogram with log-spaced buckets (4 per octave, microsecond
+ * resolution). Worker and main threads can record concurrently; percentiles are
+ * read from the bucket counts, so they are accurate to roughly +/-10%.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS_PER_OCTAVE = 4;
+    static constexpr int OCTAVES = 36; // Up to ~19 hours in microseconds, far beyond anything we measure
+    static constexpr int BUCKET_COUNT = BUCKETS_PER_OCTAVE * OCTAVES + 1;
+
+    LatencyHistogram();
+
+    void record(std::chrono::steady_clock::duration duration);
+    void reset();
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    double meanMs() const;
+    double maxMs() const;
+    // p in [0, 1], e.g. 0.95 for p95. Returns 0 when nothing has been recorded.
+    double percentileMs(double p) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sumMicros_;
+    std::atomic<uint64_t> maxMicros_;
+
+    static int bucketFor(uint64_t micros);
+    static double bucketMidpointMicros(int bucket);
+};
+
+/**
+ * Stages of the chunk pipeline. Every stage between two ChunkState transitions is
+ * either a queue wait (chunk sitting in a state until a thread picks it up) or an
+ * execution span (a thread actively working on the chunk).
+ */
+enum class PipelineStage {
+    GENERATION_WAIT,    // UNINITIALIZED -> DATA_GENERATING
+    GENERATION,         // DATA_GENERATING -> DATA_READY
+    MESH_WAIT,          // DATA_READY -> MESH_BUILDING
+    MESH_BUILD,         // MESH_BUILDING -> MESH_READY
+    UPLOAD_WAIT,        // MESH_READY -> OPENGL_INITIALIZING
+    UPLOAD,             // OPENGL_INITIALIZING -> FULLY_INITIALIZED
+    END_TO_END,         // UNINITIALIZED -> FULLY_INITIALIZED (request to visible)
+    COUNT
+};
+
+const char* pipelineStageName(PipelineStage stage);
+
+/**
+ * Timestamps of every ChunkState transition of a single chunk. Written by whichever
+ * thread performs the transition, before the state itself is published, so a reader
+ * that observed a state also observes its timestamp.
+ */
+struct ChunkStateTimeline {
+    static constexpr int STATE_COUNT = 7; // Number of ChunkState values (checked in chunk.h)
+
+    std::array<std::chrono::steady_clock::time_point, STATE_COUNT> enteredAt{};
+    uint8_t stampedMask = 0;
+
+    void stamp(int stateIndex) {
+        enteredAt[stateIndex] = std::chrono::steady_clock::now();
+        stampedMask |= static_cast<uint8_t>(1u << stateIndex);
+    }
+    bool has(int stateIndex) const { return (stampedMask & (1u << stateIndex)) != 0; }
+    void clear() { stampedMask = 0; }
+};
+
+// Number of queued (not yet started) tasks per pipeline queue at one instant
+struct PipelineBacklog {
+    size_t generationQueued = 0;
+    size_t meshQueued = 0;
+    size_t mainThreadQueued = 0;
+
+    size_t total() const { return generationQueued + meshQueued + mainThreadQueued; }
+};
+
+/**
+ * Aggregated per-stage latency histograms for the chunk pipeline, owned by World.
+ */
+class ChunkPipelineMetrics {
+public:
+    ChunkPipelineMetrics();
+
+    // Record a chunk that reached FULLY_INITIALIZED. Stages whose endpoints were not
+    // both stamped (e.g. legacy ensureInitialized path) are skipped.
+    void recordCompletedChunk(const ChunkStateTimeline& timeline);
+
+    const LatencyHistogram& histogram(PipelineStage stage) const { return histograms_[static_cast<int>(stage)]; }
+    uint64_t completedChunks() const { return completedChunks_.load(std::memory_order_relaxed); }
+    void reset();
+
+    // Human-readable p50/p95/p99 table, one line per stage.
+    void printReport(std::ostream& out) const;
+    // Machine-readable dump (JSON object keyed by stage name).
+    void writeJSON(std::ostream& out) const;
+    bool writeJSONFile(const std::string& path) const;
+
+private:
+    std::array<LatencyHistogram, static_cast<int>(PipelineStage::COUNT)> histograms_;
+    std::atomic<uint64_t> completedChunks_;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+#include "voxel_data.h" // IVec3Hash
+
+class Chunk;
+
+// How much of a parked chunk is still resident, from most to least expensive to rebuild
+enum class ResidencyTier {
+    GPU_MESH,    // Fully initialized; comes back with no pipeline work at all
+    CPU_MESH,    // Mesh vertices/indices kept, GPU objects released; needs an upload
+    VOXEL_DATA,  // Voxel data only; needs meshing and upload
+    COMPRESSED,  // Run-length encoded voxels; needs decoding, meshing and upload
+    COUNT
+};
+
+const char* residencyTierName(ResidencyTier tier);
+
+/**
+ * Holds chunks that left a planet's active region so a returning camera does not have to
+ * regenerate them. Every tier has a byte budget and an LRU list; when a tier is over budget
+ * its least recently parked chunk is demoted one tier (dropping the data that tier does not
+ * keep), and chunks demoted past COMPRESSED are evicted. Evicted chunks are rebuilt from the
+ * saved chunk file or regenerated as usual.
+ *
+ * Main thread only (demotion releases GPU objects).
+ */
+class ChunkResidencyCache {
+public:
+    ChunkResidencyCache();
+    ~ChunkResidencyCache();
+
+    void setBudget(ResidencyTier tier, size_t bytes);
+    size_t getBudget(ResidencyTier tier) const { return budgets_[static_cast<int>(tier)]; }
+
+    // Park a chunk that left the active region, in the tier matching how far along the
+    // pipeline it got, then enforce the budgets.
+    void park(const glm::ivec3& key, std::shared_ptr<Chunk> chunk);
+    // Remove a parked chunk and hand it back (nullptr if it is not cached)
+    std::shared_ptr<Chunk> take(const glm::ivec3& key);
+    void clear();
+    // Visit every parked chunk, in no particular order
+    void forEach(const std::function<void(const glm::ivec3&, const std::shared_ptr<Chunk>&)>& visit) const;
+
+    size_t chunkCount(ResidencyTier tier) const { return tiers_[static_cast<int>(tier)].entries.size(); }
+    size_t bytes(ResidencyTier tier) const { return tiers_[static_cast<int>(tier)].bytes; }
+    uint64_t hits(ResidencyTier tier) const { return hits_[static_cast<int>(tier)]; }
+    uint64_t evictions() const { return evictions_; }
+
+    // One line per tier: chunks, bytes / budget, hits
+    void printStats(std::ostream& out) const;
+
+private:
+    struct Entry {
+        glm::ivec3 key;
+        std::shared_ptr<Chunk> chunk;
+        size_t bytes;
+    };
+    struct Tier {
+        std::list<Entry> entries; // Front = most recently parked
+        size_t bytes = 0;
+    };
+    struct Location {
+        int tier;
+        std::list<Entry>::iterator entry;
+    };
+
+    static constexpr int TIER_COUNT = static_cast<int>(ResidencyTier::COUNT);
+
+    std::array<Tier, TIER_COUNT> tiers_;
+    std::array<size_t, TIER_COUNT> budgets_;
+    std::array<uint64_t, TIER_COUNT> hits_{};
+    uint64_t evictions_ = 0;
+    std::unordered_map<glm::ivec3, Location, IVec3Hash> index_;
+
+    void insert(int tier, const glm::ivec3& key, std::shared_ptr<Chunk> chunk, bool mostRecent);
+    std::shared_ptr<Chunk> remove(const glm::ivec3& key);
+    void enforceBudgets();
+    // Demote a chunk to the next tier down, or evict it if it cannot be demoted
+    void demote(int tier, Entry entry);
+    static size_t residentBytes(int tier, const Chunk& chunk);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "render_backend.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * OpenGL 3.3 implementation of the render backend, installed by the game at start-up.
+ *
+ * Released VAOs and buffers are only queued (from any thread); processPendingReleases drains
+ * the queue on the main thread in per-frame batches. Reclaimed handles are kept in free lists
+ * and handed to the next uploads instead of calling glGen*, and only handles beyond the free
+ * list capacity are deleted, in one glDelete* call per batch.
+ */
+class GLRenderBackend : public RenderBackend {
+public:
+    bool prepareChunkRendering() override;
+    bool uploadChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                         const std::vector<unsigned int>& indices) override;
+    bool updateChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                         const std::vector<unsigned int>& indices) override;
+    void releaseChunkMesh(ChunkMesh& mesh) override;
+    void renderChunkMesh(const ChunkMesh& mesh, const glm::vec3& chunkPosition,
+                         const glm::mat4& projection, const glm::mat4& view, bool wireframe) override;
+    void releaseVertexArray(unsigned int vertexArrayId) override;
+    void releaseBuffer(unsigned int bufferId) override;
+    void processPendingReleases() override;
+    void shutdown() override;
+
+private:
+    // Upper bounds that keep a single frame's reclamation cheap and the free lists from hoarding handles
+    static constexpr size_t MAX_RELEASES_PER_FRAME = 256;
+    static constexpr size_t MAX_FREE_VERTEX_ARRAYS = 256;
+    static constexpr size_t MAX_FREE_BUFFERS = 512;
+
+    // Filled from any thread
+    std::mutex pendingMutex_;
+    std::vector<unsigned int> pendingVertexArrays_;
+    std::vector<unsigned int> pendingBuffers_;
+
+    // Main thread only
+    std::vector<unsigned int> freeVertexArrays_;
+    std::vector<unsigned int> freeBuffers_;
+    uint64_t generatedObjects_ = 0;
+    uint64_t recycledObjects_ = 0;
+    uint64_t deletedObjects_ = 0;
+
+    unsigned int acquireVertexArray();
+    unsigned int acquireBuffer();
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <glm/glm.hpp>
+#include "voxel_data.h" // LightData and VoxelData
+
+struct ChunkNeighbors;
+
+enum class LightChannel : uint8_t {
+    SKY,    // Sunlight: enters through a chunk's up face and falls down without dimming
+    BLOCK   // Emitted by blocks with a light level
+};
+
+// Where sky light comes from for one chunk
+struct LightSkyContext {
+    int downFace = 4;      // Face (mesher order) that sky light at full level falls through undimmed: toward the planet centre, -Y on flat ground
+    bool openSky = true;   // The up face sees open sky when no chunk is above it (no planet chunk can ever exist there)
+};
+
+// Sky direction for the chunk whose first block is at chunkPosition. Chunks outside a planet
+// context fall toward -Y and are open to the sky.
+LightSkyContext skyContextForChunk(const glm::vec3& chunkPosition, const std::optional<glm::vec3>& planetCenter,
+                                   const std::optional<float>& planetRadius);
+
+/**
+ * One pending light change. EDIT: the voxel's block changed (its new type is read from the
+ * chunk's voxel version). ADD: light of level is offered to the voxel. REMOVE: light that
+ * reached the voxel with level (the removal threshold, see LightEngine) is gone.
+ */
+struct LightSeed {
+    enum Kind : uint8_t { EDIT, ADD, REMOVE };
+
+    glm::ivec3 chunk{0};       // Chunk key
+    uint16_t index = 0;        // VoxelData::index of the voxel
+    Kind kind = EDIT;
+    LightChannel channel = LightChannel::SKY; // ADD and REMOVE only
+    uint8_t level = 0;         // ADD and REMOVE only
+};
+
+// A lit chunk taking part in a light batch
+struct LightRegionChunk {
+    glm::ivec3 key{0};
+    VoxelSnapshot voxels;
+    LightSnapshot light;
+    LightSkyContext sky;
+};
+
+// New light of one region chunk and the mesh sections whose faces sample a changed voxel.
+// light is null when only the sections changed (light changed in a neighbouring chunk).
+struct LightUpdate {
+    glm::ivec3 key{0};
+    std::shared_ptr<LightData> light;
+    uint32_t dirtySections = 0;
+};
+
+struct LightBatchResult {
+    std::vector<LightUpdate> updates;
+    std::vector<LightSeed> spills;   // Light leaving the region, keyed by the chunk it enters
+    size_t changedVoxels = 0;
+};
+
+/**
+ * Flood-fill voxel lighting with a sky and a block channel (0-15 each). Light moves to the six
+ * face neighbours, one level dimmer per step, through every voxel that is not opaque; sky light
+ * at full level falls through the sky context's down face without dimming.
+ *
+ * Updates are breadth-first over queues of packed nodes (chunk slot, voxel index and level in
+ * one word). The queues are per thread and reused, so a batch allocates nothing per node.
+ * Removal is the usual two-queue scheme: dependent light dimmer than the removed light is
+ * cleared, and brighter light at the edge of the cleared area is re-propagated into it.
+ *
+ * Light never changes another chunk than the ones it is given: light that would enter a chunk
+ * outside the region comes back as spill seeds, which the caller batches into the next run.
+ * All functions are thread-safe and take only immutable chunk versions.
+ */
+class LightEngine {
+public:
+    // Light a chunk from scratch: open sky above it, its emitters, and light entering from the
+    // lit neighbours (ChunkNeighbors::light). spills (optional) receives ADD seeds for the lit
+    // neighbours this chunk brightens, keyed by the face offset relative to the chunk.
+    static void lightChunk(const VoxelData& voxels, const ChunkNeighbors& neighbors, const LightSkyContext& sky,
+                           LightData& light, std::vector<LightSeed>* spills = nullptr);
+
+    // Apply a batch of seeds to a region of lit chunks. An EDIT is refilled from its six face
+    // neighbours, so the region must hold the lit face neighbours of every EDIT seed's chunk
+    // (Planet takes every lit chunk within one chunk of a seed). Seeds for chunks outside the
+    // region are ignored. The result holds a new light version for every chunk whose light changed.
+    static LightBatchResult propagate(const std::vector<LightRegionChunk>& region, const std::vector<LightSeed>& seeds);
+
+    // Clear and relight a whole region from its own sources (emitters and open sky where no
+    // chunk of the region is above). Used as the reference for incremental updates.
+    static LightBatchResult relight(const std::vector<LightRegionChunk>& region);
+};
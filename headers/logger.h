@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+// Subsystems that can be filtered independently
+enum class LogCategory : uint8_t {
+    General,    // Application start-up/shutdown, window, input
+    World,      // World, thread pools, performance reports
+    Streaming,  // Planet chunk scheduling and unloading
+    Generation, // Terrain generation and chunk file I/O
+    Meshing,    // Surface mesh building
+    Upload,     // GPU object creation for chunk meshes
+    Render,     // Shaders, textures and draw calls
+    Registry,   // Block registry and definition loading
+    Count
+};
+
+const char* logLevelName(LogLevel level);
+const char* logCategoryName(LogCategory category);
+
+/**
+ * Per-callsite rate limiter. Allows one message per interval and counts the ones it
+ * dropped so the next message that gets through can report them.
+ */
+class LogRateLimiter {
+public:
+    explicit LogRateLimiter(int64_t intervalMs) : intervalNs_(intervalMs * 1000000), nextAllowedNs_(0), suppressed_(0) {}
+
+    bool allow();
+    // Number of messages dropped since the last allowed one (resets the count)
+    uint32_t takeSuppressed() { return suppressed_.exchange(0, std::memory_order_relaxed); }
+
+private:
+    int64_t intervalNs_;
+    std::atomic<int64_t> nextAllowedNs_;
+    std::atomic<uint32_t> suppressed_;
+};
+
+/**
+ * Asynchronous leveled logger. Callers format into a local buffer and hand the finished
+ * line to a background writer thread, so hot paths never block on stdout/stderr or
+ * their locks. Warn and Error lines go to stderr, everything else to stdout.
+ *
+ * Thresholds default to Info and can be set per category in code or through the
+ * AZUREVOXEL_LOG environment variable, e.g. AZUREVOXEL_LOG="info,streaming=debug,meshing=trace".
+ */
+class Logger {
+public:
+    // Lines queued beyond this are dropped (Debug/Trace first) rather than growing without bound
+    static constexpr size_t MAX_QUEUED_MESSAGES = 16384;
+
+    static Logger& getInstance();
+
+    bool shouldLog(LogLevel level, LogCategory category) const {
+        return static_cast<uint8_t>(level) >= thresholds_[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    void setLevel(LogCategory category, LogLevel level);
+    void setLevel(LogLevel level); // All categories
+    // Parse "level" or "category=level" entries separated by commas; returns false on unknown names
+    bool configure(const std::string& spec);
+
+    void submit(LogLevel level, LogCategory category, std::string message);
+
+    // Block until everything queued so far has been written
+    void flush();
+    // Drain the queue and stop the writer; later messages are written synchronously
+    void shutdown();
+
+    uint64_t droppedMessages() const { return dropped_.load(std::memory_order_relaxed); }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    struct Entry {
+        LogLevel level;
+        LogCategory category;
+        std::string text;
+    };
+
+    Logger();
+    void writerLoop();
+    static void writeEntry(const Entry& entry);
+
+    std::array<std::atomic<uint8_t>, static_cast<size_t>(LogCategory::Count)> thresholds_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::condition_variable drainedCondition_;
+    std::deque<Entry> queue_;
+    uint64_t submittedCount_ = 0; // Guarded by queueMutex_
+    uint64_t writtenCount_ = 0;   // Guarded by queueMutex_
+    bool running_ = false;
+    std::atomic<uint64_t> dropped_;
+    std::thread writer_;
+};
+
+// One log line; formats into a local stream and submits on destruction
+class LogMessage {
+public:
+    LogMessage(LogLevel level, LogCategory category, LogRateLimiter* limiter = nullptr)
+        : level_(level), category_(category), limiter_(limiter) {}
+    ~LogMessage();
+
+    std::ostringstream& stream() { return stream_; }
+
+    LogMessage(const LogMessage&) = delete;
+    LogMessage& operator=(const LogMessage&) = delete;
+
+private:
+    LogLevel level_;
+    LogCategory category_;
+    LogRateLimiter* limiter_;
+    std::ostringstream stream_;
+};
+
+// Stream-style logging: AZV_LOG_INFO(Streaming) << "Loaded " << n << " chunks";
+// The message expression is not evaluated when the level is filtered out.
+#define AZV_LOG(level, category) \
+    if (!Logger::getInstance().shouldLog(level, category)) {} else LogMessage(level, category).stream()
+
+// As AZV_LOG, but at most one line per intervalMs from this callsite
+#define AZV_LOG_RATE_LIMITED(level, category, intervalMs) \
+    if (static LogRateLimiter azvLogLimiter(intervalMs); !Logger::getInstance().shouldLog(level, category) || !azvLogLimiter.allow()) {} \
+    else LogMessage(level, category, &azvLogLimiter).stream()
+
+#define AZV_LOG_TRACE(category) AZV_LOG(LogLevel::Trace, LogCategory::category)
+#define AZV_LOG_DEBUG(category) AZV_LOG(LogLevel::Debug, LogCategory::category)
+#define AZV_LOG_INFO(category)  AZV_LOG(LogLevel::Info, LogCategory::category)
+#define AZV_LOG_WARN(category)  AZV_LOG(LogLevel::Warn, LogCategory::category)
+#define AZV_LOG_ERROR(category) AZV_LOG(LogLevel::Error, LogCategory::category)
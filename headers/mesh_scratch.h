@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Heap allocations made by mesh buffers on the calling thread
+uint64_t& meshThreadAllocationCount();
+
+// std::allocator that counts its allocations, so mesh building can report how often its
+// buffers had to grow
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        ++meshThreadAllocationCount();
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+// Floats per chunk mesh vertex: position (3), texture coordinates (2), packed light and occlusion (1)
+constexpr int CHUNK_VERTEX_FLOATS = 6;
+
+// The last vertex float is light byte + occlusion * CHUNK_VERTEX_AO_SCALE. The light byte is the
+// face's sky << 4 | block level; occlusion is the corner's ambient occlusion level, 0 (three
+// occluders) to CHUNK_VERTEX_AO_OPEN (none), and stays open when ambient occlusion is off.
+constexpr int CHUNK_VERTEX_AO_SCALE = 256;
+constexpr int CHUNK_VERTEX_AO_OPEN = 3;
+
+using MeshVertexBuffer = std::vector<float, CountingAllocator<float>>;
+using MeshIndexBuffer = std::vector<unsigned int, CountingAllocator<unsigned int>>;
+
+// Process-wide totals over every mesh built through a MeshScratch
+struct MeshAllocationStats {
+    uint64_t meshes = 0;
+    uint64_t reallocations = 0;          // Scratch buffer growths (allocations after the arena was set up)
+    uint64_t meshesWithReallocation = 0;
+    size_t peakVertexFloats = 0;         // Largest mesh so far; new arenas start with this capacity
+    size_t peakIndices = 0;
+
+    // One line: meshes, reallocations per mesh, peak sizes
+    void printStatus(std::ostream& out) const;
+};
+
+/**
+ * Per-thread scratch arena for mesh building. The mesher appends into the arena's buffers and
+ * the result is copied once into exact-size vectors that the chunk keeps. The arena is only
+ * cleared between meshes, never freed, and a new thread's arena starts at the largest mesh seen
+ * on any thread, so after warm-up a mesh build performs no allocation besides that final copy.
+ *
+ * Not reentrant: one mesh per thread at a time (begin ... end).
+ */
+class MeshScratch {
+public:
+    // The calling thread's arena, emptied and with capacity for the largest mesh built so far
+    static MeshScratch& begin();
+    // Record this mesh's size and how many times the buffers grew while building it
+    void end();
+
+    static MeshAllocationStats getStats();
+    static void resetStats();
+
+    MeshVertexBuffer vertices;
+    MeshIndexBuffer indices;
+
+private:
+    uint64_t allocationsAtBegin_ = 0;
+};
@@ -5,27 +5,29 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional> // For std::hash
 #include <glm/glm.hpp>
 // #include <glm/gtx/hash.hpp> // No longer attempting to use this due to compiler issues
 
 #include "chunk.h" // Relies on CHUNK_SIZE constants and Chunk class
 #include "camera.h" // For update method
+#include "chunk_residency_cache.h" // Parked chunks outside the active region
+#include "light_engine.h"
+#include "voxel_raycast.h"
+#include "voxel_physics.h"
 
 // Forward declaration for World, if Planet needs to interact with it (e.g. for global systems)
 class World;
+class Planet;
 
-// Custom hash for glm::ivec3 for std::unordered_map
-struct IVec3Hash {
-    std::size_t operator()(const glm::ivec3& v) const {
-        std::size_t h1 = std::hash<int>()(v.x);
-        std::size_t h2 = std::hash<int>()(v.y);
-        std::size_t h3 = std::hash<int>()(v.z);
-        // A common way to combine hashes:
-        // (boost::hash_combine uses something like seed ^= hash_value(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);)
-        // For simplicity, a basic combination:
-        return h1 ^ (h2 << 1) ^ (h3 << 2); 
-    }
+// The block grid a bulk block query was answered in. The query buffer holds size.x * size.y *
+// size.z block IDs, x-major like VoxelData: block (x, y, z) of the box is at (x * size.y + y) * size.z + z.
+struct BlockQueryRegion {
+    const Planet* planet = nullptr; // Null when the box touches no planet
+    glm::ivec3 minBlock{0};         // First block of the box, in the planet's block grid
+    glm::ivec3 size{0};             // Blocks per axis
+    glm::vec3 worldOrigin{0.0f};    // World position of minBlock's min corner
 };
 
 class Planet {
@@ -37,13 +39,72 @@ public:
     void render(const glm::mat4& projection, const glm::mat4& view, bool wireframeState) const;
 
     std::shared_ptr<Block> getBlockAtWorldPos(const glm::vec3& worldPos) const;
-    // void setBlockAtWorldPos(const glm::vec3& worldPos, BlockType type); // Future enhancement
+    // First block passing filter along a ray through this planet's loaded chunks (VoxelRaycaster).
+    // The walk stops where the ray leaves the planet's bounds, so maxDistance may be infinite.
+    // Main thread, like getBlockAtWorldPos: the chunk map changes in update.
+    RaycastHit raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                       RaycastFilter filter = RaycastFilter::ANY_BLOCK) const;
+    // Block IDs of the box [minBlock, maxBlock] (inclusive, in this planet's block grid) into out,
+    // in BlockQueryRegion order. Each chunk the box touches is looked up once and copied out in
+    // z runs. Blocks of chunks without voxel data read as unloadedFill; returns how many did.
+    // Main thread, like getBlockAtWorldPos.
+    size_t queryBlocks(const glm::ivec3& minBlock, const glm::ivec3& maxBlock, uint16_t* out, uint16_t unloadedFill = 0) const;
+    // Collision source over this planet's loaded chunks for VoxelPhysics. It reads the chunk map,
+    // so step it on the main thread; it can be kept for as long as the planet lives.
+    VoxelCollider makeCollider(bool unloadedIsSolid = true) const;
+    // Change one block of a loaded chunk (0 = air). The voxel change is visible immediately;
+    // the affected mesh sections of the chunk, and of a neighbouring chunk when the block is on
+    // a border, are rebuilt by the next rebuildEditedChunks. The light change is queued for the
+    // next light batch. Returns false if the chunk is not loaded, has no data yet, or the block
+    // already has that type.
+    bool setBlockAtWorldPos(const glm::vec3& worldPos, uint16_t blockType);
+    // Bulk edit of the box [minBlock, maxBlock] (inclusive, in this planet's block grid): rule
+    // gives each block's new type (Chunk::editBlocks). Every loaded chunk the box covers is
+    // written once, then each changed chunk and the border sections of its face neighbours that
+    // face a change are queued once for the next rebuildEditedChunks. Light changes are queued
+    // only for blocks whose opacity or emission changed. Blocks of unloaded chunks are skipped.
+    // Returns the blocks changed. Main thread. rule is a template parameter so it inlines into
+    // the chunk loops.
+    template <typename Rule>
+    size_t editBlocks(const glm::ivec3& minBlock, const glm::ivec3& maxBlock, Rule&& rule);
+    // Main thread. Re-mesh and re-upload the sections touched by edits; called at the start of update
+    void rebuildEditedChunks();
+    // Hot reload (main thread, workers idle). Marks for re-mesh every meshed chunk, active or
+    // parked, whose palette holds a type flagged in changedTypes, plus the facing border
+    // sections of its neighbours when the type is also flagged in cullingTypes (its solidity,
+    // transparency or opacity changed). Every lit chunk holding a type flagged in lightTypes
+    // (its opacity or light level changed) gets an EDIT light seed per voxel of that type; a
+    // parked chunk's seeds wait until it is restored. All three are indexed by block ID.
+    // Returns the chunks marked.
+    size_t markChunksUsingBlocks(const std::vector<bool>& changedTypes, const std::vector<bool>& cullingTypes,
+                                 const std::vector<bool>& lightTypes);
+    // Main thread. Start one light batch on the mesh workers for the light changes queued since
+    // the last one (edits, and light crossing chunk borders), unless a batch is still running.
+    // Called at the end of update. Returns true if a batch was started.
+    bool dispatchLightUpdates(const World* world_context);
+    bool hasPendingLightUpdates() const { return lightBatchInFlight_ || !pendingLightSeeds_.empty(); }
 
     glm::vec3 getPosition() const { return position_; }
     float getRadius() const { return radius_; }
     const std::string& getName() const { return name_; }
 
+    // Chunks that left the active region, kept in tiers so a returning camera can reuse them
+    ChunkResidencyCache& getResidencyCache() { return residencyCache_; }
+    const ChunkResidencyCache& getResidencyCache() const { return residencyCache_; }
+
 private:
+    // A bulk edit in progress: the changes of the chunk being edited and the grid bounds of the
+    // changes in each changed chunk, for marking the neighbours once at the end
+    struct BulkEdit {
+        std::vector<BlockChange> changes;
+        std::vector<std::pair<glm::ivec3, std::pair<glm::ivec3, glm::ivec3>>> changedChunks;
+        size_t changed = 0;
+    };
+    // Queue the light seeds and bounds of the changes editBlocks just made in one chunk
+    void recordBulkEdit(const glm::ivec3& chunkKey, BulkEdit& edit);
+    // Mark the face neighbours of the changed chunks and return the blocks changed
+    size_t finishBulkEdit(const BulkEdit& edit);
+
     glm::vec3 position_; // Center of the planet in world space
     float radius_;
     int seed_;
@@ -52,15 +113,63 @@ private:
     // Chunks belonging to this planet.
     // Keyed by their grid position relative to the planet's center (in chunk units).
     std::unordered_map<glm::ivec3, std::shared_ptr<Chunk>, IVec3Hash> chunks_;
+    ChunkResidencyCache residencyCache_;
 
     int chunksInRadius_; // Number of chunks from center to surface along an axis (approximate)
-    int chunkRenderDistance_ = 14; // Max render distance in chunk units (radius) - increased for testing
-    int maxChunksPerFrame_ = 1; // Maximum chunks to generate per frame to prevent lag
+    int chunkRenderDistance_ = 14; // Max render distance in chunk units (radius); set from the world's StreamingBudgetController
+    int maxChunksPerFrame_ = 3; // Maximum chunk tasks to start per frame to prevent lag; set from the same controller
     std::vector<glm::ivec3> activeChunkKeys_; // Chunks within render distance of camera
+    std::unordered_set<glm::ivec3, IVec3Hash> editedChunkKeys_; // Chunks with dirty mesh sections
+
+    // Light changes waiting for the next batch; at most one batch runs at a time, and chunks
+    // next to its region are not lit for the first time until it is done, so they never read
+    // light it is about to replace
+    std::vector<LightSeed> pendingLightSeeds_;
+    // Seeds from a hot reload for chunks that were parked at the time, queued when they return
+    std::unordered_map<glm::ivec3, std::vector<LightSeed>, IVec3Hash> parkedLightSeeds_;
+    bool lightBatchInFlight_ = false;
+    std::unordered_set<glm::ivec3, IVec3Hash> lightRegionKeys_;
+    bool bordersLightRegion(const glm::ivec3& chunkKey) const;
+
+    // Voxel version of a loaded chunk, or null
+    VoxelSnapshot voxelsAt(const glm::ivec3& chunkKey) const;
+
+    // Voxel and light versions of the loaded face-adjacent chunks, for border face culling and lighting
+    ChunkNeighbors gatherNeighbors(const glm::ivec3& chunkKey) const;
     
     // Path for saving/loading planet-specific chunk data, if applicable in the future.
     // For now, planets and their chunks are procedurally generated in memory.
     // std::string dataPath_; 
 };
 
+template <typename Rule>
+size_t Planet::editBlocks(const glm::ivec3& minBlock, const glm::ivec3& maxBlock, Rule&& rule) {
+    const glm::ivec3 size = maxBlock - minBlock + 1;
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0) {
+        return 0;
+    }
+    const glm::ivec3 chunkSize(CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z);
+    const glm::ivec3 minKey(chunkCoordinateOf(minBlock.x), chunkCoordinateOf(minBlock.y), chunkCoordinateOf(minBlock.z));
+    const glm::ivec3 maxKey(chunkCoordinateOf(maxBlock.x), chunkCoordinateOf(maxBlock.y), chunkCoordinateOf(maxBlock.z));
+
+    BulkEdit edit;
+    glm::ivec3 key;
+    for (key.x = minKey.x; key.x <= maxKey.x; ++key.x) {
+        for (key.y = minKey.y; key.y <= maxKey.y; ++key.y) {
+            for (key.z = minKey.z; key.z <= maxKey.z; ++key.z) {
+                auto it = chunks_.find(key);
+                if (it == chunks_.end() || !it->second) {
+                    continue;
+                }
+                const glm::ivec3 chunkMin = key * chunkSize;
+                edit.changes.clear();
+                if (it->second->editBlocks(minBlock - chunkMin, maxBlock - chunkMin, chunkMin, rule, edit.changes) > 0) {
+                    recordBulkEdit(key, edit);
+                }
+            }
+        }
+    }
+    return finishBulkEdit(edit);
+}
+
 #endif // PLANET_H 
\ No newline at end of file
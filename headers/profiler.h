@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Low-overhead scoped CPU profiler.
+ *
+ * Zones are recorded into per-thread ring buffers (no cross-thread contention on the hot
+ * path) and only while capture is enabled at runtime. A capture can be written out as
+ * Chrome trace_event JSON and opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * When the build is configured without AZUREVOXEL_PROFILER, the AZV_PROFILE_* macros
+ * expand to nothing and the instrumentation has zero cost.
+ */
+class Profiler {
+public:
+    // Number of zones kept per thread; older zones are overwritten once a buffer wraps
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+    // Start/stop recording. Starting a capture discards previously recorded zones.
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Name shown for the calling thread in the trace viewer
+    static void setThreadName(const std::string& name);
+
+    // Write every recorded zone as Chrome trace_event JSON
+    static bool writeChromeTrace(const std::string& path);
+
+    // Drop all recorded zones (thread registrations are kept)
+    static void clear();
+
+    // Monotonic timestamp in nanoseconds, relative to profiler start-up
+    static int64_t nowNs();
+
+    // Append a finished zone to the calling thread's buffer. `name` must have static storage.
+    static void recordZone(const char* name, int64_t startNs, int64_t endNs);
+};
+
+// RAII zone; records its lifetime if the profiler was enabled when it was entered
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : name_(name), startNs_(Profiler::isEnabled() ? Profiler::nowNs() : -1) {}
+    ~ProfileZone() {
+        if (startNs_ >= 0) {
+            Profiler::recordZone(name_, startNs_, Profiler::nowNs());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    int64_t startNs_;
+};
+
+#define AZV_PROFILE_CONCAT_INNER(a, b) a##b
+#define AZV_PROFILE_CONCAT(a, b) AZV_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef AZUREVOXEL_PROFILER
+#define AZV_PROFILE_ZONE(name) ProfileZone AZV_PROFILE_CONCAT(azvProfileZone_, __LINE__)(name)
+#define AZV_PROFILE_FUNCTION() AZV_PROFILE_ZONE(__func__)
+#define AZV_PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+#else
+#define AZV_PROFILE_ZONE(name) ((void)0)
+#define AZV_PROFILE_FUNCTION() ((void)0)
+// sizeof keeps the name's operands used without evaluating them
+#define AZV_PROFILE_THREAD_NAME(name) ((void)sizeof(name))
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct ChunkMesh;
+
+/**
+ * Boundary between the GL-free core (chunk data, generation, meshing, streaming) and the
+ * graphics API. Core code only ever talks to the installed backend; the game installs the
+ * OpenGL backend at start-up, while headless tools (azurevoxel_bench) keep the default null
+ * backend, which accepts every upload and draws nothing.
+ *
+ * All methods are called from the main thread, except the release* methods: chunks and
+ * blocks can be destroyed on a worker thread when a pool task drops the last reference, so
+ * backends must make releasing safe from any thread (the GL backend defers the actual
+ * deletion to processPendingReleases on the main thread).
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Make sure shared rendering state (shaders, block atlas) exists before the first upload.
+    // Returns false if uploads cannot happen right now (e.g. no current context).
+    virtual bool prepareChunkRendering() = 0;
+
+    // Create GPU objects for an interleaved pos3/uv2 vertex stream with 32-bit indices.
+    // On failure the mesh is left empty and false is returned.
+    virtual bool uploadChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                                 const std::vector<unsigned int>& indices) = 0;
+
+    // Replace the data of an uploaded mesh (after an edit). The default releases and uploads
+    // again; backends can re-specify the existing objects instead.
+    virtual bool updateChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                                 const std::vector<unsigned int>& indices);
+
+    // Release the GPU objects of a chunk mesh and reset its handles
+    virtual void releaseChunkMesh(ChunkMesh& mesh) = 0;
+
+    virtual void renderChunkMesh(const ChunkMesh& mesh, const glm::vec3& chunkPosition,
+                                 const glm::mat4& projection, const glm::mat4& view, bool wireframe) = 0;
+
+    // Release individual objects owned by code outside the chunk pipeline (e.g. Block)
+    virtual void releaseVertexArray(unsigned int vertexArrayId) = 0;
+    virtual void releaseBuffer(unsigned int bufferId) = 0;
+
+    // Main thread, once per frame: reclaim objects released since the last call
+    virtual void processPendingReleases() {}
+    // Main thread, while the context is still current: free every pending and recycled object
+    virtual void shutdown() {}
+
+    static RenderBackend& getInstance();
+    // Replace the active backend. Must happen before any chunk reaches the upload stage.
+    static void setInstance(std::unique_ptr<RenderBackend> backend);
+};
+
+// Backend that never touches a GPU; used by default and by headless tools
+class NullRenderBackend : public RenderBackend {
+public:
+    bool prepareChunkRendering() override { return true; }
+    bool uploadChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                         const std::vector<unsigned int>& indices) override;
+    void releaseChunkMesh(ChunkMesh& mesh) override;
+    void renderChunkMesh(const ChunkMesh&, const glm::vec3&, const glm::mat4&, const glm::mat4&, bool) override {}
+    void releaseVertexArray(unsigned int) override {}
+    void releaseBuffer(unsigned int) override {}
+};
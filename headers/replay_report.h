@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "chunk_pipeline_metrics.h"
+
+/**
+ * Per-frame results of a fixed-timestep camera path replay. Because the camera path and
+ * timestep are fixed, two builds replaying the same path produce directly comparable
+ * frame-time percentiles, streaming totals and backlog timelines.
+ */
+class ReplayReport {
+public:
+    struct Frame {
+        double simTime = 0.0;         // Seconds since replay start (frame index * timestep)
+        double frameMs = 0.0;         // Wall time spent on the frame
+        uint64_t chunksStreamed = 0;  // Chunks that reached FULLY_INITIALIZED so far
+        PipelineBacklog backlog;
+    };
+
+    void clear() { frames_.clear(); }
+    void recordFrame(const Frame& frame) { frames_.push_back(frame); }
+    size_t frameCount() const { return frames_.size(); }
+
+    // p in [0, 1]; exact (sorted) percentile over all recorded frames
+    double frameTimePercentileMs(double p) const;
+    double meanFrameMs() const;
+
+    // Summary plus a once-per-second timeline of streaming progress and backlog
+    void printReport(std::ostream& out) const;
+    void writeJSON(std::ostream& out) const;
+    bool writeJSONFile(const std::string& path) const;
+
+private:
+    std::vector<Frame> frames_;
+
+    // Indices of the first frame of each whole second of simulated time
+    std::vector<size_t> timelineFrames() const;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "chunk_pipeline_metrics.h"
+
+// Targets and limits for the adaptive streaming budget
+struct StreamingBudgetSettings {
+    bool enabled = true;              // false keeps the initial render distance and admission limit
+    double targetFrameMs = 16.6;      // Frame time the controller steers toward
+    double growBelowFraction = 0.75;  // Grow only while the smoothed frame time is under target * this
+    double shrinkAboveFraction = 1.1; // Shrink once the smoothed frame time is over target * this
+    int adjustIntervalFrames = 30;    // Frames between adjustments (lets a change settle before the next one)
+    int initialRenderDistance = 14;   // Chunks (radius)
+    int minRenderDistance = 4;
+    int maxRenderDistance = 24;
+    int initialChunksPerFrame = 3;    // New chunk / mesh tasks Planet::update may start per frame
+    int minChunksPerFrame = 1;
+    int maxChunksPerFrame = 16;
+    size_t backlogHighWater = 96;     // Queued tasks above which admission is throttled instead of raised
+};
+
+/**
+ * Adjusts the planet streaming radius and the per-frame admission limit from the measured
+ * frame time and pipeline backlog. Frame time is smoothed with an exponential moving average
+ * and compared against a band around the target (hysteresis), and changes are made at most
+ * once per adjustIntervalFrames:
+ *   - over budget: admission is halved first; render distance shrinks once admission is at its minimum
+ *   - backlog above the high-water mark: admission drops by one and render distance holds
+ *   - under budget: admission grows by one; render distance grows once the backlog has drained
+ *
+ * Main thread only.
+ */
+class StreamingBudgetController {
+public:
+    StreamingBudgetController();
+
+    // Resets the current values to the settings' initial ones
+    void setSettings(const StreamingBudgetSettings& settings);
+    const StreamingBudgetSettings& getSettings() const { return settings_; }
+
+    // Feed one frame: its CPU time and the pipeline backlog at the end of it
+    void recordFrame(double frameMs, const PipelineBacklog& backlog);
+
+    int renderDistance() const { return renderDistance_; }
+    int chunksPerFrame() const { return chunksPerFrame_; }
+    double smoothedFrameMs() const { return smoothedFrameMs_; }
+    uint64_t adjustments() const { return adjustments_; }
+
+    // One line: current values, smoothed frame time against the target
+    void printStatus(std::ostream& out) const;
+
+private:
+    StreamingBudgetSettings settings_;
+    int renderDistance_;
+    int chunksPerFrame_;
+    double smoothedFrameMs_ = 0.0;
+    bool hasSample_ = false;
+    int framesSinceAdjust_ = 0;
+    uint64_t adjustments_ = 0;
+
+    void adjust(size_t backlog);
+};
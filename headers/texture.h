@@ -20,6 +20,9 @@ public:
     // Loads a texture from a file
     bool loadFromFile(const std::string& filepath);
     
+    // Creates a texture from RGBA8 pixels (row 0 at v = 0), with mipmaps down to maxMipLevel
+    bool loadFromPixels(int pixelWidth, int pixelHeight, const unsigned char* rgba, int maxMipLevel);
+    
     // Loads a texture from a specific region of a spritesheet
     bool loadFromSpritesheet(const std::string& filepath, int atlasX, int atlasY, int atlasWidth, int atlasHeight);
     
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "block_registry.h"
+
+// Where per-block textures are read from and where the packed result is cached
+struct TextureAtlasSettings {
+    std::string sourceDirectory = "res/textures/blocks/";          // <texture name>.png (or .tga/.bmp)
+    std::string cachePath = "res/textures/blocks/atlas.cache";
+    int padding = 8;  // Edge pixels repeated around each tile; mip levels up to log2(padding) never bleed
+};
+
+/**
+ * RGBA atlas packed from per-block textures, plus the rectangle of every texture in it.
+ * Row 0 of pixels is v = 0, so it uploads to GL as-is.
+ */
+struct TextureAtlas {
+    int width = 0;
+    int height = 0;
+    int maxMipLevel = 0;              // Deepest mip level the padding keeps free of neighbour bleed
+    std::vector<uint8_t> pixels;      // width * height * 4 bytes
+    std::unordered_map<std::string, BlockFaceUV> rects;
+    BlockFaceUV missing;              // Checkerboard tile for names with no source image
+
+    bool empty() const { return rects.empty(); }
+};
+
+/**
+ * Builds the block texture atlas at startup from one image per texture name, so adding a
+ * block only needs its image dropped into the source directory.
+ *
+ * The packed atlas and its index map are written to a cache file keyed on every source's
+ * size and modification time; when nothing changed the next startup reads the cache and
+ * decodes no images. Tiles sit on a uniform grid (cell = largest tile + padding on each side,
+ * rounded up to the mip alignment) with their borders extended into the padding.
+ *
+ * Main thread only (image decoding uses stb_image's global flip setting).
+ */
+class TextureAtlasBuilder {
+public:
+    explicit TextureAtlasBuilder(const TextureAtlasSettings& settings = TextureAtlasSettings());
+
+    // Fills atlas for the given texture names. Returns false if no name has a source image,
+    // in which case the caller keeps the hand-authored spritesheet.
+    bool build(const std::vector<std::string>& textureNames, TextureAtlas& atlas);
+
+    bool loadedFromCache() const { return loadedFromCache_; }
+    size_t decodedImages() const { return decodedImages_; }
+
+private:
+    struct SourceStamp {
+        std::string name;
+        std::string path;     // Empty when no image exists for the name
+        uint64_t size = 0;
+        int64_t modified = 0;
+    };
+
+    TextureAtlasSettings settings_;
+    bool loadedFromCache_ = false;
+    size_t decodedImages_ = 0;
+
+    std::vector<SourceStamp> stampSources(const std::vector<std::string>& textureNames) const;
+    bool readCache(const std::vector<SourceStamp>& sources, TextureAtlas& atlas) const;
+    bool writeCache(const std::vector<SourceStamp>& sources, const TextureAtlas& atlas) const;
+    bool pack(const std::vector<SourceStamp>& sources, TextureAtlas& atlas);
+};
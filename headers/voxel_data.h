@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Constants for chunk dimensions
+constexpr int CHUNK_SIZE_X = 16;
+constexpr int CHUNK_SIZE_Y = 16;
+constexpr int CHUNK_SIZE_Z = 16;
+
+// Chunk coordinate of a block coordinate in a chunk grid (rounds toward negative infinity)
+inline int chunkCoordinateOf(int block) {
+    static_assert(CHUNK_SIZE_X == CHUNK_SIZE_Y && CHUNK_SIZE_Y == CHUNK_SIZE_Z, "chunk grids are cubic");
+    return block >= 0 ? block / CHUNK_SIZE_X : -((-block + CHUNK_SIZE_X - 1) / CHUNK_SIZE_X);
+}
+
+// Custom hash for glm::ivec3 for std::unordered_map
+struct IVec3Hash {
+    std::size_t operator()(const glm::ivec3& v) const {
+        std::size_t h1 = std::hash<int>()(v.x);
+        std::size_t h2 = std::hash<int>()(v.y);
+        std::size_t h3 = std::hash<int>()(v.z);
+        // A common way to combine hashes:
+        // (boost::hash_combine uses something like seed ^= hash_value(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);)
+        // For simplicity, a basic combination:
+        return h1 ^ (h2 << 1) ^ (h3 << 2);
+    }
+};
+
+// Index of the lowest set bit; used to walk the voxel and face bitmasks. bits must be non-zero.
+inline int countTrailingZeros(uint32_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+inline int countTrailingZeros(uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// NEW: Simple struct to hold block type information during data-only phase
+struct BlockInfo {
+    int type = 0; // 0 for air, 1 for stone, 2 for grass, etc.
+    // Add other non-OpenGL properties if needed (e.g. light level from world gen)
+};
+
+/**
+ * One version of a chunk's voxel types, stored x-major (x, then y, then z) to match the
+ * chunk file and compression order.
+ *
+ * Versions are copy-on-write: a writer fills a fresh or copied VoxelData and publishes it
+ * through the chunk, and from then on it is never modified. Readers (mesher, save, upload)
+ * hold a VoxelSnapshot for as long as they need it without taking any lock, and an edit never
+ * waits for them; it simply publishes the next version.
+ */
+class VoxelData {
+public:
+    static constexpr size_t VOLUME = static_cast<size_t>(CHUNK_SIZE_X) * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+
+    VoxelData() : voxels_(VOLUME) {}
+
+    static size_t index(int x, int y, int z) {
+        return (static_cast<size_t>(x) * CHUNK_SIZE_Y + static_cast<size_t>(y)) * CHUNK_SIZE_Z + static_cast<size_t>(z);
+    }
+
+    const BlockInfo& at(int x, int y, int z) const { return voxels_[index(x, y, z)]; }
+    const BlockInfo& atIndex(size_t i) const { return voxels_[i]; }
+    // Writable access, only for a version that has not been published yet
+    BlockInfo& at(int x, int y, int z) { return voxels_[index(x, y, z)]; }
+
+    // Incremented by the chunk on every publish, so a reader can tell which edit it saw
+    uint64_t getVersion() const { return version_; }
+    void setVersion(uint64_t version) { version_ = version; }
+
+    // Block-presence summary: every distinct type in the version, sorted. Rebuilt by the chunk
+    // when it publishes, so lookups such as "which chunks use block N" never scan voxels.
+    const std::vector<uint16_t>& palette() const { return palette_; }
+    void rebuildPalette();
+    bool containsType(uint16_t type) const;
+
+    size_t memoryBytes() const {
+        return sizeof(VoxelData) + voxels_.capacity() * sizeof(BlockInfo) + palette_.capacity() * sizeof(uint16_t);
+    }
+
+private:
+    std::vector<BlockInfo> voxels_;
+    std::vector<uint16_t> palette_;
+    uint64_t version_ = 0;
+};
+
+using VoxelSnapshot = std::shared_ptr<const VoxelData>;
+
+/**
+ * Light of one chunk: a byte per voxel in VoxelData order, with sky light (0-15) in the high
+ * nibble and block light in the low nibble, so the packed byte is also the value the mesher
+ * bakes into vertices. Versions are copy-on-write like VoxelData: the light engine fills a
+ * copy and publishes it through the chunk.
+ */
+struct LightData {
+    static constexpr uint8_t MAX_LEVEL = 15;
+
+    std::array<uint8_t, VoxelData::VOLUME> values{};
+
+    uint8_t sky(size_t i) const { return values[i] >> 4; }
+    uint8_t block(size_t i) const { return values[i] & 0x0F; }
+};
+
+using LightSnapshot = std::shared_ptr<const LightData>;
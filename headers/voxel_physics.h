@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "voxel_data.h"            // VoxelSnapshot and chunk dimensions
+#include "voxel_data.h" // IVec3Hash
+
+/**
+ * Solid-block occupancy of a chunk grid for collision. Chunks are looked up at most once per
+ * tick and kept with a flag saying whether their palette holds any solid type, so a body in
+ * open air or among non-solid blocks (water, plants) never reads voxels. A block is solid when
+ * BlockRegistry::isBlockSolid says so.
+ *
+ * Not thread-safe: one collider per thread. Positions are in world space; the grid's chunk
+ * (0, 0, 0) starts at gridOrigin.
+ */
+class VoxelCollider {
+public:
+    // Voxel version of the chunk at a key, or null if it is not loaded
+    using ChunkLookup = std::function<VoxelSnapshot(const glm::ivec3& chunkKey)>;
+
+    // unloadedIsSolid: chunks without voxel data block movement, so bodies never fall through
+    // terrain that has not streamed in
+    VoxelCollider(const glm::vec3& gridOrigin, ChunkLookup lookup, bool unloadedIsSolid = true);
+
+    // Drop the cached chunk versions so edits made since the last tick are seen
+    void beginTick();
+
+    // Block coordinates in the grid
+    bool isSolid(const glm::ivec3& block);
+
+    // How far the box [boxMin, boxMax] can move by delta along one axis (0 = x) before touching a
+    // solid block. The sweep walks every block layer the leading face crosses, so a fast body
+    // cannot tunnel through a thin wall. Returns delta when nothing is in the way.
+    float sweep(const glm::vec3& boxMin, const glm::vec3& boxMax, int axis, float delta);
+
+    // Whether any solid block overlaps the box (touching faces do not count)
+    bool overlaps(const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+    const glm::vec3& getGridOrigin() const { return gridOrigin_; }
+
+private:
+    struct ChunkOccupancy {
+        VoxelSnapshot voxels;
+        bool hasSolid = false; // Palette holds a solid type; false means every block is passable
+    };
+
+    const ChunkOccupancy& chunkAt(const glm::ivec3& chunkKey);
+    // Any solid block in the layer at `layer` along axis, over blocks [u0, u1] x [v0, v1] of the other two axes
+    bool layerBlocked(int axis, int layer, int u0, int u1, int v0, int v1);
+
+    glm::vec3 gridOrigin_;
+    ChunkLookup lookup_;
+    bool unloadedIsSolid_;
+    std::unordered_map<glm::ivec3, ChunkOccupancy, IVec3Hash> chunks_;
+    // Most bodies test many blocks of the same chunk in a row
+    glm::ivec3 lastKey_{0};
+    const ChunkOccupancy* last_ = nullptr;
+};
+
+// An axis-aligned box moved by VoxelPhysics (a player, mob or item)
+struct PhysicsBody {
+    glm::vec3 position{0.0f};              // Centre of the box, world space
+    glm::vec3 halfExtents{0.3f, 0.9f, 0.3f};
+    glm::vec3 velocity{0.0f};              // Blocks per second
+    bool onGround = false;                 // The last step was stopped by a block below (along gravity)
+};
+
+struct PhysicsSettings {
+    float gravity = 20.0f;                 // Blocks per second squared
+    float terminalVelocity = 60.0f;        // Per axis, blocks per second
+    std::optional<glm::vec3> planetCenter; // Gravity pulls toward it; -Y when unset
+};
+
+/**
+ * Swept-AABB movement against voxel occupancy. Each step adds gravity, then moves a body one
+ * axis at a time (the axis gravity mostly acts along first) with VoxelCollider::sweep, stopping
+ * it against the first solid block and zeroing that velocity component. Bodies do not collide
+ * with each other.
+ */
+class VoxelPhysics {
+public:
+    static void step(VoxelCollider& collider, std::vector<PhysicsBody>& bodies, float deltaTime, const PhysicsSettings& settings);
+};
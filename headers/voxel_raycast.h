@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include "voxel_data.h" // VoxelSnapshot and chunk dimensions
+
+class Planet;
+
+// Which blocks stop a ray
+enum class RaycastFilter : uint8_t {
+    ANY_BLOCK, // Every non-air block (picking)
+    SOLID,     // BlockRegistry::isBlockSolid (collision, AI)
+    OPAQUE     // BlockRegistry::isBlockOpaque (line of sight)
+};
+
+struct RaycastHit {
+    bool hit = false;
+    uint16_t blockType = 0;
+    glm::ivec3 block{0};        // Block coordinates in the grid of the planet that was hit
+    glm::vec3 blockCenter{0.0f}; // World position of the block's centre; blockCenter + normal is the block in front of the face
+    glm::ivec3 normal{0};       // Outward normal of the face the ray entered through; zero if the ray starts inside the block
+    float distance = 0.0f;      // From the origin to the entry point, along the normalized direction
+    const Planet* planet = nullptr;
+};
+
+/**
+ * Amanatides-Woo voxel traversal over a grid of chunks. The ray visits every block it passes
+ * through in order, one axis step at a time. It tracks the chunk it is in and the block's local
+ * coordinates incrementally, so the chunk lookup (and the shared_ptr copy of the chunk's voxel
+ * version) happens once per chunk entered. Each step is then a plain array read with no lock or
+ * hash lookup.
+ *
+ * Chunks without voxel data (missing, still generating) are treated as empty. A chunk whose
+ * palette holds no type that passes the filter is crossed without reading it.
+ */
+class VoxelRaycaster {
+public:
+    // Voxel version of the chunk at a key, or null; called once per chunk the ray enters
+    using ChunkLookup = std::function<VoxelSnapshot(const glm::ivec3& chunkKey)>;
+
+    // Cast in a grid whose chunk (0, 0, 0) starts at gridOrigin. Sets hit.block, blockType,
+    // normal and distance; the caller fills blockCenter and planet. A non-finite origin,
+    // direction or maxDistance returns no hit.
+    static RaycastHit cast(const glm::vec3& gridOrigin, const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                           RaycastFilter filter, const ChunkLookup& lookup);
+};
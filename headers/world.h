@@ -14,26 +14,45 @@
 #include "camera.h"
 #include "block.h"
 #include "planet.h"
+#include "chunk_pipeline_metrics.h"
+#include "streaming_budget.h"
 #include <string>
 #include <chrono>
 
 // Enhanced thread pool for chunk operations
 class ChunkThreadPool {
 public:
-    ChunkThreadPool(size_t numThreads);
+    ChunkThreadPool(size_t numThreads, const std::string& name = "ChunkWorker");
     ~ChunkThreadPool();
     
     void enqueueTask(std::function<void()> task);
     void shutdown();
+    size_t getQueuedTaskCount();
+    // Block until the queue is empty and no worker is running a task. Only meaningful while
+    // no other thread enqueues (the World enqueues from the main thread only).
+    void waitIdle();
     
 private:
     std::vector<std::thread> workers_;
     std::queue<std::function<void()>> tasks_;
     std::mutex queueMutex_;
     std::condition_variable condition_;
+    std::condition_variable idleCondition_;
+    size_t activeTasks_ = 0; // Tasks taken from the queue and still running (guarded by queueMutex_)
     std::atomic<bool> stop_;
+    std::string name_;
     
-    void workerFunction();
+    void workerFunction(size_t workerIndex);
+};
+
+// Predictive streaming: bias chunk priority toward where the camera is heading
+struct StreamingPrefetchSettings {
+    bool enabled = true;
+    float lookaheadSeconds = 2.0f;       // Predict the camera position this far ahead
+    float maxLookaheadChunks = 24.0f;    // Cap on the predicted offset (guards against teleports)
+    int prefetchRadiusChunks = 6;        // Radius of the region streamed around the predicted position
+    float facingBias = 0.35f;            // 0..1, how strongly chunks in front of the camera are preferred
+    float lookaheadPenaltyChunks = 2.0f; // Chunks needed only by the prediction rank this much farther away
 };
 
 class World {
@@ -43,11 +62,58 @@ public:
     ~World();
 
     void addPlanet(const glm::vec3& position, float radius, int seed, const std::string& name);
-    void update(const Camera& camera);
+    // deltaTime drives the camera velocity estimate; <= 0 measures wall-clock time instead
+    void update(const Camera& camera, float deltaTime = 0.0f);
     void render(const glm::mat4& projection, const glm::mat4& view, const Camera& camera, bool wireframeState);
 
     // getBlockAtWorldPos will now iterate through planets
     std::shared_ptr<Block> getBlockAtWorldPos(const glm::vec3& worldPos) const;
+    // Nearest block passing filter along a ray, across every planet the ray passes near, within
+    // maxDistance of origin (which may be infinite: each planet's walk ends where the ray leaves
+    // its bounds). Main thread. For picking, line of sight and AI queries; it reads voxel
+    // versions directly instead of making a getBlockAtWorldPos lookup per block.
+    RaycastHit raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                       RaycastFilter filter = RaycastFilter::ANY_BLOCK) const;
+    // Block IDs of every block overlapping the world-space box [worldMin, worldMax], for
+    // collision, explosions and AI sensing. The box is resolved in the grid of the first planet
+    // whose bounds it touches (Planet::queryBlocks); blocks is resized to the box and region says
+    // how to index it. Blocks of unloaded chunks, or of a box that touches no planet, read as
+    // unloadedFill. Returns how many blocks did. Main thread.
+    size_t queryBlocks(const glm::vec3& worldMin, const glm::vec3& worldMax, std::vector<uint16_t>& blocks,
+                       BlockQueryRegion& region, uint16_t unloadedFill = 0) const;
+    // queryBlocks over the sphere's bounding box (the return value counts the whole box); blocks
+    // whose centre is outside the sphere read as air
+    size_t queryBlocksInSphere(const glm::vec3& center, float radius, std::vector<uint16_t>& blocks,
+                               BlockQueryRegion& region, uint16_t unloadedFill = 0) const;
+    // Planet whose bounds hold worldPos (the same test as getBlockAtWorldPos), or null. Entity
+    // physics steps a Planet::makeCollider of the planet its bodies are on.
+    std::shared_ptr<Planet> getPlanetAt(const glm::vec3& worldPos) const;
+    // Single-block edit (0 = air) in whichever planet has the chunk loaded. The re-mesh happens
+    // on the main thread at the start of the next update, before that frame renders.
+    bool setBlockAtWorldPos(const glm::vec3& worldPos, uint16_t blockType);
+    // Bulk edits for tools and gameplay (main thread). Each resolves in the grid of the first
+    // planet the shape touches, like queryBlocks, and goes through Planet::editBlocks: every
+    // loaded chunk it covers is written as one voxel version, and each changed chunk (plus the
+    // facing border sections of its neighbours) is re-meshed once by the next update. Blocks of
+    // unloaded chunks are skipped. Each returns the number of blocks changed.
+    // Every block overlapping the box becomes blockType (0 = air)
+    size_t fillBox(const glm::vec3& worldMin, const glm::vec3& worldMax, uint16_t blockType);
+    // Every block whose centre is inside the sphere becomes blockType
+    size_t fillSphere(const glm::vec3& center, float radius, uint16_t blockType);
+    // Blocks of fromType overlapping the box become toType
+    size_t replaceBlocks(const glm::vec3& worldMin, const glm::vec3& worldMax, uint16_t fromType, uint16_t toType);
+    // Blast that clears blocks whose centre is inside the sphere. power is the blast resistance it
+    // overcomes at the centre, falling linearly to 0 at radius; blocks with negative hardness
+    // (bedrock) never break.
+    size_t explode(const glm::vec3& center, float radius, float power = 100.0f);
+    // Apply pending edit re-meshes now instead of waiting for update
+    void rebuildEditedChunks();
+    // Hot reload of block definitions (main thread). Waits for the chunk workers to go idle,
+    // reloads the registry, runs rebuildTextures (the game rebuilds its atlas texture there;
+    // null keeps the current atlas), then re-meshes only the chunks that use a block whose faces
+    // changed, and relights the voxels of blocks whose opacity or light level changed (the light
+    // batch re-meshes what it changes). Returns the number of chunks marked.
+    size_t reloadBlockDefinitions(const std::string& blocksDirectory, const std::function<void()>& rebuildTextures = nullptr);
 
     // World information
     const std::string& getWorldName() const { return worldName_; }
@@ -71,8 +137,28 @@ public:
     // Legacy support for existing code
     void addTaskToWorker(const std::function<void()>& task) { addChunkGenerationTask(task); }
 
+    // Chunk pipeline latency metrics (per-stage histograms, recorded as chunks become renderable)
+    ChunkPipelineMetrics& getPipelineMetrics() { return pipelineMetrics_; }
+    const ChunkPipelineMetrics& getPipelineMetrics() const { return pipelineMetrics_; }
+    bool dumpPerformanceMetrics(const std::string& path) const;
+    // Snapshot of the generation/mesh/main-thread queue depths
+    PipelineBacklog getPipelineBacklog();
+
+    // Predictive prefetch configuration and the smoothed camera velocity it uses (blocks/s)
+    StreamingPrefetchSettings& getPrefetchSettings() { return prefetchSettings_; }
+    const StreamingPrefetchSettings& getPrefetchSettings() const { return prefetchSettings_; }
+    glm::vec3 getCameraVelocity() const { return cameraVelocity_; }
+
+    // Adaptive render distance / per-frame admission limit. Call recordFrameTime once per frame
+    // with the frame's CPU time (excluding the vsync wait) so the controller can steer toward its target.
+    StreamingBudgetController& getStreamingBudget() { return streamingBudget_; }
+    const StreamingBudgetController& getStreamingBudget() const { return streamingBudget_; }
+    void recordFrameTime(double frameMs);
+
 private:
     std::vector<std::shared_ptr<Planet>> planets_;
+    // First planet whose bounds the box touches (queries and bulk edits), or null
+    std::shared_ptr<Planet> planetTouchingBox(const glm::vec3& worldMin, const glm::vec3& worldMax) const;
     std::string worldName_;
     std::string worldDataPath_;
     int defaultSeed_;
@@ -89,7 +175,18 @@ private:
     std::atomic<int> chunksGeneratedThisSecond_;
     std::atomic<int> meshesBuiltThisSecond_;
     std::chrono::steady_clock::time_point lastPerformanceReport_;
+    ChunkPipelineMetrics pipelineMetrics_;
+
+    // Camera motion tracking for predictive prefetch
+    StreamingPrefetchSettings prefetchSettings_;
+    glm::vec3 cameraVelocity_{0.0f};
+    glm::vec3 lastCameraPosition_{0.0f};
+    bool hasCameraSample_ = false;
+    std::chrono::steady_clock::time_point lastCameraSampleTime_;
+
+    StreamingBudgetController streamingBudget_;
     
     void createWorldDirectories();
+    void updateCameraVelocity(const glm::vec3& cameraPosition, float deltaTime);
     void reportPerformanceMetrics();
 }; 
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <cstdlib> // For system
 #include <iomanip> // For std::setprecision
+#include <sstream>
+#include <chrono>
+#include <string>
 
 #include "headers/window.h"
 #include "headers/shader.h"
@@ -13,9 +16,15 @@
 #include "headers/camera.h"
 #include "headers/block.h"
 #include "headers/block_registry.h"
+#include "headers/block_definition_watcher.h"
 #include "headers/world.h"
 #include "headers/planet.h"
 #include "headers/crosshair.h"
+#include "headers/profiler.h"
+#include "headers/logger.h"
+#include "headers/gl_render_backend.h"
+#include "headers/camera_path.h"
+#include "headers/replay_report.h"
 
 // Screen dimensions (can be const or from config)
 const unsigned int SCREEN_WIDTH = 1280;
@@ -30,28 +39,60 @@ Crosshair* crosshair = nullptr;
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 
-int main() {
+// Camera path replay runs at a fixed timestep so runs are comparable across builds
+const double REPLAY_TIMESTEP = 1.0 / 60.0;
+
+int main(int argc, char** argv) {
+    // Command line: --replay <path> plays a recorded camera path and exits,
+    // --record <path> sets where F10 saves recordings, --replay-report <path> sets the report output,
+    // --prefetch-lookahead <seconds> sets how far ahead chunk streaming predicts the camera (0 disables),
+    // --frame-budget <ms> sets the frame time the adaptive render distance steers toward (0 keeps it fixed)
+    std::string replayFile;
+    float prefetchLookahead = -1.0f; // < 0 keeps the World default
+    double frameBudgetMs = -1.0;     // < 0 keeps the World default
+    std::string recordPath = "camera_path.txt";
+    std::string replayReportPath = "replay_report.json";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--replay" && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay-report" && i + 1 < argc) {
+            replayReportPath = argv[++i];
+        } else if (arg == "--prefetch-lookahead" && i + 1 < argc) {
+            prefetchLookahead = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--frame-budget" && i + 1 < argc) {
+            frameBudgetMs = std::atof(argv[++i]);
+        } else {
+            AZV_LOG_WARN(General) << "Ignoring unknown argument: " << arg;
+        }
+    }
+
     // Initialize GLFW
     if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to initialize GLFW";
         return -1;
     }
 
     // Create Window object
     Window gameWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "AzureVoxel - Planets");
     if (!gameWindow.getWindow()) { // Check if window creation failed inside Window constructor
-        std::cerr << "Failed to create GLFW window or initialize GLEW." << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to create GLFW window or initialize GLEW.";
         glfwTerminate();
         return -1;
     }
 
     // Initialize GLEW (must be done after a valid GL context is created)
     if (glewInit() != GLEW_OK) {
-        std::cerr << "Failed to initialize GLEW" << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to initialize GLEW";
         glfwTerminate(); // Terminate GLFW if GLEW init fails
         return -1;
     }
 
+    // Chunk uploads and draws go through the OpenGL backend from here on
+    RenderBackend::setInstance(std::make_unique<GLRenderBackend>());
+
     // Enable mouse capture for FPS camera
     gameWindow.enableMouseCapture(true);
 
@@ -59,9 +100,9 @@ int main() {
     // ...
 
     // Initialize Block Registry System
-    std::cout << "Initializing Block Registry System..." << std::endl;
+    AZV_LOG_INFO(General) << "Initializing Block Registry System...";
     if (!BlockRegistry::getInstance().initialize("res/blocks/")) {
-        std::cerr << "Failed to initialize Block Registry. Continuing with defaults..." << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to initialize Block Registry. Continuing with defaults...";
     }
     
     // Print registry statistics for debugging
@@ -70,14 +111,14 @@ int main() {
     // Initialize Shaders and Textures for Blocks (globally)
     Block::InitBlockShader();
     if (Block::shaderProgram == 0) {
-        std::cerr << "Failed to initialize block shader program. Exiting." << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to initialize block shader program. Exiting.";
         BlockRegistry::getInstance().shutdown();
         glfwTerminate();
         return -1;
     }
     Block::InitSpritesheet("res/textures/Spritesheet.PNG");
     if (!Block::spritesheetLoaded) {
-        std::cout << "Warning: Global spritesheet res/textures/Spritesheet.PNG not loaded. Blocks may not texture correctly." << std::endl;
+        AZV_LOG_WARN(General) << "Warning: Global spritesheet res/textures/Spritesheet.PNG not loaded. Blocks may not texture correctly.";
     }
 
     // OpenGL settings
@@ -91,6 +132,18 @@ int main() {
 
     // Create World
     world = new World("SolarSystem"); // Give your world a name
+    if (prefetchLookahead >= 0.0f) {
+        world->getPrefetchSettings().lookaheadSeconds = prefetchLookahead;
+        world->getPrefetchSettings().enabled = prefetchLookahead > 0.0f;
+    }
+    if (frameBudgetMs >= 0.0) {
+        StreamingBudgetSettings budget = world->getStreamingBudget().getSettings();
+        budget.enabled = frameBudgetMs > 0.0;
+        if (frameBudgetMs > 0.0) {
+            budget.targetFrameMs = frameBudgetMs;
+        }
+        world->getStreamingBudget().setSettings(budget);
+    }
 
     // Add a planet to the world
     world->addPlanet(glm::vec3(0.0f, 0.0f, 0.0f), 150.0f, 123, "Terra"); // Planet at origin, radius 5000 (10k blocks diameter)
@@ -99,16 +152,44 @@ int main() {
     // Create Crosshair
     crosshair = new Crosshair(SCREEN_WIDTH, SCREEN_HEIGHT);
 
+    // Editing a file in res/blocks/ reloads the definitions and re-meshes the chunks that use them
+    BlockDefinitionWatcher blockDefinitionWatcher("res/blocks/");
+
     // Performance metrics
     double lastTime = glfwGetTime();
     int nbFrames = 0;
+    AZV_PROFILE_THREAD_NAME("Main");
+    bool profilerKeyWasDown = false;
+
+    // Camera path recording (F10) and replay
+    CameraPath recordedPath;
+    bool recording = false;
+    bool recordKeyWasDown = false;
+    double recordStartTime = 0.0;
+
+    CameraPath replayPath;
+    ReplayReport replayReport;
+    bool replaying = false;
+    long long replayFrame = 0;
+    if (!replayFile.empty()) {
+        replaying = replayPath.loadFromFile(replayFile) && !replayPath.empty();
+        if (!replaying) {
+            AZV_LOG_ERROR(General) << "Camera path replay disabled: could not load " << replayFile;
+        }
+    }
 
     // Main game loop
     while (!gameWindow.shouldClose()) {
+        AZV_PROFILE_ZONE("Frame");
+        auto frameStart = std::chrono::steady_clock::now();
         // Per-frame time logic
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
+        double replayTime = static_cast<double>(replayFrame) * REPLAY_TIMESTEP;
+        if (replaying) {
+            deltaTime = static_cast<float>(REPLAY_TIMESTEP);
+        }
 
         // Performance monitoring (FPS)
         nbFrames++;
@@ -121,17 +202,61 @@ int main() {
             lastTime += 1.0;
         }
 
+        // F9 starts a profiler capture; pressing it again writes the trace to profile_trace.json
+        bool profilerKeyDown = gameWindow.isKeyPressed(GLFW_KEY_F9);
+        if (profilerKeyDown && !profilerKeyWasDown) {
+#ifdef AZUREVOXEL_PROFILER
+            if (!Profiler::isEnabled()) {
+                Profiler::setEnabled(true);
+                AZV_LOG_INFO(General) << "Profiler capture started (press F9 again to save)";
+            } else {
+                Profiler::setEnabled(false);
+                Profiler::writeChromeTrace("profile_trace.json");
+            }
+#else
+            AZV_LOG_INFO(General) << "Profiler is compiled out; reconfigure with -DAZUREVOXEL_PROFILER=ON";
+#endif
+        }
+        profilerKeyWasDown = profilerKeyDown;
+
+        // F10 starts recording the camera path; pressing it again saves it
+        bool recordKeyDown = gameWindow.isKeyPressed(GLFW_KEY_F10);
+        if (recordKeyDown && !recordKeyWasDown && !replaying) {
+            if (!recording) {
+                recordedPath.clear();
+                recordStartTime = glfwGetTime();
+                recording = true;
+                AZV_LOG_INFO(General) << "Camera path recording started (press F10 again to save to " << recordPath << ")";
+            } else {
+                recording = false;
+                recordedPath.saveToFile(recordPath);
+            }
+        }
+        recordKeyWasDown = recordKeyDown;
+
         // Process input (Keyboard for camera, window events)
-        camera->processKeyboard(gameWindow.getWindow(), deltaTime);
-        // Mouse input is handled by callback in Window class, which updates camera via getMouseOffset
         double xOffset, yOffset;
         gameWindow.getMouseOffset(xOffset, yOffset); // This gets and resets offsets
-        camera->processMouseMovement(static_cast<float>(xOffset), static_cast<float>(yOffset));
+        if (replaying) {
+            replayPath.applyTo(*camera, replayTime);
+        } else {
+            camera->processKeyboard(gameWindow.getWindow(), deltaTime);
+            // Mouse input is handled by callback in Window class, which updates camera via getMouseOffset
+            camera->processMouseMovement(static_cast<float>(xOffset), static_cast<float>(yOffset));
+        }
+        if (recording) {
+            recordedPath.record(glfwGetTime() - recordStartTime, *camera);
+        }
         // gameWindow.resetMouseOffset(); // Ensure offsets are reset if not done in getMouseOffset
 
         // Update game state
         if (world) {
-            world->update(*camera);
+            AZV_PROFILE_ZONE("Update");
+            if (blockDefinitionWatcher.poll()) {
+                world->reloadBlockDefinitions(blockDefinitionWatcher.getDirectory(),
+                                              [] { Block::ReloadSpritesheet("res/textures/Spritesheet.PNG"); });
+            }
+            world->update(*camera, deltaTime);
             world->processMainThreadTasks(); // Process tasks queued by worker threads for main thread (e.g. OpenGL calls)
         }
         // crosshair->updateScreenSize(newWidth, newHeight); // If window resizing is handled
@@ -146,6 +271,7 @@ int main() {
 
         // Render world (which renders planets, which render chunks)
         if (world) {
+            AZV_PROFILE_ZONE("Render");
             world->render(projection, view, *camera, gameWindow.isWireframeMode());
         }
 
@@ -154,20 +280,61 @@ int main() {
             crosshair->render();
         }
 
+        // Feed the streaming budget the frame's CPU time; the vsync wait in swapBuffers is not load
+        if (world) {
+            world->recordFrameTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+        }
+
         // Swap buffers and poll IO events
+        AZV_PROFILE_ZONE("SwapBuffers");
         gameWindow.swapBuffers();
         glfwPollEvents();
+
+        if (replaying) {
+            ReplayReport::Frame frame;
+            frame.simTime = replayTime;
+            frame.frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            frame.chunksStreamed = world ? world->getPipelineMetrics().completedChunks() : 0;
+            frame.backlog = world ? world->getPipelineBacklog() : PipelineBacklog();
+            replayReport.recordFrame(frame);
+            ++replayFrame;
+            if (replayTime >= replayPath.duration()) {
+                glfwSetWindowShouldClose(gameWindow.getWindow(), GLFW_TRUE);
+            }
+        }
     }
 
     // Cleanup
-    std::cout << "Cleaning up resources..." << std::endl;
+    AZV_LOG_INFO(General) << "Cleaning up resources...";
+    if (recording) {
+        recordedPath.saveToFile(recordPath);
+    }
+    if (replayReport.frameCount() > 0) {
+        std::ostringstream report;
+        replayReport.printReport(report);
+        AZV_LOG_INFO(General) << report.str();
+        replayReport.writeJSONFile(replayReportPath);
+    }
+    if (Profiler::isEnabled()) {
+        Profiler::setEnabled(false);
+        Profiler::writeChromeTrace("profile_trace.json");
+    }
+    if (world) {
+        std::ostringstream report;
+        world->getPipelineMetrics().printReport(report);
+        AZV_LOG_INFO(World) << report.str();
+        world->dumpPerformanceMetrics("pipeline_metrics.json");
+    }
     Block::CleanupBlockShader();
     BlockRegistry::getInstance().shutdown();
     delete crosshair;
     delete world;
     delete camera;
+    // Chunk meshes released above are only queued; free them while the context still exists
+    RenderBackend::getInstance().shutdown();
     // Window destructor handles glfwTerminate()
 
-    std::cout << "AzureVoxel Planet Engine shutdown complete." << std::endl;
+    AZV_LOG_INFO(General) << "AzureVoxel Planet Engine shutdown complete.";
+    Logger::getInstance().shutdown();
     return 0;
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 out vec4 FragColor;
 
 in vec2 TexCoord;
+in float LightLevel; // 0-15, brightest of sky and block light
+in float Occlusion;  // 0 (corner fully occluded) to 3 (open), interpolated across the face
 
 uniform vec3 blockColor;
 uniform sampler2D blockTexture;
@@ -13,7 +15,11 @@ void main() {
         // Make sure texture with alpha is handled correctly
         if(texColor.a < 0.1)
             discard;
-        FragColor = texColor;
+        // Each level is 80% as bright as the next, with a floor so caves are never pitch black
+        float brightness = max(pow(0.8, 15.0 - LightLevel), 0.05);
+        // Ambient occlusion darkens corners tucked against other blocks, down to 55% at the darkest
+        brightness *= 0.55 + 0.15 * Occlusion;
+        FragColor = vec4(texColor.rgb * brightness, texColor.a);
     } else {
         // When no texture is available, use a solid color
         // Different colors for debugging
@@ -1,14 +1,23 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in float aLight; // Light byte (sky level * 16 + block level) + corner occlusion (0-3) * 256
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
 out vec2 TexCoord;
+out float LightLevel;
+out float Occlusion;
 
 void main() {
     gl_Position = projection * view * model * vec4(aPos, 1.0);
     TexCoord = aTexCoord;
-} 
\ No newline at end of file
+    float occlusion = floor(aLight / 256.0);
+    float light = aLight - occlusion * 256.0;
+    float sky = floor(light / 16.0);
+    float block = light - sky * 16.0;
+    LightLevel = max(sky, block);
+    Occlusion = occlusion;
+}
\ No newline at end of file
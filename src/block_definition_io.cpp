@@ -0,0 +1,568 @@
+#include "../headers/block_definition_io.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] = {'A', 'Z', 'V', 'B', 'L', 'K', 'R', 'G'};
+constexpr uint32_t CACHE_VERSION = 2;
+constexpr int MAX_JSON_DEPTH = 64;
+
+// Cursor over a JSON document; every read advances past what it consumed
+class JsonReader {
+public:
+    JsonReader(const char* data, size_t size) : begin_(data), pos_(data), end_(data + size) {}
+
+    bool failed() const { return failed_; }
+    const std::string& error() const { return error_; }
+
+    bool fail(const char* message) {
+        if (!failed_) {
+            failed_ = true;
+            error_ = std::string(message) + " at byte " + std::to_string(pos_ - begin_);
+        }
+        return false;
+    }
+
+    // Next non-whitespace character, or 0 at the end
+    char peek() {
+        while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\n' || *pos_ == '\r')) {
+            ++pos_;
+        }
+        return pos_ < end_ ? *pos_ : '\0';
+    }
+
+    bool consume(char expected) {
+        if (peek() != expected) {
+            return fail((std::string("expected '") + expected + "'").c_str());
+        }
+        ++pos_;
+        return true;
+    }
+
+    // Walks "{ key: value, ... }", calling onMember(key) with the cursor on each value. onMember
+    // must consume the value (or call skipValue).
+    template <typename OnMember>
+    bool readObject(OnMember&& onMember) {
+        if (!consume('{')) return false;
+        if (peek() == '}') {
+            ++pos_;
+            return true;
+        }
+        std::string key;
+        while (!failed_) {
+            if (!readString(key) || !consume(':') || !onMember(key)) return false;
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            return consume('}');
+        }
+        return false;
+    }
+
+    template <typename OnElement>
+    bool readArray(OnElement&& onElement) {
+        if (!consume('[')) return false;
+        if (peek() == ']') {
+            ++pos_;
+            return true;
+        }
+        while (!failed_) {
+            if (!onElement()) return false;
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            return consume(']');
+        }
+        return false;
+    }
+
+    bool readString(std::string& out) {
+        if (!consume('"')) return false;
+        out.clear();
+        while (pos_ < end_ && *pos_ != '"') {
+            char c = *pos_++;
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (pos_ >= end_) break;
+            char escape = *pos_++;
+            switch (escape) {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u':
+                    // Identifiers and texture names are ASCII; keep the text parseable, not exact
+                    if (end_ - pos_ < 4) return fail("truncated \\u escape");
+                    pos_ += 4;
+                    out.push_back('?');
+                    break;
+                default: out.push_back(escape); break; // \" \\ \/
+            }
+        }
+        if (pos_ >= end_) return fail("unterminated string");
+        ++pos_;
+        return true;
+    }
+
+    bool readNumber(double& out) {
+        peek();
+        const char* start = pos_;
+        while (pos_ < end_ && (std::strchr("+-0123456789.eE", *pos_) != nullptr)) {
+            ++pos_;
+        }
+        if (pos_ == start) return fail("expected a number");
+        std::string text(start, pos_);
+        char* parsedEnd = nullptr;
+        out = std::strtod(text.c_str(), &parsedEnd);
+        if (parsedEnd != text.c_str() + text.size()) return fail("malformed number");
+        return true;
+    }
+
+    bool readBool(bool& out) {
+        peek();
+        if (matchLiteral("true")) {
+            out = true;
+            return true;
+        }
+        if (matchLiteral("false")) {
+            out = false;
+            return true;
+        }
+        return fail("expected true or false");
+    }
+
+    bool skipValue(int depth = 0) {
+        if (depth > MAX_JSON_DEPTH) return fail("nesting too deep");
+        std::string ignored;
+        double number = 0.0;
+        switch (peek()) {
+            case '{': return readObject([&](const std::string&) { return skipValue(depth + 1); });
+            case '[': return readArray([&]() { return skipValue(depth + 1); });
+            case '"': return readString(ignored);
+            case 't': case 'f': case 'n':
+                if (matchLiteral("true") || matchLiteral("false") || matchLiteral("null")) return true;
+                return fail("unknown literal");
+            default: return readNumber(number);
+        }
+    }
+
+    // Reads the value if it has the expected JSON type, otherwise skips it (the field keeps its default)
+    bool readStringOrSkip(std::string& out) { return peek() == '"' ? readString(out) : skipValue(); }
+    bool readNumberOrSkip(double& out) {
+        char c = peek();
+        return (c == '-' || (c >= '0' && c <= '9')) ? readNumber(out) : skipValue();
+    }
+    bool readBoolOrSkip(bool& out) {
+        char c = peek();
+        return (c == 't' || c == 'f') ? readBool(out) : skipValue();
+    }
+
+    // { "name": "value", ... }, non-string values ignored
+    bool readStringMap(std::unordered_map<std::string, std::string>& out) {
+        if (peek() != '{') return skipValue();
+        return readObject([&](const std::string& key) {
+            std::string value;
+            if (peek() != '"') return skipValue();
+            if (!readString(value)) return false;
+            out[key] = value;
+            return true;
+        });
+    }
+
+private:
+    const char* begin_;
+    const char* pos_;
+    const char* end_;
+    bool failed_ = false;
+    std::string error_;
+
+    bool matchLiteral(const char* literal) {
+        size_t length = std::strlen(literal);
+        if (static_cast<size_t>(end_ - pos_) < length || std::memcmp(pos_, literal, length) != 0) {
+            return false;
+        }
+        pos_ += length;
+        return true;
+    }
+};
+
+bool readBlockObject(JsonReader& reader, BlockDefinition& def) {
+    def.numeric_id = 0;
+    def.default_texture = "stone";
+    // Numeric fields keep their default when the value is not a number
+    auto readNumberField = [&](auto& field) {
+        double number = static_cast<double>(field);
+        if (!reader.readNumberOrSkip(number)) return false;
+        field = static_cast<std::decay_t<decltype(field)>>(number);
+        return true;
+    };
+    return reader.readObject([&](const std::string& key) {
+        if (key == "id") return reader.readStringOrSkip(def.id);
+        if (key == "display_name") return reader.readStringOrSkip(def.display_name);
+        if (key == "texture") return reader.readStringOrSkip(def.default_texture);
+        if (key == "solid") return reader.readBoolOrSkip(def.solid);
+        if (key == "transparent") return reader.readBoolOrSkip(def.transparent);
+        if (key == "flammable") return reader.readBoolOrSkip(def.flammable);
+        if (key == "numeric_id") return readNumberField(def.numeric_id);
+        if (key == "hardness") return readNumberField(def.hardness);
+        if (key == "blast_resistance") return readNumberField(def.blast_resistance);
+        if (key == "light_emission") return readNumberField(def.light_emission);
+        if (key == "textures") return reader.readStringMap(def.per_face_textures);
+        if (key.compare(0, 8, "texture_") == 0 && key.size() > 8) {
+            std::string texture;
+            if (!reader.readStringOrSkip(texture)) return false;
+            if (!texture.empty()) def.per_face_textures[key.substr(8)] = texture;
+            return true;
+        }
+        if (key == "variants" && reader.peek() == '{') {
+            return reader.readObject([&](const std::string& context) {
+                return reader.readStringMap(def.variants[context]);
+            });
+        }
+        return reader.skipValue();
+    });
+}
+
+} // namespace
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize)) {
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        if (size_ == 0) {
+            valid_ = true; // CreateFileMapping rejects empty files
+        } else if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view) {
+                data_ = static_cast<const char*>(view);
+                valid_ = true;
+            }
+            CloseHandle(mapping); // The view keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+}
+#else
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ == 0) {
+            valid_ = true;
+        } else {
+            void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                data_ = static_cast<const char*>(mapping);
+                valid_ = true;
+            }
+        }
+    }
+    close(fd); // The mapping stays valid without the descriptor
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+#endif
+
+uint64_t hashBlockSource(const char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool parseBlockDefinitionsJSON(const char* data, size_t size, std::vector<BlockDefinition>& definitions, std::string& error) {
+    JsonReader reader(data, size);
+    bool sawBlocks = false;
+    bool ok = reader.readObject([&](const std::string& key) {
+        if (key != "blocks" || reader.peek() != '[') {
+            return reader.skipValue();
+        }
+        sawBlocks = true;
+        return reader.readArray([&]() {
+            if (reader.peek() != '{') return reader.skipValue();
+            BlockDefinition def;
+            if (!readBlockObject(reader, def)) return false;
+            definitions.push_back(std::move(def));
+            return true;
+        });
+    });
+    if (!ok) {
+        error = reader.error();
+        return false;
+    }
+    if (!sawBlocks) {
+        error = "no 'blocks' array";
+        return false;
+    }
+    return true;
+}
+
+// Snapshot layout: Header, then sourceCount Source, blockCount BlockRecord, faceTextureCount
+// FaceTexture and variantCount VariantEntry records, then stringBytes of string pool. Each
+// record array starts on a multiple of its alignment, and the mapping is page-aligned.
+struct BlockRegistryCache::String {
+    uint32_t offset; // Into the string pool
+    uint32_t length;
+};
+
+struct BlockRegistryCache::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t sourceCount;
+    uint32_t blockCount;
+    uint32_t faceTextureCount;
+    uint32_t variantCount;
+    uint32_t stringBytes;
+};
+
+struct BlockRegistryCache::Source {
+    uint64_t hash;
+    String path;
+};
+
+struct BlockRegistryCache::BlockRecord {
+    String id;
+    String displayName;
+    String defaultTexture;
+    uint32_t firstFaceTexture; // Run of FaceTexture records
+    uint32_t faceTextureCount;
+    uint32_t firstVariant;     // Run of VariantEntry records
+    uint32_t variantCount;
+    float hardness;
+    float blastResistance;
+    uint16_t numericId;
+    uint8_t flags;             // BLOCK_SOLID | BLOCK_TRANSPARENT | BLOCK_FLAMMABLE
+    uint8_t lightEmission;
+};
+
+struct BlockRegistryCache::FaceTexture {
+    String face;
+    String texture;
+};
+
+// One (context, key, value) of a block's variants map
+struct BlockRegistryCache::VariantEntry {
+    String context;
+    String key;
+    String value;
+};
+
+namespace {
+
+constexpr uint8_t BLOCK_SOLID = 0x01;
+constexpr uint8_t BLOCK_TRANSPARENT = 0x02;
+constexpr uint8_t BLOCK_FLAMMABLE = 0x04;
+
+static_assert(sizeof(BlockRegistryCache::Header) % alignof(BlockRegistryCache::Source) == 0, "sources must stay aligned");
+static_assert(sizeof(BlockRegistryCache::Source) % alignof(BlockRegistryCache::BlockRecord) == 0, "blocks must stay aligned");
+static_assert(std::is_trivially_copyable_v<BlockRegistryCache::BlockRecord>, "records are read in place");
+
+bool rangeFits(uint64_t first, uint64_t count, uint64_t total) { return first <= total && count <= total - first; }
+
+} // namespace
+
+std::string_view BlockRegistryCache::string(const String& s) const { return std::string_view(strings_ + s.offset, s.length); }
+
+bool BlockRegistryCache::open(const std::string& path, const std::vector<BlockSourceHash>& sources) {
+    file_.reset();
+    blockCount_ = 0;
+    auto file = std::make_unique<MappedFile>(path);
+    if (!*file || file->size() < sizeof(Header)) {
+        return false;
+    }
+    const Header& header = *reinterpret_cast<const Header*>(file->data());
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        header.sourceCount != sources.size()) {
+        return false;
+    }
+    // Every size is 32-bit, so the 64-bit sum cannot overflow
+    const uint64_t sourcesAt = sizeof(Header);
+    const uint64_t blocksAt = sourcesAt + uint64_t(header.sourceCount) * sizeof(Source);
+    const uint64_t facesAt = blocksAt + uint64_t(header.blockCount) * sizeof(BlockRecord);
+    const uint64_t variantsAt = facesAt + uint64_t(header.faceTextureCount) * sizeof(FaceTexture);
+    const uint64_t stringsAt = variantsAt + uint64_t(header.variantCount) * sizeof(VariantEntry);
+    if (stringsAt + header.stringBytes != file->size()) {
+        return false;
+    }
+    const char* base = file->data();
+    strings_ = base + stringsAt;
+    auto stringFits = [&](const String& s) { return rangeFits(s.offset, s.length, header.stringBytes); };
+
+    const Source* cachedSources = reinterpret_cast<const Source*>(base + sourcesAt);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (!stringFits(cachedSources[i].path) || cachedSources[i].hash != sources[i].hash ||
+            string(cachedSources[i].path) != sources[i].path) {
+            return false;
+        }
+    }
+    const BlockRecord* blocks = reinterpret_cast<const BlockRecord*>(base + blocksAt);
+    const FaceTexture* faceTextures = reinterpret_cast<const FaceTexture*>(base + facesAt);
+    const VariantEntry* variants = reinterpret_cast<const VariantEntry*>(base + variantsAt);
+    for (uint32_t i = 0; i < header.blockCount; ++i) {
+        const BlockRecord& block = blocks[i];
+        if (!stringFits(block.id) || !stringFits(block.displayName) || !stringFits(block.defaultTexture) ||
+            !rangeFits(block.firstFaceTexture, block.faceTextureCount, header.faceTextureCount) ||
+            !rangeFits(block.firstVariant, block.variantCount, header.variantCount)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.faceTextureCount; ++i) {
+        if (!stringFits(faceTextures[i].face) || !stringFits(faceTextures[i].texture)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.variantCount; ++i) {
+        if (!stringFits(variants[i].context) || !stringFits(variants[i].key) || !stringFits(variants[i].value)) {
+            return false;
+        }
+    }
+
+    blocks_ = blocks;
+    faceTextures_ = faceTextures;
+    variants_ = variants;
+    blockCount_ = header.blockCount;
+    file_ = std::move(file);
+    return true;
+}
+
+BlockDefinition BlockRegistryCache::definition(size_t i) const {
+    const BlockRecord& block = blocks_[i];
+    BlockDefinition def(std::string(string(block.id)), block.numericId, std::string(string(block.displayName)));
+    def.solid = (block.flags & BLOCK_SOLID) != 0;
+    def.transparent = (block.flags & BLOCK_TRANSPARENT) != 0;
+    def.flammable = (block.flags & BLOCK_FLAMMABLE) != 0;
+    def.light_emission = block.lightEmission;
+    def.hardness = block.hardness;
+    def.blast_resistance = block.blastResistance;
+    def.default_texture = string(block.defaultTexture);
+    for (uint32_t f = 0; f < block.faceTextureCount; ++f) {
+        const FaceTexture& entry = faceTextures_[block.firstFaceTexture + f];
+        def.per_face_textures.emplace(string(entry.face), string(entry.texture));
+    }
+    for (uint32_t v = 0; v < block.variantCount; ++v) {
+        const VariantEntry& entry = variants_[block.firstVariant + v];
+        def.variants[std::string(string(entry.context))].emplace(string(entry.key), string(entry.value));
+    }
+    return def;
+}
+
+bool BlockRegistryCache::write(const std::string& path, const std::vector<BlockSourceHash>& sources,
+                               const std::vector<BlockDefinition>& definitions) {
+    std::string pool;
+    auto addString = [&](const std::string& s) {
+        String ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(s.size())};
+        pool.append(s);
+        return ref;
+    };
+    std::vector<Source> cachedSources;
+    for (const BlockSourceHash& source : sources) {
+        cachedSources.push_back(Source{source.hash, addString(source.path)});
+    }
+    std::vector<BlockRecord> blocks;
+    std::vector<FaceTexture> faceTextures;
+    std::vector<VariantEntry> variants;
+    for (const BlockDefinition& def : definitions) {
+        BlockRecord block{};
+        block.id = addString(def.id);
+        block.displayName = addString(def.display_name);
+        block.defaultTexture = addString(def.default_texture);
+        block.firstFaceTexture = static_cast<uint32_t>(faceTextures.size());
+        for (const auto& [face, texture] : def.per_face_textures) {
+            faceTextures.push_back(FaceTexture{addString(face), addString(texture)});
+        }
+        block.faceTextureCount = static_cast<uint32_t>(faceTextures.size()) - block.firstFaceTexture;
+        block.firstVariant = static_cast<uint32_t>(variants.size());
+        for (const auto& [context, overrides] : def.variants) {
+            for (const auto& [key, value] : overrides) {
+                variants.push_back(VariantEntry{addString(context), addString(key), addString(value)});
+            }
+        }
+        block.variantCount = static_cast<uint32_t>(variants.size()) - block.firstVariant;
+        block.hardness = def.hardness;
+        block.blastResistance = def.blast_resistance;
+        block.numericId = def.numeric_id;
+        block.flags = (def.solid ? BLOCK_SOLID : 0) | (def.transparent ? BLOCK_TRANSPARENT : 0) | (def.flammable ? BLOCK_FLAMMABLE : 0);
+        block.lightEmission = def.light_emission;
+        blocks.push_back(block);
+    }
+    if (pool.size() > UINT32_MAX) {
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.sourceCount = static_cast<uint32_t>(cachedSources.size());
+    header.blockCount = static_cast<uint32_t>(blocks.size());
+    header.faceTextureCount = static_cast<uint32_t>(faceTextures.size());
+    header.variantCount = static_cast<uint32_t>(variants.size());
+    header.stringBytes = static_cast<uint32_t>(pool.size());
+
+    // Replace in one step, so a crash mid-write never leaves a truncated snapshot behind
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        auto writeRecords = [&](const auto& records) {
+            out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(records[0])));
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeRecords(cachedSources);
+        writeRecords(blocks);
+        writeRecords(faceTextures);
+        writeRecords(variants);
+        out.write(pool.data(), static_cast<std::streamsize>(pool.size()));
+        if (!out) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    return !error;
+}
@@ -0,0 +1,56 @@
+#include "../headers/block_definition_watcher.h"
+#include "../headers/logger.h"
+#include <algorithm>
+#include <filesystem>
+
+BlockDefinitionWatcher::BlockDefinitionWatcher(const std::string& directory, std::chrono::milliseconds interval,
+                                               const std::string& extension)
+    : directory_(directory), extension_(extension), interval_(interval) {
+    reset();
+}
+
+void BlockDefinitionWatcher::reset() {
+    stamps_ = scan();
+    pending_ = false;
+    lastScan_ = std::chrono::steady_clock::now();
+}
+
+bool BlockDefinitionWatcher::poll() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastScan_ < interval_) {
+        return false;
+    }
+    lastScan_ = now;
+
+    std::vector<FileStamp> current = scan();
+    if (current != stamps_) {
+        // Still being written (or just changed); wait for one quiet interval
+        stamps_ = std::move(current);
+        pending_ = true;
+        return false;
+    }
+    if (!pending_) {
+        return false;
+    }
+    pending_ = false;
+    AZV_LOG_INFO(Registry) << "Block definitions in " << directory_ << " changed (" << stamps_.size() << " files)";
+    return true;
+}
+
+std::vector<BlockDefinitionWatcher::FileStamp> BlockDefinitionWatcher::scan() const {
+    std::vector<FileStamp> stamps;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory_, error), end; !error && it != end; it.increment(error)) {
+        const std::filesystem::path& path = it->path();
+        if (path.extension() != extension_ || !it->is_regular_file(error)) {
+            continue;
+        }
+        FileStamp stamp;
+        stamp.path = path.string();
+        stamp.size = static_cast<uint64_t>(it->file_size(error));
+        stamp.modified = static_cast<int64_t>(it->last_write_time(error).time_since_epoch().count());
+        stamps.push_back(std::move(stamp));
+    }
+    std::sort(stamps.begin(), stamps.end(), [](const FileStamp& a, const FileStamp& b) { return a.path < b.path; });
+    return stamps;
+}
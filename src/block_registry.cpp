@@ -1,8 +1,12 @@
 #include "../headers/block_registry.h"
-#include "../headers/texture.h"
+#include "../headers/logger.h"
+#include "../headers/profiler.h"
+#include "../headers/texture_atlas.h"
+#include "../headers/block_definition_io.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include <random>
 
 /**
@@ -10,11 +14,11 @@
  */
 bool BlockRegistry::initialize(const std::string& blocks_directory) {
     if (initialized_) {
-        std::cout << "BlockRegistry already initialized." << std::endl;
+        AZV_LOG_INFO(Registry) << "BlockRegistry already initialized.";
         return true;
     }
     
-    std::cout << "Initializing BlockRegistry..." << std::endl;
+    AZV_LOG_INFO(Registry) << "Initializing BlockRegistry...";
     
     // Clear all data
     block_definitions_.clear();
@@ -25,30 +29,37 @@ bool BlockRegistry::initialize(const std::string& blocks_directory) {
     biome_name_to_id_.clear();
     planet_name_to_id_.clear();
     texture_name_to_index_.clear();
+    // A reload registers the same contexts again; they must get the same IDs
+    next_block_id_ = 1;
+    next_biome_id_ = 1;
+    next_planet_id_ = 1;
     
-    // Initialize arrays
-    for (int i = 0; i < MAX_BLOCK_TYPES; ++i) {
+    // Initialize arrays (only the entries an earlier initialize wrote; the rest still hold defaults)
+    for (int i = 0; i < render_data_extent_; ++i) {
         render_data_[i] = BlockRenderData{};
-        for (int j = 0; j < MAX_CONTEXTS; ++j) {
-            context_map_[i][j] = INVALID_BLOCK_ID;
+        for (int face = 0; face < FACE_COUNT; ++face) {
+            face_uvs_[i][face] = BlockFaceUV{};
         }
     }
+    render_data_extent_ = 0;
+    std::fill(std::begin(solid_bits_), std::end(solid_bits_), 0);
+    std::fill(std::begin(transparent_bits_), std::end(transparent_bits_), 0);
+    std::fill(std::begin(light_source_bits_), std::end(light_source_bits_), 0);
+    std::fill(std::begin(opaque_bits_), std::end(opaque_bits_), 0);
+    std::fill(std::begin(light_levels_), std::end(light_levels_), 0);
+    pending_variants_.clear();
+    rebuildContextMap();
     
     // Create default blocks first (hardcoded for backward compatibility)
     createDefaultBlocks();
     
     // Try to load block definitions from files if directory exists
     if (std::filesystem::exists(blocks_directory)) {
-        std::cout << "Loading block definitions from: " << blocks_directory << std::endl;
-        
-        for (const auto& entry : std::filesystem::directory_iterator(blocks_directory)) {
-            if (entry.path().extension() == ".json") {
-                loadBlockDefinitionFile(entry.path().string());
-            }
-        }
+        AZV_LOG_INFO(Registry) << "Loading block definitions from: " << blocks_directory;
+        loadBlockDefinitionDirectory(blocks_directory);
     } else {
-        std::cout << "Block definitions directory not found: " << blocks_directory << std::endl;
-        std::cout << "Using default block definitions only." << std::endl;
+        AZV_LOG_INFO(Registry) << "Block definitions directory not found: " << blocks_directory;
+        AZV_LOG_INFO(Registry) << "Using default block definitions only.";
     }
     
     // Register default biomes and planets
@@ -94,8 +105,8 @@ bool BlockRegistry::initialize(const std::string& blocks_directory) {
     buildOptimizationTables();
     
     initialized_ = true;
-    std::cout << "BlockRegistry initialized with " << block_definitions_.size() << " blocks, " 
-              << biomes_.size() << " biomes, " << planets_.size() << " planets." << std::endl;
+    AZV_LOG_INFO(Registry) << "BlockRegistry initialized with " << block_definitions_.size() << " blocks, " 
+                           << biomes_.size() << " biomes, " << planets_.size() << " planets.";
     
     return true;
 }
@@ -106,7 +117,7 @@ bool BlockRegistry::initialize(const std::string& blocks_directory) {
 void BlockRegistry::shutdown() {
     if (!initialized_) return;
     
-    std::cout << "Shutting down BlockRegistry..." << std::endl;
+    AZV_LOG_INFO(Registry) << "Shutting down BlockRegistry...";
     
     block_definitions_.clear();
     name_to_id_.clear();
@@ -274,21 +285,21 @@ void BlockRegistry::createDefaultBlocks() {
  */
 bool BlockRegistry::registerBlock(const BlockDefinition& definition) {
     if (definition.numeric_id >= MAX_BLOCK_TYPES) {
-        std::cerr << "Error: Block ID " << definition.numeric_id << " exceeds maximum (" << MAX_BLOCK_TYPES << ")" << std::endl;
+        AZV_LOG_ERROR(Registry) << "Error: Block ID " << definition.numeric_id << " exceeds maximum (" << MAX_BLOCK_TYPES << ")";
         return false;
     }
     
     // Check for ID conflicts
     if (definition.numeric_id < block_definitions_.size() && 
         !block_definitions_[definition.numeric_id].id.empty()) {
-        std::cerr << "Error: Block ID " << definition.numeric_id << " already in use by " 
-                  << block_definitions_[definition.numeric_id].id << std::endl;
+        AZV_LOG_ERROR(Registry) << "Error: Block ID " << definition.numeric_id << " already in use by " 
+                                << block_definitions_[definition.numeric_id].id;
         return false;
     }
     
     // Check for name conflicts
     if (name_to_id_.find(definition.id) != name_to_id_.end()) {
-        std::cerr << "Error: Block name " << definition.id << " already registered" << std::endl;
+        AZV_LOG_ERROR(Registry) << "Error: Block name " << definition.id << " already registered";
         return false;
     }
     
@@ -304,10 +315,13 @@ bool BlockRegistry::registerBlock(const BlockDefinition& definition) {
     
     // Set up render data
     BlockRenderData& render_data = render_data_[definition.numeric_id];
+    render_data_extent_ = std::max<int>(render_data_extent_, definition.numeric_id + 1);
     render_data.setSolid(definition.solid);
     render_data.setTransparent(definition.transparent);
     render_data.light_level = definition.light_emission;
+    render_data.setLightSource(definition.light_emission > 0);
     render_data.texture_atlas_index = getTextureIndex(definition.default_texture);
+    bakeBlockFaceUVs(definition.numeric_id);
     
     // Set up cull mask for face culling optimization
     if (definition.solid) {
@@ -315,8 +329,9 @@ bool BlockRegistry::registerBlock(const BlockDefinition& definition) {
     } else {
         render_data.cull_mask = BlockRenderData::FLAG_SOLID; // Non-solid blocks only cull against solid blocks
     }
+    updateBlockProperties(definition.numeric_id);
     
-    std::cout << "Registered block: " << definition.id << " (ID: " << definition.numeric_id << ")" << std::endl;
+    AZV_LOG_DEBUG(Registry) << "Registered block: " << definition.id << " (ID: " << definition.numeric_id << ")";
     
     // Update next_block_id_ for auto-incrementing
     if (definition.numeric_id >= next_block_id_) {
@@ -331,7 +346,7 @@ bool BlockRegistry::registerBlock(const BlockDefinition& definition) {
  */
 uint8_t BlockRegistry::registerBiome(const BiomeContext& biome) {
     if (next_biome_id_ == 255) {
-        std::cerr << "Error: Maximum number of biomes reached" << std::endl;
+        AZV_LOG_ERROR(Registry) << "Error: Maximum number of biomes reached";
         return 0;
     }
     
@@ -346,7 +361,7 @@ uint8_t BlockRegistry::registerBiome(const BiomeContext& biome) {
         biome_name_to_id_[biome.biome_id] = biome_id;
     }
     
-    std::cout << "Registered biome: " << biome.biome_id << " (ID: " << (int)biome_id << ")" << std::endl;
+    AZV_LOG_DEBUG(Registry) << "Registered biome: " << biome.biome_id << " (ID: " << (int)biome_id << ")";
     return biome_id;
 }
 
@@ -355,7 +370,7 @@ uint8_t BlockRegistry::registerBiome(const BiomeContext& biome) {
  */
 uint8_t BlockRegistry::registerPlanet(const PlanetContext& planet) {
     if (next_planet_id_ == 255) {
-        std::cerr << "Error: Maximum number of planets reached" << std::endl;
+        AZV_LOG_ERROR(Registry) << "Error: Maximum number of planets reached";
         return 0;
     }
     
@@ -370,7 +385,7 @@ uint8_t BlockRegistry::registerPlanet(const PlanetContext& planet) {
         planet_name_to_id_[planet.planet_id] = planet_id;
     }
     
-    std::cout << "Registered planet: " << planet.planet_id << " (ID: " << (int)planet_id << ")" << std::endl;
+    AZV_LOG_DEBUG(Registry) << "Registered planet: " << planet.planet_id << " (ID: " << (int)planet_id << ")";
     return planet_id;
 }
 
@@ -386,27 +401,15 @@ const BlockRenderData& BlockRegistry::getRenderData(uint16_t block_id) const {
 }
 
 /**
- * Check if a block is solid (optimized for hot path)
- */
-bool BlockRegistry::isBlockSolid(uint16_t block_id) const {
-    if (block_id >= MAX_BLOCK_TYPES) return false;
-    return render_data_[block_id].isSolid();
-}
-
-/**
- * Check if a block is transparent (optimized for hot path)
- */
-bool BlockRegistry::isBlockTransparent(uint16_t block_id) const {
-    if (block_id >= MAX_BLOCK_TYPES) return false;
-    return render_data_[block_id].isTransparent();
-}
-
-/**
- * Get block light level (optimized for hot path)
+ * Copy one block's render flags into the per-property bitsets and the light level array
  */
-uint8_t BlockRegistry::getBlockLightLevel(uint16_t block_id) const {
-    if (block_id >= MAX_BLOCK_TYPES) return 0;
-    return render_data_[block_id].light_level;
+void BlockRegistry::updateBlockProperties(uint16_t block_id) {
+    const BlockRenderData& render_data = render_data_[block_id];
+    assignBit(solid_bits_, block_id, render_data.isSolid());
+    assignBit(transparent_bits_, block_id, render_data.isTransparent());
+    assignBit(light_source_bits_, block_id, render_data.isLightSource());
+    assignBit(opaque_bits_, block_id, block_id != 0 && !render_data.isTransparent());
+    light_levels_[block_id] = render_data.light_level;
 }
 
 /**
@@ -442,13 +445,17 @@ uint16_t BlockRegistry::selectBlock(const std::string& base_block_name,
 uint16_t BlockRegistry::selectBlock(uint16_t base_block_id, uint8_t biome_id, uint8_t planet_id) const {
     if (base_block_id >= MAX_BLOCK_TYPES) return 0;
     
-    ContextKey key(biome_id, planet_id);
-    uint16_t context_index = static_cast<uint16_t>(key.biome_id) * 16 + static_cast<uint16_t>(key.planet_id);
+    uint16_t begin = variant_offsets_[base_block_id];
+    uint16_t end = variant_offsets_[base_block_id + 1];
+    if (begin == end) {
+        return base_block_id; // No variants: the common case
+    }
     
-    if (context_index < MAX_CONTEXTS) {
-        uint16_t result = context_map_[base_block_id][context_index];
-        if (result != INVALID_BLOCK_ID) {
-            return result;
+    // A block has a handful of variants at most; scan its sorted run
+    uint16_t context = ContextKey(biome_id, planet_id).packed();
+    for (uint16_t i = begin; i < end && context_variants_[i].context <= context; ++i) {
+        if (context_variants_[i].context == context) {
+            return context_variants_[i].block_id;
         }
     }
     
@@ -503,153 +510,286 @@ uint16_t BlockRegistry::getTextureIndex(const std::string& texture_name) const {
 }
 
 /**
- * Build optimization tables for fast lookups
+ * Bake the [block][face] UV table for the loaded atlas
  */
-void BlockRegistry::buildOptimizationTables() {
-    std::cout << "Building optimization tables..." << std::endl;
-    
-    // Initialize context map with base block IDs
-    for (uint16_t block_id = 0; block_id < MAX_BLOCK_TYPES; ++block_id) {
-        for (uint16_t context_id = 0; context_id < MAX_CONTEXTS; ++context_id) {
-            context_map_[block_id][context_id] = block_id; // Default to base block
+void BlockRegistry::bakeFaceUVs(int atlas_width, int atlas_height) {
+    atlas_width_ = atlas_width;
+    atlas_height_ = atlas_height;
+    atlas_rects_.clear();
+    for (size_t block_id = 0; block_id < block_definitions_.size(); ++block_id) {
+        bakeBlockFaceUVs(static_cast<uint16_t>(block_id));
+    }
+    AZV_LOG_DEBUG(Registry) << "Baked face UVs for " << block_definitions_.size() << " blocks (atlas "
+                            << atlas_width << "x" << atlas_height << ")";
+}
+
+/**
+ * Bake the UV table against a runtime-built atlas
+ */
+void BlockRegistry::applyTextureAtlas(const TextureAtlas& atlas) {
+    atlas_width_ = atlas.width;
+    atlas_height_ = atlas.height;
+    atlas_rects_ = atlas.rects;
+    atlas_missing_rect_ = atlas.missing;
+    for (size_t block_id = 0; block_id < block_definitions_.size(); ++block_id) {
+        bakeBlockFaceUVs(static_cast<uint16_t>(block_id));
+    }
+    AZV_LOG_DEBUG(Registry) << "Baked face UVs for " << block_definitions_.size() << " blocks against a "
+                            << atlas_rects_.size() << "-texture atlas";
+}
+
+/**
+ * Collect the texture names of all registered blocks
+ */
+std::vector<std::string> BlockRegistry::getTextureNames() const {
+    std::vector<std::string> names;
+    for (const BlockDefinition& definition : block_definitions_) {
+        if (definition.id.empty()) continue;
+        names.push_back(definition.default_texture);
+        for (const auto& [face, texture] : definition.per_face_textures) {
+            names.push_back(texture);
         }
     }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
+}
+
+/**
+ * Resolve each face's texture (specific face, then "top"/"bottom"/"side", then the default)
+ * and store its atlas rectangle
+ */
+void BlockRegistry::bakeBlockFaceUVs(uint16_t block_id) {
+    static const char* const FACE_NAMES[FACE_COUNT] = {"north", "south", "west", "east", "bottom", "top"};
+    static const char* const FACE_GROUPS[FACE_COUNT] = {"side", "side", "side", "side", "bottom", "top"};
+    
+    if (block_id >= block_definitions_.size() || block_id >= MAX_BLOCK_TYPES) return;
+    const BlockDefinition& definition = block_definitions_[block_id];
+    
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        BlockFaceUV& uv = face_uvs_[block_id][face];
+        if (atlas_width_ <= 0 || atlas_height_ <= 0) {
+            uv = BlockFaceUV{};
+            continue;
+        }
+        
+        const std::string* texture_name = &definition.default_texture;
+        auto it = definition.per_face_textures.find(FACE_NAMES[face]);
+        if (it == definition.per_face_textures.end()) {
+            it = definition.per_face_textures.find(FACE_GROUPS[face]);
+        }
+        if (it != definition.per_face_textures.end()) {
+            texture_name = &it->second;
+        }
+        
+        if (!atlas_rects_.empty()) {
+            auto rect = atlas_rects_.find(*texture_name);
+            uv = rect != atlas_rects_.end() ? rect->second : atlas_missing_rect_;
+            continue;
+        }
+        
+        // Hand-authored spritesheet: fixed grid addressed by texture index
+        uint16_t texture_index = getTextureIndex(*texture_name);
+        float pixel_x = (texture_index % ATLAS_TILES_PER_ROW) * ATLAS_TILE_SIZE;
+        float pixel_y = (texture_index / ATLAS_TILES_PER_ROW) * ATLAS_TILE_SIZE;
+        uv.u0 = pixel_x / atlas_width_;
+        uv.v0 = pixel_y / atlas_height_;
+        uv.u1 = (pixel_x + ATLAS_TILE_SIZE) / atlas_width_;
+        uv.v1 = (pixel_y + ATLAS_TILE_SIZE) / atlas_height_;
+    }
+}
+
+/**
+ * Build optimization tables for fast lookups
+ */
+void BlockRegistry::buildOptimizationTables() {
+    AZV_LOG_INFO(Registry) << "Building optimization tables...";
     
-    // TODO: Build variants based on biome and planet contexts
-    // For now, we'll create some simple variants for demonstration
-    
-    // Example: Cold biome variants
+    // Built-in example: cold biome variants
     uint8_t cold_biome_id = 2; // Assuming cold biome is registered as ID 2
     if (cold_biome_id < biomes_.size()) {
         // Grass becomes snow in cold biomes
         uint16_t grass_id = getBlockId("azurevoxel:grass");
         uint16_t snow_id = getBlockId("azurevoxel:snow");
         if (grass_id != INVALID_BLOCK_ID && snow_id != INVALID_BLOCK_ID) {
-            uint16_t context_index = cold_biome_id * 16; // Planet ID 0
-            context_map_[grass_id][context_index] = snow_id;
+            addContextVariant(grass_id, cold_biome_id, 0, snow_id); // Planet ID 0
+        }
+    }
+    
+    // Variants from the definition files; queued after the example, so a file can override it
+    for (const BlockDefinition& definition : block_definitions_) {
+        if (!definition.id.empty()) {
+            addDefinitionVariants(definition);
         }
     }
     
-    std::cout << "Optimization tables built." << std::endl;
+    rebuildContextMap();
+    AZV_LOG_INFO(Registry) << "Optimization tables built (" << context_variants_.size() << " context variants).";
 }
 
 /**
- * Load block definition from file (supports both JSON and simple text format)
+ * Queue the "variants" of a definition: each context ("<biome>", "<planet>" or
+ * "<biome>@<planet>") maps to {"block": "<block id>"}, the block used in that context.
+ * Contexts and blocks are resolved by name, so this runs once every block, biome and planet
+ * is registered.
  */
-bool BlockRegistry::loadBlockDefinitionFile(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open block definition file: " << file_path << std::endl;
-        return false;
+void BlockRegistry::addDefinitionVariants(const BlockDefinition& definition) {
+    for (const auto& [context, overrides] : definition.variants) {
+        auto block_it = overrides.find("block");
+        uint16_t variant_id = block_it != overrides.end() ? getBlockId(block_it->second) : INVALID_BLOCK_ID;
+        if (variant_id == INVALID_BLOCK_ID) {
+            AZV_LOG_WARN(Registry) << "Variant '" << context << "' of " << definition.id << " names no registered block";
+            continue;
+        }
+        
+        // A bare name is a biome, or else a planet; "<biome>@<planet>" needs both
+        const size_t at = context.find('@');
+        auto biome_it = biome_name_to_id_.find(context.substr(0, at));
+        auto planet_it = planet_name_to_id_.find(at == std::string::npos ? context : context.substr(at + 1));
+        const bool has_biome = biome_it != biome_name_to_id_.end();
+        const bool has_planet = planet_it != planet_name_to_id_.end();
+        if (at == std::string::npos ? !(has_biome || has_planet) : !(has_biome && has_planet)) {
+            AZV_LOG_WARN(Registry) << "Variant of " << definition.id << " names an unknown context '" << context << "'";
+            continue;
+        }
+        const uint8_t biome_id = has_biome ? biome_it->second : 0;
+        const uint8_t planet_id = has_planet && (at != std::string::npos || !has_biome) ? planet_it->second : 0;
+        addContextVariant(definition.numeric_id, biome_id, planet_id, variant_id);
+    }
+}
+
+/**
+ * Queue a context variant; takes effect on the next rebuildContextMap
+ */
+void BlockRegistry::addContextVariant(uint16_t base_block_id, uint8_t biome_id, uint8_t planet_id, uint16_t variant_id) {
+    if (base_block_id >= MAX_BLOCK_TYPES || variant_id >= MAX_BLOCK_TYPES) return;
+    pending_variants_.push_back({base_block_id, ContextVariant{ContextKey(biome_id, planet_id).packed(), variant_id}});
+}
+
+/**
+ * Rebuild the compressed variant index from the queued variants (a later entry for the
+ * same block and context replaces an earlier one)
+ */
+void BlockRegistry::rebuildContextMap() {
+    std::stable_sort(pending_variants_.begin(), pending_variants_.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : a.second.context < b.second.context;
+    });
+    
+    context_variants_.clear();
+    std::fill(std::begin(variant_offsets_), std::end(variant_offsets_), 0);
+    for (size_t i = 0; i < pending_variants_.size(); ++i) {
+        const auto& [base_block_id, variant] = pending_variants_[i];
+        bool overridden = i + 1 < pending_variants_.size() && pending_variants_[i + 1].first == base_block_id &&
+                          pending_variants_[i + 1].second.context == variant.context;
+        if (overridden || context_variants_.size() >= INVALID_BLOCK_ID) continue;
+        context_variants_.push_back(variant);
+        ++variant_offsets_[base_block_id + 1];
+    }
+    for (uint16_t block_id = 0; block_id < MAX_BLOCK_TYPES; ++block_id) {
+        variant_offsets_[block_id + 1] += variant_offsets_[block_id];
     }
+}
+
+/**
+ * Load every .json definition file in a directory, from the compiled snapshot when no
+ * source has changed since it was written
+ */
+bool BlockRegistry::loadBlockDefinitionDirectory(const std::string& blocks_directory) {
+    AZV_PROFILE_ZONE("BlockRegistry::loadBlockDefinitionDirectory");
+    loaded_definitions_from_cache_ = false;
+    
+    std::vector<std::string> paths;
+    for (const auto& entry : std::filesystem::directory_iterator(blocks_directory)) {
+        if (entry.path().extension() == ".json") {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end()); // Registration order must not depend on directory order
     
-    std::cout << "Loading block definitions from: " << file_path << std::endl;
+    std::vector<BlockSourceHash> sources;
+    for (const std::string& path : paths) {
+        MappedFile file(path);
+        if (!file) {
+            AZV_LOG_ERROR(Registry) << "Failed to open block definition file: " << path;
+            continue;
+        }
+        sources.push_back(BlockSourceHash{path, hashBlockSource(file.data(), file.size())});
+    }
     
-    // Determine file type by extension
-    std::filesystem::path path(file_path);
-    std::string extension = path.extension().string();
+    const std::string cache_path = (std::filesystem::path(blocks_directory) / "registry.cache").string();
+    BlockRegistryCache cache;
+    if (definition_cache_enabled_ && cache.open(cache_path, sources)) {
+        // Each definition is built straight from its record in the mapping
+        for (size_t i = 0; i < cache.size(); ++i) {
+            registerParsedDefinition(cache.definition(i));
+        }
+        loaded_definitions_from_cache_ = true;
+        AZV_LOG_INFO(Registry) << "Loaded " << cache.size() << " block definitions from " << cache_path;
+        return true;
+    }
     
-    if (extension == ".json") {
-        return loadBlockDefinitionFromJSON(file);
-    } else {
-        return loadBlockDefinitionFromText(file);
+    std::vector<BlockDefinition> parsed;
+    bool all_parsed = true;
+    for (const BlockSourceHash& source : sources) {
+        all_parsed = loadBlockDefinitionFile(source.path, parsed) && all_parsed;
+    }
+    // A partially parsed source is not cached, so its error is reported again next time
+    if (definition_cache_enabled_ && all_parsed && !BlockRegistryCache::write(cache_path, sources, parsed)) {
+        AZV_LOG_WARN(Registry) << "Could not write block definition cache " << cache_path;
     }
+    for (const BlockDefinition& definition : parsed) {
+        registerParsedDefinition(definition);
+    }
+    return true;
 }
 
 /**
- * Load block definitions from JSON format
+ * Load block definition from file (supports both JSON and simple text format)
  */
-bool BlockRegistry::loadBlockDefinitionFromJSON(std::ifstream& file) {
-    std::string content((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
+bool BlockRegistry::loadBlockDefinitionFile(const std::string& file_path, std::vector<BlockDefinition>& parsed) {
+    AZV_LOG_INFO(Registry) << "Loading block definitions from: " << file_path;
     
-    try {
-        // Simple JSON parser for block definitions
-        
-        // Find "blocks" array
-        size_t blocks_start = content.find("\"blocks\"");
-        if (blocks_start == std::string::npos) {
-            std::cerr << "Error: No 'blocks' array found in JSON file" << std::endl;
-            return false;
-        }
-        
-        // Find opening bracket of blocks array
-        size_t array_start = content.find('[', blocks_start);
-        if (array_start == std::string::npos) {
-            std::cerr << "Error: Invalid JSON format - no opening bracket for blocks array" << std::endl;
+    // Determine file type by extension
+    std::filesystem::path path(file_path);
+    std::string extension = path.extension().string();
+    
+    if (extension == ".json") {
+        MappedFile file(file_path);
+        if (!file) {
+            AZV_LOG_ERROR(Registry) << "Failed to open block definition file: " << file_path;
             return false;
         }
-        
-        // Find closing bracket of blocks array
-        size_t array_end = content.find_last_of(']');
-        if (array_end == std::string::npos || array_end <= array_start) {
-            std::cerr << "Error: Invalid JSON format - no closing bracket for blocks array" << std::endl;
+        std::string error;
+        if (!parseBlockDefinitionsJSON(file.data(), file.size(), parsed, error)) {
+            AZV_LOG_ERROR(Registry) << "Error parsing JSON " << file_path << ": " << error;
             return false;
         }
-        
-        // Extract blocks array content
-        std::string blocks_content = content.substr(array_start + 1, array_end - array_start - 1);
-        
-        // Parse each block object
-        size_t current_pos = 0;
-        while (current_pos < blocks_content.length()) {
-            // Find next block object
-            size_t obj_start = blocks_content.find('{', current_pos);
-            if (obj_start == std::string::npos) break;
-            
-            size_t obj_end = blocks_content.find('}', obj_start);
-            if (obj_end == std::string::npos) {
-                std::cerr << "Error: Unclosed block object in JSON" << std::endl;
-                break;
-            }
-            
-            std::string block_obj = blocks_content.substr(obj_start + 1, obj_end - obj_start - 1);
-            
-            // Parse block object properties
-            BlockDefinition def;
-            
-            // Parse required fields
-            std::string id = parseJSONString(block_obj, "id");
-            uint16_t numeric_id = static_cast<uint16_t>(parseJSONNumber(block_obj, "numeric_id"));
-            std::string display_name = parseJSONString(block_obj, "display_name");
-            
-            if (id.empty() || numeric_id == 0 || display_name.empty()) {
-                std::cerr << "Error: Missing required fields in block definition" << std::endl;
-                current_pos = obj_end + 1;
-                continue;
-            }
-            
-            def.id = id;
-            def.numeric_id = numeric_id;
-            def.display_name = display_name;
-            
-            // Parse optional fields
-            def.default_texture = parseJSONString(block_obj, "texture", "stone");
-            def.solid = parseJSONBool(block_obj, "solid", true);
-            def.transparent = parseJSONBool(block_obj, "transparent", false);
-            def.hardness = static_cast<float>(parseJSONNumber(block_obj, "hardness", 1.0));
-            def.blast_resistance = static_cast<float>(parseJSONNumber(block_obj, "blast_resistance", 1.0));
-            def.flammable = parseJSONBool(block_obj, "flammable", false);
-            def.light_emission = static_cast<uint8_t>(parseJSONNumber(block_obj, "light_emission", 0));
-            
-            // Register the block
-            registerBlock(def);
-            
-            current_pos = obj_end + 1;
-        }
-        
         return true;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error parsing JSON: " << e.what() << std::endl;
+    }
+    
+    std::ifstream file(file_path);
+    if (!file.is_open()) {
+        AZV_LOG_ERROR(Registry) << "Failed to open block definition file: " << file_path;
         return false;
     }
+    return loadBlockDefinitionFromText(file, parsed);
+}
+
+/**
+ * Validate and register one definition read from a file or the snapshot
+ */
+void BlockRegistry::registerParsedDefinition(const BlockDefinition& definition) {
+    if (definition.id.empty() || definition.numeric_id == 0 || definition.display_name.empty()) {
+        AZV_LOG_ERROR(Registry) << "Error: Missing required fields in block definition";
+        return;
+    }
+    registerBlock(definition);
 }
 
 /**
  * Load block definitions from simple text format
  */
-bool BlockRegistry::loadBlockDefinitionFromText(std::ifstream& file) {
+bool BlockRegistry::loadBlockDefinitionFromText(std::ifstream& file, std::vector<BlockDefinition>& parsed) {
     std::string line;
     while (std::getline(file, line)) {
         if (line.empty() || line[0] == '#') continue; // Skip empty lines and comments
@@ -663,143 +803,56 @@ bool BlockRegistry::loadBlockDefinitionFromText(std::ifstream& file) {
             def.default_texture = texture;
             def.solid = (solid_str == "true" || solid_str == "1");
             
-            registerBlock(def);
+            parsed.push_back(def);
         }
     }
     
     return true;
 }
 
-/**
- * Helper function to parse JSON string values
- */
-std::string BlockRegistry::parseJSONString(const std::string& json, const std::string& key, const std::string& default_value) {
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-    if (key_pos == std::string::npos) return default_value;
-    
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) return default_value;
-    
-    size_t quote_start = json.find('"', colon_pos);
-    if (quote_start == std::string::npos) return default_value;
-    
-    size_t quote_end = json.find('"', quote_start + 1);
-    if (quote_end == std::string::npos) return default_value;
-    
-    return json.substr(quote_start + 1, quote_end - quote_start - 1);
-}
-
-/**
- * Helper function to parse JSON number values
- */
-double BlockRegistry::parseJSONNumber(const std::string& json, const std::string& key, double default_value) {
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-    if (key_pos == std::string::npos) return default_value;
-    
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) return default_value;
-    
-    // Skip whitespace after colon
-    size_t num_start = colon_pos + 1;
-    while (num_start < json.length() && std::isspace(json[num_start])) {
-        num_start++;
-    }
-    
-    if (num_start >= json.length()) return default_value;
-    
-    // Find end of number (comma, brace, or whitespace)
-    size_t num_end = num_start;
-    while (num_end < json.length() && 
-           json[num_end] != ',' && 
-           json[num_end] != '}' && 
-           !std::isspace(json[num_end])) {
-        num_end++;
-    }
-    
-    if (num_end <= num_start) return default_value;
-    
-    std::string num_str = json.substr(num_start, num_end - num_start);
-    try {
-        return std::stod(num_str);
-    } catch (const std::exception&) {
-        return default_value;
-    }
-}
-
-/**
- * Helper function to parse JSON boolean values
- */
-bool BlockRegistry::parseJSONBool(const std::string& json, const std::string& key, bool default_value) {
-    std::string search_key = "\"" + key + "\"";
-    size_t key_pos = json.find(search_key);
-    if (key_pos == std::string::npos) return default_value;
-    
-    size_t colon_pos = json.find(':', key_pos);
-    if (colon_pos == std::string::npos) return default_value;
-    
-    // Find "true" or "false"
-    size_t true_pos = json.find("true", colon_pos);
-    size_t false_pos = json.find("false", colon_pos);
-    
-    // Check which comes first after the colon
-    if (true_pos != std::string::npos && (false_pos == std::string::npos || true_pos < false_pos)) {
-        // Make sure "true" is the next non-whitespace content
-        size_t check_pos = colon_pos + 1;
-        while (check_pos < true_pos && std::isspace(json[check_pos])) {
-            check_pos++;
-        }
-        if (check_pos == true_pos) {
-            return true;
-        }
-    }
-    
-    if (false_pos != std::string::npos) {
-        // Make sure "false" is the next non-whitespace content
-        size_t check_pos = colon_pos + 1;
-        while (check_pos < false_pos && std::isspace(json[check_pos])) {
-            check_pos++;
-        }
-        if (check_pos == false_pos) {
-            return false;
-        }
-    }
-    
-    return default_value;
-}
-
 /**
  * Print registry statistics
  */
 void BlockRegistry::printRegistryStats() const {
-    std::cout << "\n=== Block Registry Statistics ===" << std::endl;
-    std::cout << "Blocks registered: " << block_definitions_.size() << std::endl;
-    std::cout << "Biomes registered: " << biomes_.size() << std::endl;
-    std::cout << "Planets registered: " << planets_.size() << std::endl;
-    std::cout << "Next block ID: " << next_block_id_ << std::endl;
+    AZV_LOG_INFO(Registry) << "\n=== Block Registry Statistics ===";
+    AZV_LOG_INFO(Registry) << "Blocks registered: " << block_definitions_.size();
+    AZV_LOG_INFO(Registry) << "Biomes registered: " << biomes_.size();
+    AZV_LOG_INFO(Registry) << "Planets registered: " << planets_.size();
+    AZV_LOG_INFO(Registry) << "Next block ID: " << next_block_id_;
     
-    std::cout << "\nRegistered blocks:" << std::endl;
+    AZV_LOG_INFO(Registry) << "\nRegistered blocks:";
     for (size_t i = 0; i < block_definitions_.size(); ++i) {
         if (!block_definitions_[i].id.empty()) {
             const auto& def = block_definitions_[i];
-            std::cout << "  " << i << ": " << def.id << " (" << def.display_name << ")" 
-                      << " solid=" << def.solid << " texture=" << def.default_texture << std::endl;
+            AZV_LOG_INFO(Registry) << "  " << i << ": " << def.id << " (" << def.display_name << ")" 
+                                   << " solid=" << def.solid << " texture=" << def.default_texture;
         }
     }
     
-    std::cout << "\nRegistered biomes:" << std::endl;
+    AZV_LOG_INFO(Registry) << "\nRegistered biomes:";
     for (size_t i = 0; i < biomes_.size(); ++i) {
         const auto& biome = biomes_[i];
-        std::cout << "  " << i << ": " << biome.biome_id 
-                  << " temp=" << biome.temperature << " moisture=" << biome.moisture << std::endl;
+        AZV_LOG_INFO(Registry) << "  " << i << ": " << biome.biome_id 
+                               << " temp=" << biome.temperature << " moisture=" << biome.moisture;
     }
     
-    std::cout << "\nRegistered planets:" << std::endl;
+    AZV_LOG_INFO(Registry) << "\nRegistered planets:";
     for (size_t i = 0; i < planets_.size(); ++i) {
         const auto& planet = planets_[i];
-        std::cout << "  " << i << ": " << planet.planet_id 
-                  << " atmosphere=" << planet.atmosphere_type << std::endl;
+        AZV_LOG_INFO(Registry) << "  " << i << ": " << planet.planet_id 
+                               << " atmosphere=" << planet.atmosphere_type;
     }
-    std::cout << "================================\n" << std::endl;
-} 
\ No newline at end of file
+    AZV_LOG_INFO(Registry) << "================================\n";
+} 
+/**
+ * Re-read every block definition, as a fresh initialize would. Block IDs, render data and face
+ * UVs (against the atlas already applied) are rebuilt; callers that hold derived state, such
+ * as chunk meshes, compare it before and after (see World::reloadBlockDefinitions).
+ * No other thread may use the registry while it reloads.
+ */
+bool BlockRegistry::reloadDefinitions(const std::string& blocks_directory) {
+    AZV_PROFILE_ZONE("BlockRegistry::reloadDefinitions");
+    AZV_LOG_INFO(Registry) << "Reloading block definitions from " << blocks_directory;
+    initialized_ = false;
+    return initialize(blocks_directory);
+}
@@ -11,34 +11,6 @@ glm::mat4 Camera::getViewMatrix() const {
     return glm::lookAt(position, position + front, up);
 }
 
-void Camera::processKeyboard(GLFWwindow* window, float deltaTime) {
-    float velocity = movementSpeed * deltaTime;
-    
-    // Forward
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        position += front * velocity;
-    
-    // Backward
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        position -= front * velocity;
-    
-    // Left
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        position -= right * velocity;
-    
-    // Right
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        position += right * velocity;
-    
-    // Up
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
-        position += up * velocity;
-    
-    // Down
-    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
-        position -= up * velocity;
-}
-
 void Camera::processMouseMovement(float xOffset, float yOffset, bool constrainPitch) {
     xOffset *= mouseSensitivity;
     yOffset *= mouseSensitivity;
@@ -95,4 +67,10 @@ void Camera::setMouseSensitivity(float sensitivity) {
 
 void Camera::setFov(float newFov) {
     fov = newFov;
-} 
\ No newline at end of file
+}
+
+void Camera::setOrientation(float newYaw, float newPitch) {
+    yaw = newYaw;
+    pitch = newPitch;
+    updateCameraVectors();
+}
@@ -0,0 +1,31 @@
+#include "../headers/camera.h"
+#include <GLFW/glfw3.h>
+
+// Keyboard polling is kept out of camera.cpp so the camera itself has no windowing dependency
+void Camera::processKeyboard(GLFWwindow* window, float deltaTime) {
+    float velocity = movementSpeed * deltaTime;
+    
+    // Forward
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        position += front * velocity;
+    
+    // Backward
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        position -= front * velocity;
+    
+    // Left
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        position -= right * velocity;
+    
+    // Right
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        position += right * velocity;
+    
+    // Up
+    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
+        position += up * velocity;
+    
+    // Down
+    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
+        position -= up * velocity;
+}
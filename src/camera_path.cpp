@@ -0,0 +1,109 @@
+#include "../headers/camera_path.h"
+#include "../headers/camera.h"
+#include "../headers/logger.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+void CameraPath::addSample(const CameraPathSample& sample) {
+    if (!samples_.empty() && sample.time < samples_.back().time) {
+        return;
+    }
+    samples_.push_back(sample);
+}
+
+void CameraPath::record(double time, const Camera& camera) {
+    CameraPathSample sample;
+    sample.time = time;
+    sample.position = camera.getPosition();
+    sample.yaw = camera.getYaw();
+    sample.pitch = camera.getPitch();
+    addSample(sample);
+}
+
+CameraPathSample CameraPath::sampleAt(double time) const {
+    if (samples_.empty()) {
+        return CameraPathSample();
+    }
+    if (time <= samples_.front().time) {
+        return samples_.front();
+    }
+    if (time >= samples_.back().time) {
+        return samples_.back();
+    }
+
+    // First sample strictly after `time`; the one before it is at or before `time`
+    auto next = std::upper_bound(samples_.begin(), samples_.end(), time,
+                                 [](double t, const CameraPathSample& s) { return t < s.time; });
+    const CameraPathSample& b = *next;
+    const CameraPathSample& a = *(next - 1);
+    double span = b.time - a.time;
+    float t = span > 0.0 ? static_cast<float>((time - a.time) / span) : 0.0f;
+
+    CameraPathSample result;
+    result.time = time;
+    result.position = a.position + (b.position - a.position) * t;
+    result.yaw = a.yaw + (b.yaw - a.yaw) * t;
+    result.pitch = a.pitch + (b.pitch - a.pitch) * t;
+    return result;
+}
+
+void CameraPath::applyTo(Camera& camera, double time) const {
+    CameraPathSample sample = sampleAt(time);
+    camera.setPosition(sample.position);
+    camera.setOrientation(sample.yaw, sample.pitch);
+}
+
+bool CameraPath::saveToFile(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        AZV_LOG_ERROR(General) << "Error: Could not open camera path file for writing: " << path;
+        return false;
+    }
+    // Round-trip precision so a replayed path matches the recording exactly
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << "# AzureVoxel camera path v1\n# time x y z yaw pitch\n";
+    for (const CameraPathSample& s : samples_) {
+        file << s.time << ' ' << s.position.x << ' ' << s.position.y << ' ' << s.position.z
+             << ' ' << s.yaw << ' ' << s.pitch << '\n';
+    }
+    AZV_LOG_INFO(General) << "Camera path with " << samples_.size() << " samples ("
+                          << duration() << " s) written to " << path;
+    return true;
+}
+
+bool CameraPath::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        AZV_LOG_ERROR(General) << "Error: Could not open camera path file: " << path;
+        return false;
+    }
+
+    std::vector<CameraPathSample> loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream in(line);
+        CameraPathSample s;
+        if (!(in >> s.time >> s.position.x >> s.position.y >> s.position.z >> s.yaw >> s.pitch)) {
+            AZV_LOG_ERROR(General) << "Error: Malformed camera path sample at " << path << ":" << lineNumber;
+            return false;
+        }
+        if (!loaded.empty() && s.time < loaded.back().time) {
+            AZV_LOG_ERROR(General) << "Error: Camera path samples out of order at " << path << ":" << lineNumber;
+            return false;
+        }
+        loaded.push_back(s);
+    }
+
+    samples_.swap(loaded);
+    AZV_LOG_INFO(General) << "Loaded camera path with " << samples_.size() << " samples ("
+                          << duration() << " s) from " << path;
+    return true;
+}
@@ -2,26 +2,29 @@
 #include "../headers/world.h" // Include World header for neighbor checks
 #include "../headers/block.h" // Include Block header for Block::isTypeSolid()
 #include "../headers/block_registry.h"
+#include "../headers/profiler.h"
+#include "../headers/logger.h"
+#include "../headers/render_backend.h"
+#include "../headers/mesh_scratch.h"
+#include "../headers/light_engine.h"
 #include <iostream>
 #include <memory>
+#include <algorithm> // For std::fill
 #include <vector>
-#include <glm/gtc/type_ptr.hpp> // For glm::value_ptr
 #include <cmath> // For std::abs in noise generation
 #include <fstream> // For file I/O
 #include <sys/stat.h> // For directory creation (Unix-like systems)
 #include <sstream> // For ostringstream
 #include <chrono> // For timing
 #include <thread> // For std::this_thread
-#include <GLFW/glfw3.h> // Required for glfwGetCurrentContext
 #include <glm/gtc/noise.hpp> // For glm::simplex, if used for spherical terrain
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <filesystem> // For chunk data saving
-#include <GL/glew.h>
 #include <mutex> // For std::mutex
 
 // --- Vertex data for a single block face ---
-// Order: Position (3 floats), Texture Coords (2 floats)
+// Order: Position (3 floats), Texture Coords (2 floats), packed light and occlusion (1 float)
 // We define faces relative to block center (0,0,0), size 1.0
 
 // Vertex positions (relative to block center)
@@ -40,9 +43,390 @@ const glm::vec3 faceVertices[][4] = {
     { {-0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f} }
 };
 
-// Texture coordinates (standard square)
-const glm::vec2 texCoords[] = {
-    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}
+// Face neighbour offsets, in the same order as faceVertices and ChunkNeighbors::faces
+const int neighborOffsets[6][3] = {
+    {0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}
+};
+
+static std::atomic<ChunkMesher> activeMesher{ChunkMesher::BITMASK};
+
+void Chunk::setMesher(ChunkMesher mesher) {
+    activeMesher.store(mesher);
+}
+
+ChunkMesher Chunk::getMesher() {
+    return activeMesher.load();
+}
+
+static std::atomic<bool> ambientOcclusionEnabled{true};
+
+void Chunk::setAmbientOcclusion(bool enabled) {
+    ambientOcclusionEnabled.store(enabled);
+}
+
+bool Chunk::getAmbientOcclusion() {
+    return ambientOcclusionEnabled.load();
+}
+
+// Light baked into faces of an unlit chunk or against a neighbour that is not lit yet: full sky
+constexpr float UNLIT_FACE_LIGHT = static_cast<float>(LightData::MAX_LEVEL << 4);
+
+// Packed light byte of the voxel in front of a face; the face is lit by the air it faces
+class FaceLightSampler {
+public:
+    FaceLightSampler(const LightData* light, const ChunkNeighbors& neighbors) : light_(light), neighbors_(neighbors) {}
+
+    float operator()(int x_local, int y_local, int z_local, int face) const {
+        int nx = x_local + neighborOffsets[face][0];
+        int ny = y_local + neighborOffsets[face][1];
+        int nz = z_local + neighborOffsets[face][2];
+        if (nx >= 0 && nx < CHUNK_SIZE_X && ny >= 0 && ny < CHUNK_SIZE_Y && nz >= 0 && nz < CHUNK_SIZE_Z) {
+            return light_ ? static_cast<float>(light_->values[VoxelData::index(nx, ny, nz)]) : UNLIT_FACE_LIGHT;
+        }
+        const LightSnapshot& neighbor = neighbors_.light[face];
+        if (!neighbor) {
+            return UNLIT_FACE_LIGHT;
+        }
+        return static_cast<float>(neighbor->values[VoxelData::index((nx + CHUNK_SIZE_X) % CHUNK_SIZE_X,
+                                                                    (ny + CHUNK_SIZE_Y) % CHUNK_SIZE_Y,
+                                                                    (nz + CHUNK_SIZE_Z) % CHUNK_SIZE_Z)]);
+    }
+
+private:
+    const LightData* light_;
+    const ChunkNeighbors& neighbors_;
+};
+
+// Append one quad for a visible block face. Vertex indices continue from the vertices already
+// in the output, so sections can be meshed one after another into the same vectors. ao holds the
+// occlusion level of each corner; the quad is split along the diagonal whose corners are the
+// least occluded together, so occlusion interpolates the same way whichever corner it is at.
+static void appendFace(int x_local, int y_local, int z_local, int face, uint16_t blockType, float light,
+                       const uint8_t (&ao)[4], const BlockRegistry& registry, MeshVertexBuffer& vertices, MeshIndexBuffer& indices) {
+    unsigned int vertexIndexOffset = static_cast<unsigned int>(vertices.size() / CHUNK_VERTEX_FLOATS);
+    const BlockFaceUV& uv = registry.getFaceUV(blockType, face);
+    const float us[4] = {uv.u0, uv.u1, uv.u1, uv.u0};
+    const float vs[4] = {uv.v0, uv.v0, uv.v1, uv.v1};
+
+    size_t base = vertices.size();
+    vertices.resize(base + 4 * CHUNK_VERTEX_FLOATS);
+    float* out = vertices.data() + base;
+    for (int i = 0; i < 4; ++i) {
+        *out++ = x_local + faceVertices[face][i][0];
+        *out++ = y_local + faceVertices[face][i][1];
+        *out++ = z_local + faceVertices[face][i][2];
+        *out++ = us[i];
+        *out++ = vs[i];
+        *out++ = light + static_cast<float>(ao[i] * CHUNK_VERTEX_AO_SCALE);
+    }
+    if (ao[0] + ao[2] < ao[1] + ao[3]) {
+        indices.insert(indices.end(), {vertexIndexOffset + 1, vertexIndexOffset + 2, vertexIndexOffset + 3,
+                                       vertexIndexOffset + 3, vertexIndexOffset + 0, vertexIndexOffset + 1});
+    } else {
+        indices.insert(indices.end(), {vertexIndexOffset + 0, vertexIndexOffset + 1, vertexIndexOffset + 2,
+                                       vertexIndexOffset + 2, vertexIndexOffset + 3, vertexIndexOffset + 0});
+    }
+}
+
+struct ChunkFaceMasks;
+
+// Ambient occlusion level of the four corners of a block face, from the opaque blocks in the layer
+// in front of it: the two beside the corner and the one diagonal to it. Reads the padded bitmask
+// classes, so blocks of the edge and corner chunks, which the padding does not hold, never occlude.
+class CornerOcclusion {
+public:
+    explicit CornerOcclusion(const ChunkFaceMasks* masks) : masks_(masks) {} // Null: occlusion off, every corner open
+
+    void operator()(int x_local, int y_local, int z_local, int face, uint8_t (&ao)[4]) const;
+
+private:
+    bool opaque(int x_local, int y_local, int z_local) const;
+
+    const ChunkFaceMasks* masks_;
+};
+
+static void sectionOrigin(int section, int& minX, int& minY, int& minZ) {
+    minX = (section / (CHUNK_SECTIONS_PER_AXIS * CHUNK_SECTIONS_PER_AXIS)) * CHUNK_SECTION_SIZE;
+    minY = (section / CHUNK_SECTIONS_PER_AXIS % CHUNK_SECTIONS_PER_AXIS) * CHUNK_SECTION_SIZE;
+    minZ = (section % CHUNK_SECTIONS_PER_AXIS) * CHUNK_SECTION_SIZE;
+}
+
+// Reference mesher: six neighbour lookups and a shouldRenderFace call per solid voxel
+static void appendSectionFacesPerVoxel(int section, const VoxelData& voxelData, const ChunkNeighbors& neighbors,
+                                       const FaceLightSampler& faceLight, const CornerOcclusion& occlusion,
+                                       MeshVertexBuffer& vertices, MeshIndexBuffer& indices) {
+    BlockRegistry& registry = BlockRegistry::getInstance();
+    int minX, minY, minZ;
+    sectionOrigin(section, minX, minY, minZ);
+
+    for (int x_local = minX; x_local < minX + CHUNK_SECTION_SIZE; ++x_local) {
+        for (int y_local = minY; y_local < minY + CHUNK_SECTION_SIZE; ++y_local) {
+            for (int z_local = minZ; z_local < minZ + CHUNK_SECTION_SIZE; ++z_local) {
+                uint16_t currentBlockType = static_cast<uint16_t>(voxelData.at(x_local, y_local, z_local).type);
+                if (currentBlockType == 0) continue;
+
+                for (int face = 0; face < 6; ++face) {
+                    int nx = x_local + neighborOffsets[face][0];
+                    int ny = y_local + neighborOffsets[face][1];
+                    int nz = z_local + neighborOffsets[face][2];
+                    bool shouldRenderFace = false;
+
+                    if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 || nz >= CHUNK_SIZE_Z) {
+                        // Border face: cull against the neighbouring chunk if its data is known
+                        const VoxelSnapshot& neighbor = neighbors.faces[face];
+                        if (neighbor) {
+                            uint16_t neighborBlockType = static_cast<uint16_t>(neighbor->at((nx + CHUNK_SIZE_X) % CHUNK_SIZE_X,
+                                                                                            (ny + CHUNK_SIZE_Y) % CHUNK_SIZE_Y,
+                                                                                            (nz + CHUNK_SIZE_Z) % CHUNK_SIZE_Z).type);
+                            shouldRenderFace = registry.shouldRenderFace(currentBlockType, neighborBlockType);
+                        } else {
+                            shouldRenderFace = true;
+                        }
+                    } else {
+                        uint16_t neighborBlockType = static_cast<uint16_t>(voxelData.at(nx, ny, nz).type);
+                        shouldRenderFace = registry.shouldRenderFace(currentBlockType, neighborBlockType);
+                    }
+
+                    if (shouldRenderFace) {
+                        uint8_t ao[4];
+                        occlusion(x_local, y_local, z_local, face, ao);
+                        appendFace(x_local, y_local, z_local, face, currentBlockType, faceLight(x_local, y_local, z_local, face),
+                                   ao, registry, vertices, indices);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Per-row occupancy classes for the bitmask mesher. Each word holds one row along Z: bit z + 1
+ * is block z, and bits 0 and 17 are the facing blocks of the -Z / +Z neighbour chunks. The
+ * [x + 1][y + 1] indexing pads X and Y the same way, so the row next to a block in any direction
+ * is a plain array or bit neighbour. Padding that no neighbour chunk fills counts as air, like a
+ * missing neighbour in the reference mesher.
+ *
+ * BlockRegistry::shouldRenderFace(current, neighbor) becomes, for a whole row at once:
+ *   occupied & (air(neighbor) | (solid & transparent(neighbor)))
+ */
+struct ChunkFaceMasks {
+    static constexpr int PADDED = CHUNK_SIZE_X + 2;
+    uint32_t occupied[PADDED][PADDED] = {};    // Non-air, valid block type (emits faces)
+    uint32_t solid[PADDED][PADDED] = {};       // Occupied and solid (also shows faces against transparent blocks)
+    uint32_t air[PADDED][PADDED] = {};
+    uint32_t transparent[PADDED][PADDED] = {};
+    uint32_t opaque[PADDED][PADDED] = {};      // Blocks light; the occluders of ambient occlusion
+};
+
+// Adds one block to the class masks. The registry's property bits are cached for the previous
+// type, since terrain is mostly long runs of the same block.
+class BlockClassifier {
+public:
+    explicit BlockClassifier(ChunkFaceMasks& masks) : masks_(masks), registry_(BlockRegistry::getInstance()) {}
+
+    void add(int type, int x, int y, int bit, bool inner) {
+        const uint32_t mask = 1u << bit;
+        if (type == 0) {
+            masks_.air[x][y] |= mask;
+            return;
+        }
+        if (type != cachedType_) {
+            cachedType_ = type;
+            cachedValid_ = type < BlockRegistry::MAX_BLOCK_TYPES;
+            if (cachedValid_) {
+                cachedSolid_ = registry_.isBlockSolid(static_cast<uint16_t>(type));
+                cachedTransparent_ = registry_.isBlockTransparent(static_cast<uint16_t>(type));
+                cachedOpaque_ = registry_.isBlockOpaque(static_cast<uint16_t>(type));
+            }
+        }
+        if (!cachedValid_) {
+            return; // Invalid ids neither emit nor expose faces
+        }
+        if (cachedTransparent_) {
+            masks_.transparent[x][y] |= mask;
+        }
+        if (cachedOpaque_) {
+            masks_.opaque[x][y] |= mask;
+        }
+        if (inner) {
+            masks_.occupied[x][y] |= mask;
+            if (cachedSolid_) {
+                masks_.solid[x][y] |= mask;
+            }
+        }
+    }
+
+private:
+    ChunkFaceMasks& masks_;
+    const BlockRegistry& registry_;
+    int cachedType_ = 0;
+    bool cachedValid_ = false;
+    bool cachedSolid_ = false;
+    bool cachedTransparent_ = false;
+    bool cachedOpaque_ = false;
+};
+
+static void buildFaceMasks(const VoxelData& voxelData, const ChunkNeighbors& neighbors, ChunkFaceMasks& masks) {
+    static_assert(CHUNK_SIZE_X == CHUNK_SIZE_Y && CHUNK_SIZE_Y == CHUNK_SIZE_Z && CHUNK_SIZE_Z + 2 <= 32,
+                  "bitmask mesher expects cubic chunks whose padded rows fit a 32-bit word");
+    BlockClassifier classifier(masks);
+    const int last = CHUNK_SIZE_X - 1;
+
+    for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+        for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
+            for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                classifier.add(voxelData.at(x, y, z).type, x + 1, y + 1, z + 1, true);
+            }
+        }
+    }
+
+    // Facing layer of each neighbour, placed in the padding next to the blocks it touches
+    for (int face = 0; face < 6; ++face) {
+        const VoxelSnapshot& neighbor = neighbors.faces[face];
+        for (int a = 0; a < CHUNK_SIZE_X; ++a) {
+            for (int b = 0; b < CHUNK_SIZE_X; ++b) {
+                switch (face) {
+                    case 0: // -Z: neighbour's z = 15 in bit 0 of row (a, b)
+                        classifier.add(neighbor ? neighbor->at(a, b, last).type : 0, a + 1, b + 1, 0, false);
+                        break;
+                    case 1: // +Z: neighbour's z = 0 in bit 17
+                        classifier.add(neighbor ? neighbor->at(a, b, 0).type : 0, a + 1, b + 1, CHUNK_SIZE_Z + 1, false);
+                        break;
+                    case 2: // -X: neighbour's x = 15 in row (-1, a)
+                        classifier.add(neighbor ? neighbor->at(last, a, b).type : 0, 0, a + 1, b + 1, false);
+                        break;
+                    case 3: // +X
+                        classifier.add(neighbor ? neighbor->at(0, a, b).type : 0, CHUNK_SIZE_X + 1, a + 1, b + 1, false);
+                        break;
+                    case 4: // -Y: neighbour's y = 15 in row (a, -1)
+                        classifier.add(neighbor ? neighbor->at(a, last, b).type : 0, a + 1, 0, b + 1, false);
+                        break;
+                    case 5: // +Y
+                        classifier.add(neighbor ? neighbor->at(a, 0, b).type : 0, a + 1, CHUNK_SIZE_Y + 1, b + 1, false);
+                        break;
+                }
+            }
+        }
+    }
+}
+
+// Side, side and diagonal occluder of each face corner, as offsets from the block: the face
+// normal plus the corner's direction along each of the face's two axes
+static const auto cornerOccluders = [] {
+    std::array<std::array<std::array<glm::ivec3, 3>, 4>, 6> table{};
+    for (int face = 0; face < 6; ++face) {
+        const glm::ivec3 normal(neighborOffsets[face][0], neighborOffsets[face][1], neighborOffsets[face][2]);
+        for (int corner = 0; corner < 4; ++corner) {
+            glm::ivec3 sides[2];
+            int side = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                if (normal[axis] != 0) continue;
+                sides[side] = glm::ivec3(0);
+                sides[side][axis] = faceVertices[face][corner][axis] > 0.0f ? 1 : -1;
+                ++side;
+            }
+            table[face][corner] = {normal + sides[0], normal + sides[1], normal + sides[0] + sides[1]};
+        }
+    }
+    return table;
+}();
+
+bool CornerOcclusion::opaque(int x_local, int y_local, int z_local) const {
+    return (masks_->opaque[x_local + 1][y_local + 1] >> (z_local + 1)) & 1u;
+}
+
+void CornerOcclusion::operator()(int x_local, int y_local, int z_local, int face, uint8_t (&ao)[4]) const {
+    if (!masks_) {
+        std::fill(std::begin(ao), std::end(ao), static_cast<uint8_t>(CHUNK_VERTEX_AO_OPEN));
+        return;
+    }
+    for (int corner = 0; corner < 4; ++corner) {
+        const auto& occluders = cornerOccluders[face][corner];
+        const int side1 = opaque(x_local + occluders[0].x, y_local + occluders[0].y, z_local + occluders[0].z);
+        const int side2 = opaque(x_local + occluders[1].x, y_local + occluders[1].y, z_local + occluders[1].z);
+        const int diagonal = opaque(x_local + occluders[2].x, y_local + occluders[2].y, z_local + occluders[2].z);
+        // Two sides hide the diagonal block, and the corner is fully occluded whatever it is
+        ao[corner] = static_cast<uint8_t>(side1 && side2 ? 0 : CHUNK_VERTEX_AO_OPEN - (side1 + side2 + diagonal));
+    }
+}
+
+// Bitmask mesher: visible faces of a whole row are computed with a few shifts and masks, and
+// only the set bits are visited
+static void appendSectionFacesBitmask(int section, const VoxelData& voxelData, const ChunkFaceMasks& masks,
+                                      const FaceLightSampler& faceLight, const CornerOcclusion& occlusion,
+                                      MeshVertexBuffer& vertices, MeshIndexBuffer& indices) {
+    const BlockRegistry& registry = BlockRegistry::getInstance();
+    int minX, minY, minZ;
+    sectionOrigin(section, minX, minY, minZ);
+    const uint32_t sectionBits = ((1u << CHUNK_SECTION_SIZE) - 1) << (minZ + 1);
+
+    for (int x_local = minX; x_local < minX + CHUNK_SECTION_SIZE; ++x_local) {
+        for (int y_local = minY; y_local < minY + CHUNK_SECTION_SIZE; ++y_local) {
+            const int px = x_local + 1;
+            const int py = y_local + 1;
+            const uint32_t occupied = masks.occupied[px][py] & sectionBits;
+            if (occupied == 0) continue;
+            const uint32_t solid = masks.solid[px][py];
+
+            // Neighbour row of each face, aligned so bit z + 1 describes the block next to block z
+            const uint32_t neighborAir[6] = {
+                masks.air[px][py] << 1, masks.air[px][py] >> 1,
+                masks.air[px - 1][py], masks.air[px + 1][py],
+                masks.air[px][py - 1], masks.air[px][py + 1]
+            };
+            const uint32_t neighborTransparent[6] = {
+                masks.transparent[px][py] << 1, masks.transparent[px][py] >> 1,
+                masks.transparent[px - 1][py], masks.transparent[px + 1][py],
+                masks.transparent[px][py - 1], masks.transparent[px][py + 1]
+            };
+
+            for (int face = 0; face < 6; ++face) {
+                uint32_t visible = occupied & (neighborAir[face] | (solid & neighborTransparent[face]));
+                while (visible != 0) {
+                    int z_local = countTrailingZeros(visible) - 1;
+                    visible &= visible - 1;
+                    uint16_t blockType = static_cast<uint16_t>(voxelData.at(x_local, y_local, z_local).type);
+                    uint8_t ao[4];
+                    occlusion(x_local, y_local, z_local, face, ao);
+                    appendFace(x_local, y_local, z_local, face, blockType, faceLight(x_local, y_local, z_local, face),
+                               ao, registry, vertices, indices);
+                }
+            }
+        }
+    }
+}
+
+// Builds section meshes with the active mesher. The bitmask classes are computed once and shared
+// by every section meshed through the same instance; they live in a per-thread buffer like the
+// mesh scratch. Ambient occlusion reads them too, so they are built for either mesher when it is on.
+class SectionMesher {
+public:
+    SectionMesher(const VoxelData& voxelData, const LightData* light, const ChunkNeighbors& neighbors)
+        : voxelData_(voxelData), neighbors_(neighbors), faceLight_(light, neighbors), mesher_(Chunk::getMesher()),
+          ambientOcclusion_(Chunk::getAmbientOcclusion()) {}
+
+    void append(int section, MeshVertexBuffer& vertices, MeshIndexBuffer& indices) {
+        if ((mesher_ == ChunkMesher::BITMASK || ambientOcclusion_) && !masks_) {
+            thread_local ChunkFaceMasks threadMasks;
+            masks_ = &threadMasks;
+            *masks_ = ChunkFaceMasks();
+            buildFaceMasks(voxelData_, neighbors_, *masks_);
+        }
+        const CornerOcclusion occlusion(ambientOcclusion_ ? masks_ : nullptr);
+        if (mesher_ == ChunkMesher::PER_VOXEL) {
+            appendSectionFacesPerVoxel(section, voxelData_, neighbors_, faceLight_, occlusion, vertices, indices);
+            return;
+        }
+        appendSectionFacesBitmask(section, voxelData_, *masks_, faceLight_, occlusion, vertices, indices);
+    }
+
+private:
+    const VoxelData& voxelData_;
+    const ChunkNeighbors& neighbors_;
+    FaceLightSampler faceLight_;
+    ChunkMesher mesher_;
+    bool ambientOcclusion_;
+    ChunkFaceMasks* masks_ = nullptr;
 };
 
 Chunk::Chunk(const glm::vec3& position)
@@ -50,12 +434,58 @@ Chunk::Chunk(const glm::vec3& position)
     blocks_.resize(CHUNK_SIZE_X, std::vector<std::vector<std::shared_ptr<Block>>>(
                                    CHUNK_SIZE_Y, std::vector<std::shared_ptr<Block>>(
                                                  CHUNK_SIZE_Z, nullptr)));
-    blockDataForInitialization_.resize(CHUNK_SIZE_X, std::vector<std::vector<BlockInfo>>(
-                                                      CHUNK_SIZE_Y, std::vector<BlockInfo>(
-                                                                    CHUNK_SIZE_Z, BlockInfo())));
+    timeline_.stamp(static_cast<int>(ChunkState::UNINITIALIZED));
     // No planet context by default
 }
 
+void Chunk::transitionTo(ChunkState newState) {
+    timeline_.stamp(static_cast<int>(newState));
+    state_.store(newState);
+}
+
+void VoxelData::rebuildPalette() {
+    // Terrain is long runs of a few types, so a run check and a short linear search beat a
+    // 4096-bit seen set; a version with unusually many types falls back to sort + unique
+    constexpr size_t LINEAR_SEARCH_LIMIT = 64;
+    palette_.clear();
+    int lastType = -1;
+    for (const BlockInfo& voxel : voxels_) {
+        if (voxel.type == lastType) continue;
+        lastType = voxel.type;
+        const uint16_t type = static_cast<uint16_t>(voxel.type);
+        if (palette_.size() > LINEAR_SEARCH_LIMIT) {
+            palette_.push_back(type);
+        } else if (std::find(palette_.begin(), palette_.end(), type) == palette_.end()) {
+            palette_.push_back(type);
+        }
+    }
+    std::sort(palette_.begin(), palette_.end());
+    palette_.erase(std::unique(palette_.begin(), palette_.end()), palette_.end());
+}
+
+bool VoxelData::containsType(uint16_t type) const {
+    return std::binary_search(palette_.begin(), palette_.end(), type);
+}
+
+void Chunk::publishVoxels(std::shared_ptr<VoxelData> voxels) {
+    voxels->rebuildPalette();
+    std::lock_guard<std::mutex> lock(voxelWriteMutex_);
+    VoxelSnapshot current = std::atomic_load(&voxels_);
+    voxels->setVersion(current ? current->getVersion() + 1 : 1);
+    std::atomic_store(&voxels_, VoxelSnapshot(std::move(voxels)));
+}
+
+void Chunk::editVoxels(const std::function<void(VoxelData&)>& edit) {
+    std::lock_guard<std::mutex> lock(voxelWriteMutex_);
+    VoxelSnapshot current = std::atomic_load(&voxels_);
+    // Readers keep the old version; the copy is a few KB and only the writer lock is held for it
+    auto next = current ? std::make_shared<VoxelData>(*current) : std::make_shared<VoxelData>();
+    edit(*next);
+    next->rebuildPalette();
+    next->setVersion(current ? current->getVersion() + 1 : 1);
+    std::atomic_store(&voxels_, VoxelSnapshot(std::move(next)));
+}
+
 Chunk::~Chunk() {
     cleanupMesh();
 }
@@ -81,73 +511,7 @@ void Chunk::renderSurface(const glm::mat4& projection, const glm::mat4& view, bo
     if (surfaceMesh.indexCount == 0 || surfaceMesh.VAO == 0) {
         return; 
     }
-    if (Block::shaderProgram == 0) {
-        return;
-    }
-    while (glGetError() != GL_NO_ERROR) {} // Clear previous OpenGL errors
-    
-    glUseProgram(Block::shaderProgram);
-    
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
-    
-    GLint modelLoc = glGetUniformLocation(Block::shaderProgram, "model");
-    if (modelLoc != -1) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    
-    GLint viewLoc = glGetUniformLocation(Block::shaderProgram, "view");
-    if (viewLoc != -1) glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    
-    GLint projLoc = glGetUniformLocation(Block::shaderProgram, "projection");
-    if (projLoc != -1) glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    
-    GLint useTextureLoc = glGetUniformLocation(Block::shaderProgram, "useTexture");
-    GLint blockColorLoc = glGetUniformLocation(Block::shaderProgram, "blockColor");
-
-    if (wireframeState) {
-        if (useTextureLoc != -1) glUniform1i(useTextureLoc, 0); // Don't use texture in wireframe
-        if (blockColorLoc != -1) {
-            float r = (static_cast<int>(position.x) * 0.1f) + 0.2f;
-            float g = (static_cast<int>(position.z) * 0.1f) + 0.2f;
-            float b = 0.8f;
-            glUniform3f(blockColorLoc, r, g, b); 
-        }
-    } else {
-        if (useTextureLoc != -1) {
-            if (Block::spritesheetLoaded && Block::spritesheetTexture.getID() != 0) {
-                glUniform1i(useTextureLoc, 1); 
-                glActiveTexture(GL_TEXTURE0); 
-                Block::spritesheetTexture.bind(0); 
-                glUniform1i(glGetUniformLocation(Block::shaderProgram, "blockTexture"), 0); 
-            } else {
-                glUniform1i(useTextureLoc, 0); 
-                if (blockColorLoc != -1) {
-                    glUniform3f(blockColorLoc, 0.5f, 0.2f, 0.8f); // Fallback purple
-                }
-            }
-        }
-    }
-    
-    glBindVertexArray(surfaceMesh.VAO);
-    glDrawElements(GL_TRIANGLES, surfaceMesh.indexCount, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-    
-    GLenum error = glGetError();
-    if (error != GL_NO_ERROR) {
-        std::cerr << "OpenGL error after rendering chunk at " << position.x << "," << position.z << ": " << error << std::endl;
-    }
-}
-
-// Render all blocks individually (slow, use only for the current chunk)
-void Chunk::renderAllBlocks(const glm::mat4& projection, const glm::mat4& view) {
-    for (int x = 0; x < CHUNK_SIZE_X; ++x) {
-        for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
-            for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
-                std::shared_ptr<Block> block = getBlockAtLocal(x, y, z);
-                if (block) {
-                    block->render(projection, view); 
-                }
-            }
-        }
-    }
+    RenderBackend::getInstance().renderChunkMesh(surfaceMesh, position, projection, view, wireframeState);
 }
 
 bool Chunk::hasBlockAtLocal(int x, int y, int z) const {
@@ -155,11 +519,12 @@ bool Chunk::hasBlockAtLocal(int x, int y, int z) const {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(dataMutex_);
     if (state_.load() >= ChunkState::DATA_READY) {
-        return blockDataForInitialization_[x][y][z].type != 0;
+        VoxelSnapshot voxels = getVoxelSnapshot();
+        return voxels && voxels->at(x, y, z).type != 0;
     }
-    return blocks_[x][y][z] != nullptr;
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    return !blocks_.empty() && blocks_[x][y][z] != nullptr;
 }
 
 std::shared_ptr<Block> Chunk::getBlockAtLocal(int x, int y, int z) const {
@@ -167,8 +532,23 @@ std::shared_ptr<Block> Chunk::getBlockAtLocal(int x, int y, int z) const {
         return nullptr;
     }
     
+    VoxelSnapshot voxels = getVoxelSnapshot();
     std::lock_guard<std::mutex> lock(dataMutex_);
-    return blocks_[x][y][z];
+    if (blocks_.empty()) {
+        return nullptr;
+    }
+    std::shared_ptr<Block>& block = blocks_[x][y][z];
+    if (!voxels) {
+        return block;
+    }
+    // The voxel version is the truth; bulk edits leave the cached Block of a changed block stale
+    const uint16_t type = static_cast<uint16_t>(voxels->at(x, y, z).type);
+    if (type == 0) {
+        block.reset();
+    } else if (!block || block->getBlockType() != type) {
+        block = std::make_shared<Block>(position + glm::vec3(x, y, z), type, glm::vec3(0.5f), 1.0f);
+    }
+    return block;
 }
 
 void Chunk::setBlockAtLocal(int x, int y, int z, std::shared_ptr<Block> block) {
@@ -176,16 +556,16 @@ void Chunk::setBlockAtLocal(int x, int y, int z, std::shared_ptr<Block> block) {
         return;
     }
     
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    if ((blocks_[x][y][z] == nullptr && block != nullptr) || (blocks_[x][y][z] != nullptr && block == nullptr)) {
-        needsRebuild_.store(true);
-    }
-    blocks_[x][y][z] = block;
-    if (block != nullptr) {
-        blockDataForInitialization_[x][y][z].type = 1; // Example: default to stone if added manually
-    } else {
-        blockDataForInitialization_[x][y][z].type = 0; // Air
+    {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        if (blocks_.empty()) {
+            return; // Compressed or not generated yet; nothing to edit
+        }
+        blocks_[x][y][z] = block;
     }
+    // Default to stone if a block without a registered type is added manually
+    uint16_t type = block == nullptr ? 0 : (block->getBlockType() != 0 ? block->getBlockType() : 1);
+    writeVoxel(x, y, z, type);
 }
 
 void Chunk::removeBlockAtLocal(int x, int y, int z) {
@@ -193,28 +573,131 @@ void Chunk::removeBlockAtLocal(int x, int y, int z) {
         return;
     }
     
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    if (blocks_[x][y][z] != nullptr) {
+    {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        if (blocks_.empty() || blocks_[x][y][z] == nullptr) {
+            return;
+        }
         blocks_[x][y][z] = nullptr;
-        blockDataForInitialization_[x][y][z].type = 0; // Air
-        needsRebuild_.store(true);
     }
+    writeVoxel(x, y, z, 0); // Air
 }
 
-void Chunk::cleanupMesh() {
-    if (surfaceMesh.VAO != 0) {
-        glDeleteVertexArrays(1, &surfaceMesh.VAO);
-        surfaceMesh.VAO = 0;
+bool Chunk::setBlockTypeAtLocal(int x, int y, int z, uint16_t blockType) {
+    if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
+        return false;
+    }
+    // Before DATA_READY a worker is about to publish the generated version over any edit
+    if (state_.load() < ChunkState::DATA_READY) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        if (blocks_.empty()) {
+            return false;
+        }
+        blocks_[x][y][z] = blockType != 0
+            ? std::make_shared<Block>(position + glm::vec3(x, y, z), blockType, glm::vec3(0.5f), 1.0f)
+            : nullptr;
+    }
+    return writeVoxel(x, y, z, blockType);
+}
+
+bool Chunk::writeVoxel(int x, int y, int z, uint16_t blockType) {
+    VoxelSnapshot current = getVoxelSnapshot();
+    if (current && current->at(x, y, z).type == blockType) {
+        return false;
+    }
+    editVoxels([&](VoxelData& voxels) { voxels.at(x, y, z).type = blockType; });
+
+    // The edited block's faces and the faces of its six neighbours that face it can change, and
+    // with ambient occlusion the corners of every block around it that it shades; neighbours
+    // outside this chunk are the caller's (Planet's) to mark
+    const bool ambientOcclusion = getAmbientOcclusion();
+    uint32_t sections = 0;
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dz = -1; dz <= 1; ++dz) {
+                int nx = x + dx;
+                int ny = y + dy;
+                int nz = z + dz;
+                if (!ambientOcclusion && std::abs(dx) + std::abs(dy) + std::abs(dz) > 1) continue;
+                if (nx >= 0 && nx < CHUNK_SIZE_X && ny >= 0 && ny < CHUNK_SIZE_Y && nz >= 0 && nz < CHUNK_SIZE_Z) {
+                    sections |= 1u << sectionIndex(nx, ny, nz);
+                }
+            }
+        }
+    }
+    dirtySections_.fetch_or(sections);
+    return true;
+}
+
+size_t Chunk::publishBlockChanges(const std::vector<BlockChange>& changes, size_t firstChange) {
+    const size_t changed = changes.size() - firstChange;
+    if (changed == 0) {
+        return 0;
+    }
+    glm::ivec3 changedMin(CHUNK_SIZE_X);
+    glm::ivec3 changedMax(-1);
+    editVoxels([&](VoxelData& voxels) {
+        for (size_t i = firstChange; i < changes.size(); ++i) {
+            const glm::ivec3 local(changes[i].index / (CHUNK_SIZE_Y * CHUNK_SIZE_Z), changes[i].index / CHUNK_SIZE_Z % CHUNK_SIZE_Y,
+                                   changes[i].index % CHUNK_SIZE_Z);
+            voxels.at(local.x, local.y, local.z).type = changes[i].newType;
+            changedMin = glm::min(changedMin, local);
+            changedMax = glm::max(changedMax, local);
+        }
+    });
+    // The same one-block reach as writeVoxel, over the bounds of the changes. The Block objects
+    // of changed blocks are left stale; getBlockAtLocal rebuilds them when they are asked for.
+    markDirtyInBox(changedMin - 1, changedMax + 1);
+    return changed;
+}
+
+void Chunk::takeLightSpills(std::vector<LightSeed>& out) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    out.insert(out.end(), lightSpills_.begin(), lightSpills_.end());
+    lightSpills_.clear();
+    const VoxelSnapshot current = getVoxelSnapshot();
+    if (litVoxels_ && current && current != litVoxels_) {
+        for (size_t i = 0; i < VoxelData::VOLUME; ++i) {
+            if (current->atIndex(i).type != litVoxels_->atIndex(i).type) {
+                LightSeed seed;
+                seed.index = static_cast<uint16_t>(i);
+                out.push_back(seed);
+            }
+        }
     }
-    if (surfaceMesh.VBO != 0) {
-        glDeleteBuffers(1, &surfaceMesh.VBO);
-        surfaceMesh.VBO = 0;
+    litVoxels_.reset();
+}
+
+void Chunk::markAllSectionsDirty() {
+    dirtySections_.fetch_or((1u << CHUNK_SECTION_COUNT) - 1);
+}
+
+void Chunk::markDirtyAt(int x, int y, int z) {
+    if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
+        return;
     }
-    if (surfaceMesh.EBO != 0) {
-        glDeleteBuffers(1, &surfaceMesh.EBO);
-        surfaceMesh.EBO = 0;
+    dirtySections_.fetch_or(1u << sectionIndex(x, y, z));
+}
+
+void Chunk::markDirtyInBox(const glm::ivec3& localMin, const glm::ivec3& localMax) {
+    const glm::ivec3 lo = glm::max(localMin, glm::ivec3(0)) / CHUNK_SECTION_SIZE;
+    const glm::ivec3 hi = glm::min(localMax, glm::ivec3(CHUNK_SIZE_X - 1, CHUNK_SIZE_Y - 1, CHUNK_SIZE_Z - 1)) / CHUNK_SECTION_SIZE;
+    uint32_t sections = 0;
+    for (int x = lo.x; x <= hi.x; ++x) {
+        for (int y = lo.y; y <= hi.y; ++y) {
+            for (int z = lo.z; z <= hi.z; ++z) {
+                sections |= 1u << sectionIndex(x * CHUNK_SECTION_SIZE, y * CHUNK_SECTION_SIZE, z * CHUNK_SECTION_SIZE);
+            }
+        }
     }
-    surfaceMesh.indexCount = 0;
+    dirtySections_.fetch_or(sections);
+}
+
+void Chunk::cleanupMesh() {
+    RenderBackend::getInstance().releaseChunkMesh(surfaceMesh);
     
     meshVertices.clear();
     meshIndices.clear();
@@ -226,6 +709,140 @@ glm::vec3 Chunk::getPosition() const {
     return position;
 }
 
+size_t Chunk::getMeshDataBytes() const {
+    std::lock_guard<std::mutex> lock(meshMutex_);
+    return meshVertices.size() * sizeof(float) + meshIndices.size() * sizeof(unsigned int);
+}
+
+void Chunk::copyMeshData(std::vector<float>& vertices, std::vector<unsigned int>& indices) const {
+    std::lock_guard<std::mutex> lock(meshMutex_);
+    vertices = meshVertices;
+    indices = meshIndices;
+}
+
+size_t Chunk::getVoxelDataBytes() const {
+    VoxelSnapshot voxels = getVoxelSnapshot();
+    if (!voxels) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    size_t bytes = voxels->memoryBytes();
+    if (getLightSnapshot()) {
+        bytes += sizeof(LightData);
+    }
+    if (!blocks_.empty()) {
+        bytes += VoxelData::VOLUME * sizeof(std::shared_ptr<Block>);
+    }
+    for (const auto& plane : blocks_) {
+        for (const auto& column : plane) {
+            for (const auto& block : column) {
+                if (block) {
+                    bytes += sizeof(Block) + 2 * sizeof(void*); // Object plus shared_ptr control block
+                }
+            }
+        }
+    }
+    return bytes;
+}
+
+size_t Chunk::getCompressedDataBytes() const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    return compressedVoxels_.capacity() * sizeof(uint16_t);
+}
+
+bool Chunk::isCompressed() const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    return !compressedVoxels_.empty();
+}
+
+bool Chunk::releaseGpuMesh() {
+    ChunkState expected = ChunkState::FULLY_INITIALIZED;
+    if (!state_.compare_exchange_strong(expected, ChunkState::OPENGL_INITIALIZING)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> meshLock(meshMutex_);
+        RenderBackend::getInstance().releaseChunkMesh(surfaceMesh);
+    }
+    // Residency time is not pipeline latency; only stages after the restore are measured
+    timeline_.clear();
+    transitionTo(ChunkState::MESH_READY);
+    return true;
+}
+
+bool Chunk::releaseCpuMesh() {
+    ChunkState expected = ChunkState::MESH_READY;
+    if (!state_.compare_exchange_strong(expected, ChunkState::MESH_BUILDING)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> meshLock(meshMutex_);
+        std::vector<float>().swap(meshVertices);
+        std::vector<unsigned int>().swap(meshIndices);
+    }
+    {
+        // Block objects are materialized again at upload time
+        std::lock_guard<std::mutex> dataLock(dataMutex_);
+        for (auto& plane : blocks_) {
+            for (auto& column : plane) {
+                std::fill(column.begin(), column.end(), nullptr);
+            }
+        }
+    }
+    needsRebuild_.store(true);
+    timeline_.clear();
+    transitionTo(ChunkState::DATA_READY);
+    return true;
+}
+
+bool Chunk::compressVoxelData() {
+    ChunkState expected = ChunkState::DATA_READY;
+    if (!state_.compare_exchange_strong(expected, ChunkState::DATA_GENERATING)) {
+        return false;
+    }
+    {
+        VoxelSnapshot voxels = getVoxelSnapshot();
+        std::vector<uint16_t> encoded;
+        uint16_t runType = 0;
+        uint16_t runLength = 0;
+        for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+            for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
+                for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                    uint16_t type = voxels ? static_cast<uint16_t>(voxels->at(x, y, z).type) : 0;
+                    if (runLength > 0 && type == runType) {
+                        ++runLength;
+                    } else {
+                        if (runLength > 0) {
+                            encoded.push_back(runLength);
+                            encoded.push_back(runType);
+                        }
+                        runType = type;
+                        runLength = 1;
+                    }
+                }
+            }
+        }
+        encoded.push_back(runLength);
+        encoded.push_back(runType);
+        encoded.shrink_to_fit();
+
+        std::lock_guard<std::mutex> dataLock(dataMutex_);
+        compressedVoxels_.swap(encoded);
+        std::vector<std::vector<std::vector<std::shared_ptr<Block>>>>().swap(blocks_);
+        std::vector<LightSeed>().swap(lightSpills_);
+        litVoxels_.reset();
+    }
+    {
+        std::lock_guard<std::mutex> writeLock(voxelWriteMutex_);
+        std::atomic_store(&voxels_, VoxelSnapshot());
+    }
+    // Light is derived data too; the chunk is lit again by its next mesh build
+    publishLight(LightSnapshot());
+    timeline_.clear();
+    state_.store(ChunkState::UNINITIALIZED);
+    return true;
+}
+
 std::string Chunk::getChunkFileName() const {
     std::ostringstream oss;
     oss << "chunk_" << static_cast<int>(position.x) << "_" 
@@ -242,14 +859,18 @@ bool Chunk::saveToFile(const std::string& directoryPath) const {
     std::string filePath = directoryPath + "/" + getChunkFileName();
     std::ofstream outFile(filePath, std::ios::binary);
     if (!outFile.is_open()) {
-        std::cerr << "Error: Could not open file for saving chunk: " << filePath << std::endl;
+        AZV_LOG_ERROR(Generation) << "Error: Could not open file for saving chunk: " << filePath;
         return false;
     }
 
+    VoxelSnapshot voxels = getVoxelSnapshot();
+    if (!voxels) {
+        return false;
+    }
     for (int x = 0; x < CHUNK_SIZE_X; ++x) {
         for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
             for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
-                outFile.write(reinterpret_cast<const char*>(&blockDataForInitialization_[x][y][z].type), sizeof(BlockInfo::type));
+                outFile.write(reinterpret_cast<const char*>(&voxels->at(x, y, z).type), sizeof(BlockInfo::type));
             }
         }
     }
@@ -257,6 +878,7 @@ bool Chunk::saveToFile(const std::string& directoryPath) const {
 }
 
 bool Chunk::loadFromFile_DataOnly(const std::string& directoryPath, World* /*world*/) {
+    AZV_PROFILE_ZONE("Chunk::loadFromFile_DataOnly");
     std::string filePath = directoryPath + "/" + getChunkFileName();
     struct stat buffer;
     if (stat(filePath.c_str(), &buffer) != 0) return false; 
@@ -272,22 +894,24 @@ bool Chunk::loadFromFile_DataOnly(const std::string& directoryPath, World* /*wor
     constexpr size_t total_expected_bytes = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z * expected_size_per_block;
 
     if (size != total_expected_bytes) {
-        std::cerr << "Error: File size mismatch for chunk " << filePath 
-                  << ". Expected " << total_expected_bytes << " bytes, got " << size << std::endl;
+        AZV_LOG_ERROR(Generation) << "Error: File size mismatch for chunk " << filePath 
+                                  << ". Expected " << total_expected_bytes << " bytes, got " << size;
         return false;
     }
     
+    auto voxels = std::make_shared<VoxelData>();
     for (int x = 0; x < CHUNK_SIZE_X; ++x) {
         for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
             for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
-                inFile.read(reinterpret_cast<char*>(&blockDataForInitialization_[x][y][z].type), sizeof(BlockInfo::type));
+                inFile.read(reinterpret_cast<char*>(&voxels->at(x, y, z).type), sizeof(BlockInfo::type));
                 if (inFile.fail()) {
-                    std::cerr << "Error reading block data for chunk " << filePath << std::endl;
+                    AZV_LOG_ERROR(Generation) << "Error reading block data for chunk " << filePath;
                     return false;
                 }
             }
         }
     }
+    publishVoxels(std::move(voxels));
     needsRebuild_.store(true);
     return true; 
 }
@@ -300,12 +924,6 @@ void Chunk::ensureInitialized(const World* world, int seed, const std::optional<
     std::optional<glm::vec3> pCenter = planetCenter.has_value() ? planetCenter : planetCenter_;
     std::optional<float> pRadius = planetRadius.has_value() ? planetRadius : planetRadius_;
 
-    if (blockDataForInitialization_.empty() || blockDataForInitialization_.size() != CHUNK_SIZE_X) { 
-        blockDataForInitialization_.resize(CHUNK_SIZE_X,
-                                 std::vector<std::vector<BlockInfo>>(
-                                     CHUNK_SIZE_Y,
-                                     std::vector<BlockInfo>(CHUNK_SIZE_Z)));
-    }
     if (blocks_.empty() || blocks_.size() != CHUNK_SIZE_X) { 
         blocks_.resize(CHUNK_SIZE_X, std::vector<std::vector<std::shared_ptr<Block>>>(
                                CHUNK_SIZE_Y, std::vector<std::shared_ptr<Block>>(
@@ -317,11 +935,12 @@ void Chunk::ensureInitialized(const World* world, int seed, const std::optional<
         std::string worldDataPath = "chunk_data/" + world->getWorldName();
         loadedFromFile = loadFromFile_DataOnly(worldDataPath, const_cast<World*>(world));
         if (loadedFromFile) {
-            std::cout << "✓ LEGACY_LOAD: Chunk " << position.x << "," << position.y << "," << position.z << " from file (ensureInitialized)" << std::endl;
+            AZV_LOG_DEBUG(Generation) << "✓ LEGACY_LOAD: Chunk " << position.x << "," << position.y << "," << position.z << " from file (ensureInitialized)";
+            VoxelSnapshot voxels = getVoxelSnapshot();
             for (int x_local = 0; x_local < CHUNK_SIZE_X; ++x_local) {
                 for (int y_local = 0; y_local < CHUNK_SIZE_Y; ++y_local) {
                     for (int z_local = 0; z_local < CHUNK_SIZE_Z; ++z_local) {
-                        uint16_t blockTypeId = static_cast<uint16_t>(blockDataForInitialization_[x_local][y_local][z_local].type);
+                        uint16_t blockTypeId = static_cast<uint16_t>(voxels->at(x_local, y_local, z_local).type);
                         glm::vec3 blockWorldPos = position + glm::vec3(x_local, y_local, z_local);
                         if (blockTypeId != 0) {
                             blocks_[x_local][y_local][z_local] = std::make_shared<Block>(blockWorldPos, blockTypeId, glm::vec3(0.5f), 1.0f);
@@ -332,40 +951,36 @@ void Chunk::ensureInitialized(const World* world, int seed, const std::optional<
                 }
             }
         } else {
-            std::cout << "✗ LEGACY_LOAD_FAIL: Chunk " << position.x << "," << position.y << "," << position.z << " not found (ensureInitialized)" << std::endl;
+            AZV_LOG_DEBUG(Generation) << "✗ LEGACY_LOAD_FAIL: Chunk " << position.x << "," << position.y << "," << position.z << " not found (ensureInitialized)";
         }
     }
 
     if (!loadedFromFile) {
-        std::cout << "⚡ LEGACY_GEN: Chunk " << position.x << "," << position.y << "," << position.z << " (ensureInitialized)" << std::endl;
+        AZV_LOG_DEBUG(Generation) << "⚡ LEGACY_GEN: Chunk " << position.x << "," << position.y << "," << position.z << " (ensureInitialized)";
         generateTerrain(seed, pCenter, pRadius); // Calls old generateTerrain
         if (world) {
             std::string worldDataPath = "chunk_data/" + world->getWorldName();
             if (saveToFile(worldDataPath)) {
-                std::cout << "💾 LEGACY_SAVE: Chunk " << position.x << "," << position.y << "," << position.z << " (ensureInitialized)" << std::endl;
+                AZV_LOG_DEBUG(Generation) << "💾 LEGACY_SAVE: Chunk " << position.x << "," << position.y << "," << position.z << " (ensureInitialized)";
             } else {
-                std::cerr << "❌ LEGACY_SAVE_FAIL: Chunk " << position.x << "," << position.y << "," << position.z << " (ensureInitialized)" << std::endl;
+                AZV_LOG_ERROR(Generation) << "❌ LEGACY_SAVE_FAIL: Chunk " << position.x << "," << position.y << "," << position.z << " (ensureInitialized)";
             }
         }
     }
 
+    clearDirtySections(); // No neighbour snapshots to keep in step with
     buildSurfaceMesh(world, pCenter, pRadius);
     openglInitialize(const_cast<World*>(world)); // Call legacy GL init. It will set state if successful.
     needsRebuild_.store(false);
 }
 
 void Chunk::generateTerrain(int seed, const std::optional<glm::vec3>& pCenterOpt, const std::optional<float>& pRadiusOpt) {
-    std::cout << "Chunk at " << position.x << "," << position.y << "," << position.z << " generateTerrain. Planet context: " << (pCenterOpt.has_value() ? "Yes" : "No") << std::endl;
+    AZV_LOG_DEBUG(Generation) << "Chunk at " << position.x << "," << position.y << "," << position.z << " generateTerrain. Planet context: " << (pCenterOpt.has_value() ? "Yes" : "No");
 
     // Get reference to the block registry
     BlockRegistry& registry = BlockRegistry::getInstance();
 
-    if (blockDataForInitialization_.empty() || blockDataForInitialization_.size() != CHUNK_SIZE_X ) { 
-        blockDataForInitialization_.resize(CHUNK_SIZE_X,
-                                 std::vector<std::vector<BlockInfo>>(
-                                     CHUNK_SIZE_Y,
-                                     std::vector<BlockInfo>(CHUNK_SIZE_Z)));
-    }
+    auto voxels = std::make_shared<VoxelData>();
     if (blocks_.empty() || blocks_.size() != CHUNK_SIZE_X) { 
         blocks_.resize(CHUNK_SIZE_X, std::vector<std::vector<std::shared_ptr<Block>>>(
                                CHUNK_SIZE_Y, std::vector<std::shared_ptr<Block>>(
@@ -374,7 +989,7 @@ void Chunk::generateTerrain(int seed, const std::optional<glm::vec3>& pCenterOpt
 
     if (!pCenterOpt.has_value() || !pRadiusOpt.has_value()) {
         // Fallback to original flat terrain generation logic
-        std::cout << "Generating flat terrain for chunk at (" << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
+        AZV_LOG_DEBUG(Generation) << "Generating flat terrain for chunk at (" << position.x << ", " << position.y << ", " << position.z << ")";
         std::vector<int> heightMap(CHUNK_SIZE_X * CHUNK_SIZE_Z);
         for (int x_local = 0; x_local < CHUNK_SIZE_X; x_local++) {
             for (int z_local = 0; z_local < CHUNK_SIZE_Z; z_local++) {
@@ -403,7 +1018,7 @@ void Chunk::generateTerrain(int seed, const std::optional<glm::vec3>& pCenterOpt
                         blockTypeId = registry.getBlockId("azurevoxel:grass");
                     }
                     
-                    blockDataForInitialization_[x_local][y_local][z_local].type = static_cast<unsigned char>(blockTypeId);
+                    voxels->at(x_local, y_local, z_local).type = static_cast<unsigned char>(blockTypeId);
                     
                     if (blockTypeId != 0) {
                         blocks_[x_local][y_local][z_local] = std::make_shared<Block>(blockWorldPos, blockTypeId, glm::vec3(0.5f), 1.0f);
@@ -413,13 +1028,14 @@ void Chunk::generateTerrain(int seed, const std::optional<glm::vec3>& pCenterOpt
                 }
             }
         }
+        publishVoxels(std::move(voxels));
         return;
     }
 
     // Spherical generation logic with biome-aware block selection
     const glm::vec3& planetCenter = pCenterOpt.value();
     const float planetRadius = pRadiusOpt.value();
-    std::cout << "Generating spherical terrain for chunk. Planet R: " << planetRadius << " Center: (" << planetCenter.x << "," << planetCenter.y << "," << planetCenter.z << ")" << std::endl;
+    AZV_LOG_DEBUG(Generation) << "Generating spherical terrain for chunk. Planet R: " << planetRadius << " Center: (" << planetCenter.x << "," << planetCenter.y << "," << planetCenter.z << ")";
     
     // Noise parameters for variety
     float elevationNoiseScale = 0.02f; // Controls variation in "surface" height
@@ -620,7 +1236,7 @@ void Chunk::generateTerrain(int seed, const std::optional<glm::vec3>& pCenterOpt
                     }
                 }
 
-                blockDataForInitialization_[x_local][y_local][z_local].type = static_cast<unsigned char>(blockTypeId);
+                voxels->at(x_local, y_local, z_local).type = static_cast<unsigned char>(blockTypeId);
                 if (blockTypeId != 0) {
                     blocks_[x_local][y_local][z_local] = std::make_shared<Block>(position + glm::vec3(x_local,y_local,z_local), blockTypeId, glm::vec3(0.5f), 1.0f);
                 } else {
@@ -629,260 +1245,184 @@ void Chunk::generateTerrain(int seed, const std::optional<glm::vec3>& pCenterOpt
             }
         }
     }
+    publishVoxels(std::move(voxels));
 }
 
 // This is the single, complete definition of buildSurfaceMesh
-void Chunk::buildSurfaceMesh(const World* /*world*/, const std::optional<glm::vec3>& pCenterOpt, const std::optional<float>& pRadiusOpt) {
-    std::lock_guard<std::mutex> meshLock(meshMutex_);
-    std::lock_guard<std::mutex> dataLock(dataMutex_);
-    
-    cleanupMesh(); 
-    meshVertices.clear();
-    meshIndices.clear();
-    unsigned int vertexIndexOffset = 0;
-
-    // Get reference to the block registry
-    BlockRegistry& registry = BlockRegistry::getInstance();
-
-    if (blockDataForInitialization_.empty() || blockDataForInitialization_.size() != CHUNK_SIZE_X ) { 
-        blockDataForInitialization_.resize(CHUNK_SIZE_X,
-                                 std::vector<std::vector<BlockInfo>>(
-                                     CHUNK_SIZE_Y,
-                                     std::vector<BlockInfo>(CHUNK_SIZE_Z)));
+void Chunk::buildSurfaceMesh(const World* /*world*/, const std::optional<glm::vec3>& pCenterOpt, const std::optional<float>& pRadiusOpt,
+                             const ChunkNeighbors& neighbors) {
+    AZV_PROFILE_ZONE("Chunk::buildSurfaceMesh");
+    // Mesh an immutable snapshot without holding any chunk lock. The dirty bits were cleared
+    // when the build was dispatched, together with gathering neighbors; edits published since
+    // set them again and are picked up by rebuildDirtySections.
+    const VoxelSnapshot published = getVoxelSnapshot();
+    const VoxelSnapshot voxels = published ? published : std::make_shared<const VoxelData>();
+    // The first build lights the chunk; afterwards the light engine keeps its light current
+    LightSnapshot light = getLightSnapshot();
+    if (!light) {
+        auto lit = std::make_shared<LightData>();
+        std::vector<LightSeed> spills;
+        LightEngine::lightChunk(*voxels, neighbors, skyContextForChunk(position, pCenterOpt, pRadiusOpt), *lit, &spills);
+        light = lit;
+        publishLight(light);
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        lightSpills_.swap(spills);
+        litVoxels_ = voxels;
     }
-
-    const int neighborOffsets[6][3] = {
-        {0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}
-    };
+    // Mesh into this thread's scratch arena and keep an exact-size copy
+    MeshScratch& scratch = MeshScratch::begin();
+    MeshVertexBuffer& vertices = scratch.vertices;
+    MeshIndexBuffer& indices = scratch.indices;
+    std::array<MeshSectionRange, CHUNK_SECTION_COUNT> ranges;
+    SectionMesher mesher(*voxels, light.get(), neighbors);
 
     if (!pCenterOpt.has_value() || !pRadiusOpt.has_value()) {
-        // Fallback to original flat terrain meshing logic
-        std::cout << "Building flat mesh for chunk at (" << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
-        for (int x_local = 0; x_local < CHUNK_SIZE_X; ++x_local) {
-            for (int y_local = 0; y_local < CHUNK_SIZE_Y; ++y_local) {
-                for (int z_local = 0; z_local < CHUNK_SIZE_Z; ++z_local) {
-                    // Thread-safe block check using data directly
-                    if (blockDataForInitialization_[x_local][y_local][z_local].type == 0) continue;
-
-                    for (int face = 0; face < 6; ++face) {
-                        int nx = x_local + neighborOffsets[face][0];
-                        int ny = y_local + neighborOffsets[face][1];
-                        int nz = z_local + neighborOffsets[face][2];
-                        bool shouldRenderFace = false;
-
-                        uint16_t currentBlockType = static_cast<uint16_t>(blockDataForInitialization_[x_local][y_local][z_local].type);
-                        if (currentBlockType == 0) continue; // Should not happen if check above was true, but defensive
-
-                        if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 || nz >= CHUNK_SIZE_Z) {
-                            shouldRenderFace = true; 
-                        } else {
-                            uint16_t neighborBlockType = static_cast<uint16_t>(blockDataForInitialization_[nx][ny][nz].type);
-                            shouldRenderFace = registry.shouldRenderFace(currentBlockType, neighborBlockType);
-                        }
-
-                        if (shouldRenderFace) {
-                            const BlockRenderData& renderData = registry.getRenderData(currentBlockType);
-                            uint16_t textureIndex = renderData.texture_atlas_index;
-                            int texturesPerRow = 10;
-                            float textureSize = 80.0f; 
-                            int texX = textureIndex % texturesPerRow;
-                            int texY = textureIndex / texturesPerRow;
-                            float uvPixelOffsetX = texX * textureSize;
-                            float uvPixelOffsetY = texY * textureSize;
-
-                            for (int i = 0; i < 4; ++i) {
-                                meshVertices.push_back(x_local + faceVertices[face][i][0]);
-                                meshVertices.push_back(y_local + faceVertices[face][i][1]);
-                                meshVertices.push_back(z_local + faceVertices[face][i][2]);
-                                if (Block::spritesheetLoaded && Block::spritesheetTexture.getWidth() > 0) {
-                                    meshVertices.push_back((uvPixelOffsetX + texCoords[i].x * textureSize) / Block::spritesheetTexture.getWidth());
-                                    meshVertices.push_back((uvPixelOffsetY + texCoords[i].y * textureSize) / Block::spritesheetTexture.getHeight());
-                                } else {
-                                    meshVertices.push_back(texCoords[i].x); 
-                                    meshVertices.push_back(texCoords[i].y);
-                                }
-                            }
-                            meshIndices.push_back(vertexIndexOffset + 0); meshIndices.push_back(vertexIndexOffset + 1); meshIndices.push_back(vertexIndexOffset + 2);
-                            meshIndices.push_back(vertexIndexOffset + 2); meshIndices.push_back(vertexIndexOffset + 3); meshIndices.push_back(vertexIndexOffset + 0);
-                            vertexIndexOffset += 4;
-                        }
-                    }
-                }
-            }
-        }
+        AZV_LOG_DEBUG(Meshing) << "Building flat mesh for chunk at (" << position.x << ", " << position.y << ", " << position.z << ")";
     } else {
-        const glm::vec3& planetCenter = pCenterOpt.value();
-        const float planetRadius = pRadiusOpt.value();
-        std::cout << "Building spherical mesh for chunk. Planet R: " << planetRadius << " Chunk Pos: (" << position.x << "," << position.y << "," << position.z << ")" << std::endl;
-
-        for (int x_loc = 0; x_loc < CHUNK_SIZE_X; ++x_loc) {
-            for (int y_loc = 0; y_loc < CHUNK_SIZE_Y; ++y_loc) {
-                for (int z_loc = 0; z_loc < CHUNK_SIZE_Z; ++z_loc) {
-                    if (blockDataForInitialization_[x_loc][y_loc][z_loc].type == 0) continue;
-
-                    for (int face = 0; face < 6; ++face) {
-                        int nx_loc = x_loc + neighborOffsets[face][0];
-                        int ny_loc = y_loc + neighborOffsets[face][1];
-                        int nz_loc = z_loc + neighborOffsets[face][2];
-                        bool shouldRenderFace = false;
-                        uint16_t currentBlockType = static_cast<uint16_t>(blockDataForInitialization_[x_loc][y_loc][z_loc].type);
-                        if (currentBlockType == 0) continue; 
-
-                        if (nx_loc < 0 || nx_loc >= CHUNK_SIZE_X || ny_loc < 0 || ny_loc >= CHUNK_SIZE_Y || nz_loc < 0 || nz_loc >= CHUNK_SIZE_Z) {
-                            glm::vec3 neighborBlockWorldCenter = position + glm::vec3(nx_loc + 0.5f, ny_loc + 0.5f, nz_loc + 0.5f);
-                            if (glm::length(neighborBlockWorldCenter - planetCenter) > planetRadius) {
-                                shouldRenderFace = true; 
-                            } else {
-                                shouldRenderFace = true; 
-                            }
-                        } else {
-                            uint16_t neighborBlockType = static_cast<uint16_t>(blockDataForInitialization_[nx_loc][ny_loc][nz_loc].type);
-                            shouldRenderFace = registry.shouldRenderFace(currentBlockType, neighborBlockType);
-                        }
+        AZV_LOG_DEBUG(Meshing) << "Building spherical mesh for chunk. Planet R: " << pRadiusOpt.value() << " Chunk Pos: (" << position.x << "," << position.y << "," << position.z << ")";
+    }
+    for (int section = 0; section < CHUNK_SECTION_COUNT; ++section) {
+        MeshSectionRange& range = ranges[section];
+        range.firstVertex = static_cast<uint32_t>(vertices.size() / CHUNK_VERTEX_FLOATS);
+        range.firstIndex = static_cast<uint32_t>(indices.size());
+        mesher.append(section, vertices, indices);
+        range.vertexCount = static_cast<uint32_t>(vertices.size() / CHUNK_VERTEX_FLOATS) - range.firstVertex;
+        range.indexCount = static_cast<uint32_t>(indices.size()) - range.firstIndex;
+    }
 
-                        if (shouldRenderFace) {
-                            const BlockRenderData& renderData = registry.getRenderData(currentBlockType);
-                            uint16_t textureIndex = renderData.texture_atlas_index;
-                            int texturesPerRow = 10;
-                            float textureSize = 80.0f; 
-                            int texX = textureIndex % texturesPerRow;
-                            int texY = textureIndex / texturesPerRow;
-                            float uvPixelOffsetX = texX * textureSize;
-                            float uvPixelOffsetY = texY * textureSize;
-
-                            for (int i = 0; i < 4; ++i) {
-                                glm::vec3 localFaceVertexPos = glm::vec3(x_loc + faceVertices[face][i][0],
-                                                                   y_loc + faceVertices[face][i][1],
-                                                                   z_loc + faceVertices[face][i][2]);
-                                meshVertices.push_back(localFaceVertexPos.x);
-                                meshVertices.push_back(localFaceVertexPos.y);
-                                meshVertices.push_back(localFaceVertexPos.z);
-
-                                if (Block::spritesheetLoaded && Block::spritesheetTexture.getWidth() > 0) {
-                                    meshVertices.push_back((uvPixelOffsetX + texCoords[i].x * textureSize) / Block::spritesheetTexture.getWidth());
-                                    meshVertices.push_back((uvPixelOffsetY + texCoords[i].y * textureSize) / Block::spritesheetTexture.getHeight());
-                                } else {
-                                    meshVertices.push_back(texCoords[i].x);
-                                    meshVertices.push_back(texCoords[i].y);
-                                }
-                            }
-                            meshIndices.push_back(vertexIndexOffset + 0); meshIndices.push_back(vertexIndexOffset + 1); meshIndices.push_back(vertexIndexOffset + 2);
-                            meshIndices.push_back(vertexIndexOffset + 2); meshIndices.push_back(vertexIndexOffset + 3); meshIndices.push_back(vertexIndexOffset + 0);
-                            vertexIndexOffset += 4;
-                        }
-                    }
-                }
+    size_t vertexCount = vertices.size() / CHUNK_VERTEX_FLOATS;
+    size_t indexCount = indices.size();
+    std::vector<float> finalVertices(vertices.begin(), vertices.end());
+    std::vector<unsigned int> finalIndices(indices.begin(), indices.end());
+    scratch.end();
+    {
+        std::lock_guard<std::mutex> meshLock(meshMutex_);
+        cleanupMesh();
+        meshVertices.swap(finalVertices);
+        meshIndices.swap(finalIndices);
+        sectionRanges_ = ranges;
+        surfaceMesh.indexCount = static_cast<int>(indexCount);
+    }
+    needsRebuild_.store(false);
+    AZV_LOG_DEBUG(Meshing) << "🔧 Chunk surface mesh data prepared. Vertices: " << vertexCount << ", Indices: " << indexCount;
+}
+
+bool Chunk::rebuildDirtySections(const ChunkNeighbors& neighbors) {
+    ChunkState state = state_.load();
+    if (state != ChunkState::FULLY_INITIALIZED && state != ChunkState::MESH_READY) {
+        return dirtySections_.load() == 0;
+    }
+    uint32_t dirty = dirtySections_.exchange(0);
+    VoxelSnapshot voxels = getVoxelSnapshot();
+    if (dirty == 0 || !voxels) {
+        return true;
+    }
+    AZV_PROFILE_ZONE("Chunk::rebuildDirtySections");
+
+    std::lock_guard<std::mutex> meshLock(meshMutex_);
+    MeshScratch& scratch = MeshScratch::begin();
+    MeshVertexBuffer& vertices = scratch.vertices;
+    MeshIndexBuffer& indices = scratch.indices;
+    std::array<MeshSectionRange, CHUNK_SECTION_COUNT> ranges;
+    LightSnapshot light = getLightSnapshot();
+    SectionMesher mesher(*voxels, light.get(), neighbors);
+
+    for (int section = 0; section < CHUNK_SECTION_COUNT; ++section) {
+        MeshSectionRange& range = ranges[section];
+        range.firstVertex = static_cast<uint32_t>(vertices.size() / CHUNK_VERTEX_FLOATS);
+        range.firstIndex = static_cast<uint32_t>(indices.size());
+        if (dirty & (1u << section)) {
+            mesher.append(section, vertices, indices);
+        } else {
+            // Unchanged section: copy its faces and rebase their indices to the new position
+            const MeshSectionRange& old = sectionRanges_[section];
+            vertices.insert(vertices.end(), meshVertices.begin() + old.firstVertex * CHUNK_VERTEX_FLOATS,
+                            meshVertices.begin() + (old.firstVertex + old.vertexCount) * CHUNK_VERTEX_FLOATS);
+            for (uint32_t i = old.firstIndex; i < old.firstIndex + old.indexCount; ++i) {
+                indices.push_back(meshIndices[i] - old.firstVertex + range.firstVertex);
             }
         }
+        range.vertexCount = static_cast<uint32_t>(vertices.size() / CHUNK_VERTEX_FLOATS) - range.firstVertex;
+        range.indexCount = static_cast<uint32_t>(indices.size()) - range.firstIndex;
     }
-
-    if (meshVertices.empty()) {
-        surfaceMesh.indexCount = 0;
-        surfaceMesh.VAO = 0;
-        needsRebuild_.store(false); 
-        return;
+    std::vector<float>(vertices.begin(), vertices.end()).swap(meshVertices);
+    std::vector<unsigned int>(indices.begin(), indices.end()).swap(meshIndices);
+    scratch.end();
+    sectionRanges_ = ranges;
+
+    if (state == ChunkState::FULLY_INITIALIZED) {
+        RenderBackend& backend = RenderBackend::getInstance();
+        if (meshIndices.empty()) {
+            backend.releaseChunkMesh(surfaceMesh);
+        } else if (!backend.updateChunkMesh(surfaceMesh, meshVertices, meshIndices)) {
+            AZV_LOG_WARN(Upload) << "Re-upload after edit failed for chunk at " << position.x << "," << position.y << "," << position.z;
+        }
+    } else {
+        surfaceMesh.indexCount = static_cast<int>(meshIndices.size());
     }
-    surfaceMesh.indexCount = static_cast<GLsizei>(meshIndices.size());
-    needsRebuild_.store(false);
-    std::cout << "🔧 Chunk surface mesh data prepared. Vertices: " << meshVertices.size()/5 << ", Indices: " << meshIndices.size() << std::endl;
+    AZV_LOG_TRACE(Meshing) << "Re-meshed sections 0x" << std::hex << dirty << std::dec << " of chunk at "
+                           << position.x << "," << position.y << "," << position.z << ", indices: " << meshIndices.size();
+    return true;
 }
 
 // Legacy OpenGL Initialize - This was called by ensureInitialized.
 // The new system uses initializeOpenGL called from main thread task queue.
-void Chunk::openglInitialize(World* world) {
+void Chunk::openglInitialize(World* /*world*/) {
     // This method is intended for the legacy ensureInitialized path.
-    // It attempts to create OpenGL objects if they don't exist and the mesh data is ready.
+    // It attempts to create GPU objects if they don't exist and the mesh data is ready.
     // It's distinct from the new `initializeOpenGL` which is part of the ChunkState pipeline.
 
     if (isInitialized() && surfaceMesh.VAO != 0) { // Check if already fully initialized by new pipeline or this legacy one
-        std::cout << "INFO: Legacy openglInitialize: Chunk already fully initialized. VAO=" << surfaceMesh.VAO << std::endl;
-            return;
-        }
+        AZV_LOG_DEBUG(Upload) << "Legacy openglInitialize: Chunk already fully initialized. VAO=" << surfaceMesh.VAO;
+        return;
+    }
 
-    if (glfwGetCurrentContext() == nullptr) {
-        std::cerr << "CRITICAL ERROR (Legacy openglInitialize): No OpenGL context! Cannot create GL objects for chunk at "
-                  << position.x << "," << position.z << std::endl;
+    RenderBackend& backend = RenderBackend::getInstance();
+    if (!backend.prepareChunkRendering()) {
+        AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (Legacy openglInitialize): Render backend not ready! Cannot create GPU objects for chunk at "
+                              << position.x << "," << position.z;
         return; // Cannot proceed
     }
     
-    std::cout << "INFO: Legacy openglInitialize: Attempting to create GL objects for chunk at " << position.x << "," << position.z << std::endl;
-
-    // Ensure shader and spritesheet are loaded (idempotent checks)
-    if (Block::shaderProgram == 0) Block::InitBlockShader();
-    if (!Block::spritesheetLoaded) Block::InitSpritesheet("res/textures/Spritesheet.PNG");
+    AZV_LOG_DEBUG(Upload) << "Legacy openglInitialize: Attempting to create GPU objects for chunk at " << position.x << "," << position.z;
 
-    if (Block::shaderProgram == 0 || !Block::spritesheetLoaded) {
-        std::cerr << "CRITICAL ERROR (Legacy openglInitialize): Shader or spritesheet failed to load." << std::endl;
-        return;
-    }
-    
     // This legacy path assumes buildSurfaceMesh was called just before it by ensureInitialized,
     // so meshVertices and meshIndices should be populated.
-    std::lock_guard<std::mutex> meshLock(meshMutex_); // Protect meshVertices and meshIndices
-    if (!meshVertices.empty() && !meshIndices.empty() && surfaceMesh.VAO == 0) {
-        std::cout << "LEGACY_GL_INIT: Creating OpenGL objects for chunk mesh" << std::endl;
-        while (glGetError() != GL_NO_ERROR) {} // Clear previous errors
-
-    glGenVertexArrays(1, &surfaceMesh.VAO);
-    GLenum error = glGetError();
-    if (error != GL_NO_ERROR || surfaceMesh.VAO == 0) {
-            std::cerr << "CRITICAL ERROR (Legacy): Failed to generate VAO. OpenGL error: " << error << std::endl;
-            surfaceMesh.VAO = 0; return;
-    }
-    glBindVertexArray(surfaceMesh.VAO);
-
-    glGenBuffers(1, &surfaceMesh.VBO);
-    error = glGetError();
-    if (error != GL_NO_ERROR || surfaceMesh.VBO == 0) {
-            std::cerr << "CRITICAL ERROR (Legacy): Failed to generate VBO. OpenGL error: " << error << std::endl;
-            glDeleteVertexArrays(1, &surfaceMesh.VAO); surfaceMesh.VAO = 0; return;
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, surfaceMesh.VBO);
-    glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), meshVertices.data(), GL_STATIC_DRAW);
-
-    glGenBuffers(1, &surfaceMesh.EBO);
-    error = glGetError();
-    if (error != GL_NO_ERROR || surfaceMesh.EBO == 0) {
-            std::cerr << "CRITICAL ERROR (Legacy): Failed to generate EBO. OpenGL error: " << error << std::endl;
-            glDeleteBuffers(1, &surfaceMesh.VBO); glDeleteVertexArrays(1, &surfaceMesh.VAO);
-            surfaceMesh.VAO = 0; surfaceMesh.VBO = 0; return;
-    }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surfaceMesh.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshIndices.size() * sizeof(unsigned int), meshIndices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-        std::cout << "LEGACY_GL_INIT: OpenGL objects created. VAO=" << surfaceMesh.VAO << std::endl;
-        surfaceMesh.indexCount = static_cast<GLsizei>(meshIndices.size()); // Ensure indexCount is set
-    } else if (surfaceMesh.VAO != 0) {
-         std::cout << "INFO: Legacy openglInitialize: VAO already exists (" << surfaceMesh.VAO << ")." << std::endl;
-    } else {
-        std::cout << "WARN: Legacy openglInitialize: Mesh data empty or VAO already 0, cannot create GL objects." << std::endl;
-        // If mesh data is empty, but we reached here, it means buildMeshAsync might have found no visible faces.
-        // In this case, the chunk is effectively 'initialized' but has nothing to draw.
-        surfaceMesh.VAO = 0; // Ensure it's 0
-        surfaceMesh.indexCount = 0;
+    bool uploaded = false;
+    {
+        std::lock_guard<std::mutex> meshLock(meshMutex_); // Protect meshVertices and meshIndices
+        if (!meshVertices.empty() && !meshIndices.empty() && surfaceMesh.VAO == 0) {
+            AZV_LOG_DEBUG(Upload) << "LEGACY_GL_INIT: Creating GPU objects for chunk mesh";
+            uploaded = backend.uploadChunkMesh(surfaceMesh, meshVertices, meshIndices);
+            if (uploaded) {
+                AZV_LOG_DEBUG(Upload) << "LEGACY_GL_INIT: GPU objects created. VAO=" << surfaceMesh.VAO;
+            }
+        } else if (surfaceMesh.VAO != 0) {
+            AZV_LOG_DEBUG(Upload) << "Legacy openglInitialize: VAO already exists (" << surfaceMesh.VAO << ").";
+            uploaded = true;
+        } else {
+            AZV_LOG_WARN(Upload) << "WARN: Legacy openglInitialize: Mesh data empty, cannot create GPU objects.";
+            // If mesh data is empty, but we reached here, it means buildMeshAsync might have found no visible faces.
+            // In this case, the chunk is effectively 'initialized' but has nothing to draw.
+            surfaceMesh = ChunkMesh();
+        }
     }
 
-    // If VAO is now valid, we can consider this chunk fully initialized *for the legacy path*.
-    if (surfaceMesh.VAO != 0) {
-        state_.store(ChunkState::FULLY_INITIALIZED); // MODIFIED: From isInitialized_ = true;
+    // If the upload succeeded, we can consider this chunk fully initialized *for the legacy path*.
+    if (uploaded) {
+        transitionTo(ChunkState::FULLY_INITIALIZED); // MODIFIED: From isInitialized_ = true;
         needsRebuild_.store(false); 
-        std::cout << "INFO: Legacy openglInitialize: Chunk at " << position.x << "," << position.z << " marked FULLY_INITIALIZED. VAO=" << surfaceMesh.VAO << std::endl;
+        AZV_LOG_DEBUG(Upload) << "Legacy openglInitialize: Chunk at " << position.x << "," << position.z << " marked FULLY_INITIALIZED. VAO=" << surfaceMesh.VAO;
     } else {
-        std::cout << "WARN: Legacy openglInitialize: Chunk at " << position.x << "," << position.z << " failed GL setup, not fully initialized." << std::endl;
+        AZV_LOG_WARN(Upload) << "WARN: Legacy openglInitialize: Chunk at " << position.x << "," << position.z << " failed GPU setup, not fully initialized.";
     }
 }
 
 void Chunk::setPlanetContext(const glm::vec3& planetCenter, float planetRadius) {
     planetCenter_ = planetCenter;
     planetRadius_ = planetRadius;
-    state_.store(ChunkState::UNINITIALIZED); // MODIFIED: From isInitialized_ = false;
+    timeline_.clear();
+    transitionTo(ChunkState::UNINITIALIZED); // MODIFIED: From isInitialized_ = false;
     needsRebuild_.store(true); 
 }
 
@@ -892,16 +1432,46 @@ void Chunk::generateDataAsync(const World* world, int seed, const std::optional<
     if (!state_.compare_exchange_strong(expected, ChunkState::DATA_GENERATING)) {
         return; 
     }
+    timeline_.stamp(static_cast<int>(ChunkState::DATA_GENERATING));
     
-    std::lock_guard<std::mutex> lock(dataMutex_);
     planetCenter_ = planetCenter;
     planetRadius_ = planetRadius;
     
-    if (blockDataForInitialization_.empty() || blockDataForInitialization_.size() != CHUNK_SIZE_X) { 
-        blockDataForInitialization_.resize(CHUNK_SIZE_X,
-                                 std::vector<std::vector<BlockInfo>>(
-                                     CHUNK_SIZE_Y,
-                                     std::vector<BlockInfo>(CHUNK_SIZE_Z)));
+    // Only the blocks_/compressedVoxels_ handover takes the data lock; the voxels themselves are
+    // built off-lock and published as a new version
+    std::vector<uint16_t> compressed;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        if (blocks_.empty()) {
+            blocks_.resize(CHUNK_SIZE_X, std::vector<std::vector<std::shared_ptr<Block>>>(
+                                           CHUNK_SIZE_Y, std::vector<std::shared_ptr<Block>>(
+                                                         CHUNK_SIZE_Z, nullptr)));
+        }
+        compressed.swap(compressedVoxels_);
+    }
+
+    // Restored from the compressed residency tier: decode instead of loading or generating
+    if (!compressed.empty()) {
+        auto voxels = std::make_shared<VoxelData>();
+        size_t run = 0;
+        uint16_t remaining = 0;
+        for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+            for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
+                for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                    while (remaining == 0 && run + 1 < compressed.size()) {
+                        remaining = compressed[run];
+                        run += 2;
+                    }
+                    voxels->at(x, y, z).type = compressed[run - 1];
+                    --remaining;
+                }
+            }
+        }
+        publishVoxels(std::move(voxels));
+        needsRebuild_.store(true);
+        AZV_LOG_DEBUG(Generation) << "♻ DECOMPRESSED cached chunk " << position.x << "," << position.y << "," << position.z;
+        transitionTo(ChunkState::DATA_READY);
+        return;
     }
     
     bool loadedFromFile = false;
@@ -909,36 +1479,37 @@ void Chunk::generateDataAsync(const World* world, int seed, const std::optional<
         std::string worldDataPath = "chunk_data/" + world->getWorldName();
         loadedFromFile = loadFromFile_DataOnly(worldDataPath, const_cast<World*>(world));
         if (loadedFromFile) {
-            std::cout << "✓ LOADED chunk " << position.x << "," << position.y << "," << position.z << " from saved file (FAST)" << std::endl;
+            AZV_LOG_DEBUG(Generation) << "✓ LOADED chunk " << position.x << "," << position.y << "," << position.z << " from saved file (FAST)";
         } else {
-            std::cout << "✗ No saved file found for chunk " << position.x << "," << position.y << "," << position.z << " - will generate" << std::endl;
+            AZV_LOG_DEBUG(Generation) << "✗ No saved file found for chunk " << position.x << "," << position.y << "," << position.z << " - will generate";
         }
     }
 
     if (!loadedFromFile) {
-        std::cout << "⚡ GENERATING chunk " << position.x << "," << position.y << "," << position.z << " (SLOW)" << std::endl;
+        AZV_LOG_DEBUG(Generation) << "⚡ GENERATING chunk " << position.x << "," << position.y << "," << position.z << " (SLOW)";
         generateTerrainDataOnly(seed, planetCenter, planetRadius);
         if (world) {
             std::string worldDataPath = "chunk_data/" + world->getWorldName();
             if (saveToFile(worldDataPath)) {
-                std::cout << "💾 Saved generated chunk " << position.x << "," << position.y << "," << position.z << " to file for future use" << std::endl;
+                AZV_LOG_DEBUG(Generation) << "💾 Saved generated chunk " << position.x << "," << position.y << "," << position.z << " to file for future use";
             } else {
-                std::cerr << "❌ Failed to save chunk " << position.x << "," << position.y << "," << position.z << " to file." << std::endl;
+                AZV_LOG_ERROR(Generation) << "❌ Failed to save chunk " << position.x << "," << position.y << "," << position.z << " to file.";
             }
         }
     }
-    state_.store(ChunkState::DATA_READY);
+    transitionTo(ChunkState::DATA_READY);
 }
 
 // New multi-threaded mesh building phase
-void Chunk::buildMeshAsync(const World* world) {
+void Chunk::buildMeshAsync(const World* world, const ChunkNeighbors& neighbors) {
     ChunkState expected = ChunkState::DATA_READY;
     if (!state_.compare_exchange_strong(expected, ChunkState::MESH_BUILDING)) {
         return; 
     }
-    std::cout << "🔧 BUILDING mesh for chunk " << position.x << "," << position.y << "," << position.z << std::endl;
-    buildSurfaceMesh(world, planetCenter_, planetRadius_);
-    state_.store(ChunkState::MESH_READY);
+    timeline_.stamp(static_cast<int>(ChunkState::MESH_BUILDING));
+    AZV_LOG_DEBUG(Meshing) << "🔧 BUILDING mesh for chunk " << position.x << "," << position.y << "," << position.z;
+    buildSurfaceMesh(world, planetCenter_, planetRadius_, neighbors);
+    transitionTo(ChunkState::MESH_READY);
 }
 
 // OpenGL initialization (main thread only - THIS IS THE NEW SYSTEM'S METHOD)
@@ -953,41 +1524,26 @@ void Chunk::initializeOpenGL(World* world) {
         }
         return; 
     }
+    timeline_.stamp(static_cast<int>(ChunkState::OPENGL_INITIALIZING));
 
-    if (glfwGetCurrentContext() == nullptr) {
-        std::cerr << "CRITICAL ERROR (initializeOpenGL): No OpenGL context current on main thread! Chunk: " 
-                  << position.x << "," << position.z << std::endl;
+    RenderBackend& backend = RenderBackend::getInstance();
+    if (!backend.prepareChunkRendering()) {
+        AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (initializeOpenGL): Render backend not ready for chunk " 
+                              << position.x << "," << position.z;
         state_.store(ChunkState::MESH_READY); // Revert state
         return;
     }
 
-    std::cout << "🎨 OpenGL-Initializing chunk at " << position.x << "," << position.z << " (New Pipeline)" << std::endl;
-    
-    // Initialize shader and texture if needed
-    if (Block::shaderProgram == 0) {
-        Block::InitBlockShader();
-        if (Block::shaderProgram == 0) {
-            std::cerr << "CRITICAL ERROR (initializeOpenGL): Failed to initialize block shader program!" << std::endl;
-            state_.store(ChunkState::MESH_READY); // Revert state
-            return;
-        }
-    }
-    if (!Block::spritesheetLoaded) { 
-        Block::InitSpritesheet("res/textures/Spritesheet.PNG");
-        if (!Block::spritesheetLoaded) {
-            std::cerr << "CRITICAL ERROR (initializeOpenGL): Failed to load global spritesheet!" << std::endl;
-            // Continue, but textures might be wrong
-        }
-    }
+    AZV_LOG_DEBUG(Upload) << "🎨 OpenGL-Initializing chunk at " << position.x << "," << position.z << " (New Pipeline)";
 
     // Create Block objects from data
-    {
-        std::lock_guard<std::mutex> dataLock(dataMutex_); // Protects blockDataForInitialization_
-        std::lock_guard<std::mutex> blocksLock(meshMutex_); // Assuming blocks_ might also need protection if accessed elsewhere, better safe. For now, meshMutex_ also covers blocks_ creation.
+    VoxelSnapshot voxels = getVoxelSnapshot();
+    if (voxels) {
+        std::lock_guard<std::mutex> dataLock(dataMutex_); // Protects blocks_
     for (int x = 0; x < CHUNK_SIZE_X; ++x) {
         for (int y = 0; y < CHUNK_SIZE_Y; ++y) {
             for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
-                BlockInfo info = blockDataForInitialization_[x][y][z];
+                BlockInfo info = voxels->at(x, y, z);
                 glm::vec3 blockWorldPos = this->position + glm::vec3(x, y, z);
                 if (info.type != 0 && blocks_[x][y][z] == nullptr) { 
                         blocks_[x][y][z] = std::make_shared<Block>(blockWorldPos, static_cast<uint16_t>(info.type), glm::vec3(0.5f), 1.0f);
@@ -999,60 +1555,20 @@ void Chunk::initializeOpenGL(World* world) {
         }
     }
 
-    // Create OpenGL objects from the prepared mesh data
+    // Create GPU objects from the prepared mesh data
     {
         std::lock_guard<std::mutex> meshLock(meshMutex_); // Protects meshVertices, meshIndices, and surfaceMesh
         if (!meshVertices.empty() && !meshIndices.empty()) {
-            std::cout << "🎨 Creating OpenGL objects for chunk mesh (New Pipeline)" << std::endl;
-            while (glGetError() != GL_NO_ERROR) {} // Clear previous errors
-            
-            glGenVertexArrays(1, &surfaceMesh.VAO);
-            GLenum error = glGetError();
-            if (error != GL_NO_ERROR || surfaceMesh.VAO == 0) {
-                std::cerr << "CRITICAL ERROR (initializeOpenGL): Failed to generate VAO. OpenGL error: " << error << " VAO ID: " << surfaceMesh.VAO << std::endl;
-                surfaceMesh.VAO = 0; 
-                state_.store(ChunkState::MESH_READY); // Revert state
-                return;
-            }
-            glBindVertexArray(surfaceMesh.VAO);
-
-            glGenBuffers(1, &surfaceMesh.VBO);
-            error = glGetError();
-            if (error != GL_NO_ERROR || surfaceMesh.VBO == 0) {
-                std::cerr << "CRITICAL ERROR (initializeOpenGL): Failed to generate VBO. OpenGL error: " << error << " VBO ID: " << surfaceMesh.VBO << std::endl;
-                glDeleteVertexArrays(1, &surfaceMesh.VAO); surfaceMesh.VAO = 0;
-                surfaceMesh.VBO = 0;
+            AZV_LOG_DEBUG(Upload) << "🎨 Uploading chunk mesh (New Pipeline)";
+            if (!backend.uploadChunkMesh(surfaceMesh, meshVertices, meshIndices)) {
                 state_.store(ChunkState::MESH_READY); // Revert state
                 return;
             }
-            glBindBuffer(GL_ARRAY_BUFFER, surfaceMesh.VBO);
-            glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), meshVertices.data(), GL_STATIC_DRAW);
-
-            glGenBuffers(1, &surfaceMesh.EBO);
-            error = glGetError();
-            if (error != GL_NO_ERROR || surfaceMesh.EBO == 0) {
-                std::cerr << "CRITICAL ERROR (initializeOpenGL): Failed to generate EBO. OpenGL error: " << error << " EBO ID: " << surfaceMesh.EBO << std::endl;
-                glDeleteBuffers(1, &surfaceMesh.VBO); glDeleteVertexArrays(1, &surfaceMesh.VAO);
-                surfaceMesh.VAO = 0; surfaceMesh.VBO = 0; surfaceMesh.EBO = 0;
-                state_.store(ChunkState::MESH_READY); // Revert state
-                return;
-            }
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surfaceMesh.EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshIndices.size() * sizeof(unsigned int), meshIndices.data(), GL_STATIC_DRAW);
-
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-            glEnableVertexAttribArray(1);
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-            glBindVertexArray(0);
-            surfaceMesh.indexCount = static_cast<GLsizei>(meshIndices.size()); // Make sure indexCount is set
-            std::cout << "🎨 OpenGL objects created successfully (New Pipeline). VAO=" << surfaceMesh.VAO << std::endl;
+            AZV_LOG_DEBUG(Upload) << "🎨 Chunk mesh uploaded successfully (New Pipeline). VAO=" << surfaceMesh.VAO;
         } else if (surfaceMesh.VAO != 0) {
-             std::cout << "DEBUG: initializeOpenGL: VAO already exists and mesh data is empty. This might be okay if already initialized." << std::endl;
+             AZV_LOG_DEBUG(Upload) << "initializeOpenGL: VAO already exists and mesh data is empty. This might be okay if already initialized.";
         } else {
-            std::cout << "WARN: initializeOpenGL: Mesh data (vertices/indices) is empty. Cannot create GL objects. Chunk at " << position.x << "," << position.z << std::endl;
+            AZV_LOG_DEBUG(Upload) << "initializeOpenGL: Mesh data (vertices/indices) is empty. Nothing to upload. Chunk at " << position.x << "," << position.z;
             // If mesh data is empty, but we reached here, it means buildMeshAsync might have found no visible faces.
             // In this case, the chunk is effectively 'initialized' but has nothing to draw.
             surfaceMesh.VAO = 0; // Ensure it's 0
@@ -1061,27 +1577,26 @@ void Chunk::initializeOpenGL(World* world) {
     }
     
     needsRebuild_.store(false);
-    state_.store(ChunkState::FULLY_INITIALIZED);
-    std::cout << "✅ Chunk at " << position.x << "," << position.z << " fully initialized (New Pipeline). VAO=" << surfaceMesh.VAO << std::endl;
+    transitionTo(ChunkState::FULLY_INITIALIZED);
+    if (world) {
+        world->getPipelineMetrics().recordCompletedChunk(timeline_);
+    }
+    AZV_LOG_DEBUG(Upload) << "✅ Chunk at " << position.x << "," << position.z << " fully initialized (New Pipeline). VAO=" << surfaceMesh.VAO;
 }
 
 // generateTerrainDataOnly is used by the new system (generateDataAsync)
 void Chunk::generateTerrainDataOnly(int seed, const std::optional<glm::vec3>& pCenterOpt, const std::optional<float>& pRadiusOpt) {
-    std::cout << "Chunk at " << position.x << "," << position.y << "," << position.z << " generateTerrainDataOnly. Planet context: " << (pCenterOpt.has_value() ? "Yes" : "No") << std::endl;
+    AZV_PROFILE_ZONE("Chunk::generateTerrainDataOnly");
+    AZV_LOG_DEBUG(Generation) << "Chunk at " << position.x << "," << position.y << "," << position.z << " generateTerrainDataOnly. Planet context: " << (pCenterOpt.has_value() ? "Yes" : "No");
 
     // Get reference to the block registry
     BlockRegistry& registry = BlockRegistry::getInstance();
 
-    if (blockDataForInitialization_.empty() || blockDataForInitialization_.size() != CHUNK_SIZE_X ) { 
-        blockDataForInitialization_.resize(CHUNK_SIZE_X,
-                                 std::vector<std::vector<BlockInfo>>(
-                                     CHUNK_SIZE_Y,
-                                     std::vector<BlockInfo>(CHUNK_SIZE_Z)));
-    }
+    auto voxels = std::make_shared<VoxelData>();
 
     if (!pCenterOpt.has_value() || !pRadiusOpt.has_value()) {
         // Fallback to original flat terrain generation logic
-        std::cout << "Generating flat terrain for chunk at (" << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
+        AZV_LOG_DEBUG(Generation) << "Generating flat terrain for chunk at (" << position.x << ", " << position.y << ", " << position.z << ")";
         std::vector<int> heightMap(CHUNK_SIZE_X * CHUNK_SIZE_Z);
         for (int x_local = 0; x_local < CHUNK_SIZE_X; x_local++) {
             for (int z_local = 0; z_local < CHUNK_SIZE_Z; z_local++) {
@@ -1108,17 +1623,22 @@ void Chunk::generateTerrainDataOnly(int seed, const std::optional<glm::vec3>& pC
                         blockTypeId = registry.getBlockId("azurevoxel:grass");
                     }
                     
-                    blockDataForInitialization_[x_local][y_local][z_local].type = static_cast<unsigned char>(blockTypeId);
+                    voxels->at(x_local, y_local, z_local).type = static_cast<unsigned char>(blockTypeId);
                 }
             }
         }
+        publishVoxels(std::move(voxels));
         return;
     }
 
-    // Spherical generation logic with biome-aware block selection
+    // Spherical generation logic with biome-aware block selection. Block objects are built
+    // off-lock and swapped in at the end, so readers of blocks_ never wait for generation.
+    std::vector<std::vector<std::vector<std::shared_ptr<Block>>>> newBlocks(
+        CHUNK_SIZE_X, std::vector<std::vector<std::shared_ptr<Block>>>(
+                          CHUNK_SIZE_Y, std::vector<std::shared_ptr<Block>>(CHUNK_SIZE_Z, nullptr)));
     const glm::vec3& planetCenter = pCenterOpt.value();
     const float planetRadius = pRadiusOpt.value();
-    std::cout << "Generating spherical terrain for chunk. Planet R: " << planetRadius << " Center: (" << planetCenter.x << "," << planetCenter.y << "," << planetCenter.z << ")" << std::endl;
+    AZV_LOG_DEBUG(Generation) << "Generating spherical terrain for chunk. Planet R: " << planetRadius << " Center: (" << planetCenter.x << "," << planetCenter.y << "," << planetCenter.z << ")";
     
     // Noise parameters for variety
     float elevationNoiseScale = 0.02f; // Controls variation in "surface" height
@@ -1319,15 +1839,20 @@ void Chunk::generateTerrainDataOnly(int seed, const std::optional<glm::vec3>& pC
                     }
                 }
 
-                blockDataForInitialization_[x_local][y_local][z_local].type = static_cast<unsigned char>(blockTypeId);
+                voxels->at(x_local, y_local, z_local).type = static_cast<unsigned char>(blockTypeId);
                 if (blockTypeId != 0) {
-                    blocks_[x_local][y_local][z_local] = std::make_shared<Block>(position + glm::vec3(x_local,y_local,z_local), blockTypeId, glm::vec3(0.5f), 1.0f);
+                    newBlocks[x_local][y_local][z_local] = std::make_shared<Block>(position + glm::vec3(x_local,y_local,z_local), blockTypeId, glm::vec3(0.5f), 1.0f);
                 } else {
-                    blocks_[x_local][y_local][z_local] = nullptr; 
+                    newBlocks[x_local][y_local][z_local] = nullptr; 
                 }
             }
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        blocks_.swap(newBlocks);
+    }
+    publishVoxels(std::move(voxels));
 }
 
 
@@ -0,0 +1,173 @@
+#include "../headers/chunk_pipeline_metrics.h"
+#include "../headers/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// --- LatencyHistogram ---
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sumMicros_.store(0, std::memory_order_relaxed);
+    maxMicros_.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketFor(uint64_t micros) {
+    if (micros == 0) return 0;
+    int bucket = 1 + static_cast<int>(std::floor(std::log2(static_cast<double>(micros)) * BUCKETS_PER_OCTAVE));
+    return std::min(bucket, BUCKET_COUNT - 1);
+}
+
+// Bucket b >= 1 covers [2^((b-1)/4), 2^(b/4)) microseconds; report its geometric midpoint
+double LatencyHistogram::bucketMidpointMicros(int bucket) {
+    if (bucket == 0) return 0.0;
+    return std::exp2((static_cast<double>(bucket) - 0.5) / BUCKETS_PER_OCTAVE);
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration duration) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    uint64_t value = micros > 0 ? static_cast<uint64_t>(micros) : 0;
+
+    buckets_[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumMicros_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t currentMax = maxMicros_.load(std::memory_order_relaxed);
+    while (value > currentMax && !maxMicros_.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+        // currentMax reloaded by compare_exchange_weak
+    }
+}
+
+double LatencyHistogram::meanMs() const {
+    uint64_t n = count();
+    if (n == 0) return 0.0;
+    return static_cast<double>(sumMicros_.load(std::memory_order_relaxed)) / static_cast<double>(n) / 1000.0;
+}
+
+double LatencyHistogram::maxMs() const {
+    return static_cast<double>(maxMicros_.load(std::memory_order_relaxed)) / 1000.0;
+}
+
+double LatencyHistogram::percentileMs(double p) const {
+    uint64_t n = count();
+    if (n == 0) return 0.0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * static_cast<double>(n)));
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            // Never report more than the largest sample actually observed
+            return std::min(bucketMidpointMicros(i) / 1000.0, maxMs());
+        }
+    }
+    return maxMs();
+}
+
+// --- ChunkPipelineMetrics ---
+
+const char* pipelineStageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::GENERATION_WAIT: return "generation_wait";
+        case PipelineStage::GENERATION:      return "generation";
+        case PipelineStage::MESH_WAIT:       return "mesh_wait";
+        case PipelineStage::MESH_BUILD:      return "mesh_build";
+        case PipelineStage::UPLOAD_WAIT:     return "upload_wait";
+        case PipelineStage::UPLOAD:          return "upload";
+        case PipelineStage::END_TO_END:      return "end_to_end";
+        default:                             return "unknown";
+    }
+}
+
+ChunkPipelineMetrics::ChunkPipelineMetrics() : completedChunks_(0) {
+}
+
+void ChunkPipelineMetrics::recordCompletedChunk(const ChunkStateTimeline& timeline) {
+    // ChunkState indices: 0 UNINITIALIZED, 1 DATA_GENERATING, 2 DATA_READY, 3 MESH_BUILDING,
+    // 4 MESH_READY, 5 OPENGL_INITIALIZING, 6 FULLY_INITIALIZED
+    static constexpr int stageEndpoints[static_cast<int>(PipelineStage::COUNT)][2] = {
+        {0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {0, 6}
+    };
+
+    for (int stage = 0; stage < static_cast<int>(PipelineStage::COUNT); ++stage) {
+        int from = stageEndpoints[stage][0];
+        int to = stageEndpoints[stage][1];
+        if (timeline.has(from) && timeline.has(to) && timeline.enteredAt[to] >= timeline.enteredAt[from]) {
+            histograms_[stage].record(timeline.enteredAt[to] - timeline.enteredAt[from]);
+        }
+    }
+    completedChunks_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ChunkPipelineMetrics::reset() {
+    for (auto& histogram : histograms_) {
+        histogram.reset();
+    }
+    completedChunks_.store(0, std::memory_order_relaxed);
+}
+
+void ChunkPipelineMetrics::printReport(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    out << "Chunk pipeline latency (" << completedChunks() << " chunks, ms):" << std::endl;
+    out << "  " << std::left << std::setw(16) << "stage"
+        << std::right << std::setw(9) << "count"
+        << std::setw(10) << "p50" << std::setw(10) << "p95"
+        << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+    out << std::fixed << std::setprecision(2);
+    for (int stage = 0; stage < static_cast<int>(PipelineStage::COUNT); ++stage) {
+        const LatencyHistogram& h = histograms_[stage];
+        out << "  " << std::left << std::setw(16) << pipelineStageName(static_cast<PipelineStage>(stage))
+            << std::right << std::setw(9) << h.count()
+            << std::setw(10) << h.percentileMs(0.50)
+            << std::setw(10) << h.percentileMs(0.95)
+            << std::setw(10) << h.percentileMs(0.99)
+            << std::setw(10) << h.maxMs() << std::endl;
+    }
+
+    out.copyfmt(oldState);
+}
+
+void ChunkPipelineMetrics::writeJSON(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"completed_chunks\": " << completedChunks() << ",\n  \"stages\": {\n";
+    for (int stage = 0; stage < static_cast<int>(PipelineStage::COUNT); ++stage) {
+        const LatencyHistogram& h = histograms_[stage];
+        out << "    \"" << pipelineStageName(static_cast<PipelineStage>(stage)) << "\": {"
+            << "\"count\": " << h.count()
+            << ", \"mean_ms\": " << h.meanMs()
+            << ", \"p50_ms\": " << h.percentileMs(0.50)
+            << ", \"p95_ms\": " << h.percentileMs(0.95)
+            << ", \"p99_ms\": " << h.percentileMs(0.99)
+            << ", \"max_ms\": " << h.maxMs() << "}"
+            << (stage + 1 < static_cast<int>(PipelineStage::COUNT) ? ",\n" : "\n");
+    }
+    out << "  }\n}\n";
+
+    out.copyfmt(oldState);
+}
+
+bool ChunkPipelineMetrics::writeJSONFile(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        AZV_LOG_ERROR(World) << "Error: Could not open pipeline metrics file for writing: " << path;
+        return false;
+    }
+    writeJSON(file);
+    return true;
+}
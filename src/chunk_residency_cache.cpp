@@ -0,0 +1,184 @@
+#include "../headers/chunk_residency_cache.h"
+#include "../headers/chunk.h"
+#include "../headers/logger.h"
+#include <iomanip>
+
+namespace {
+
+// Default budgets per planet; GPU and CPU mesh tiers dominate because meshes are large
+constexpr size_t MiB = 1024 * 1024;
+constexpr size_t DEFAULT_BUDGETS[] = {
+    192 * MiB, // GPU_MESH
+    96 * MiB,  // CPU_MESH
+    128 * MiB, // VOXEL_DATA
+    32 * MiB,  // COMPRESSED
+};
+
+} // namespace
+
+const char* residencyTierName(ResidencyTier tier) {
+    switch (tier) {
+        case ResidencyTier::GPU_MESH:   return "gpu_mesh";
+        case ResidencyTier::CPU_MESH:   return "cpu_mesh";
+        case ResidencyTier::VOXEL_DATA: return "voxel_data";
+        case ResidencyTier::COMPRESSED: return "compressed";
+        default:                        return "unknown";
+    }
+}
+
+ChunkResidencyCache::ChunkResidencyCache() {
+    for (int tier = 0; tier < TIER_COUNT; ++tier) {
+        budgets_[tier] = DEFAULT_BUDGETS[tier];
+    }
+}
+
+ChunkResidencyCache::~ChunkResidencyCache() {
+    clear();
+}
+
+void ChunkResidencyCache::setBudget(ResidencyTier tier, size_t bytes) {
+    budgets_[static_cast<int>(tier)] = bytes;
+    enforceBudgets();
+}
+
+size_t ChunkResidencyCache::residentBytes(int tier, const Chunk& chunk) {
+    switch (static_cast<ResidencyTier>(tier)) {
+        case ResidencyTier::GPU_MESH:
+            // GPU copy of the mesh plus the CPU data that stays with it
+            return 2 * chunk.getMeshDataBytes() + chunk.getVoxelDataBytes();
+        case ResidencyTier::CPU_MESH:
+            return chunk.getMeshDataBytes() + chunk.getVoxelDataBytes();
+        case ResidencyTier::VOXEL_DATA:
+            return chunk.getVoxelDataBytes();
+        case ResidencyTier::COMPRESSED:
+            return chunk.getCompressedDataBytes();
+        default:
+            return 0;
+    }
+}
+
+void ChunkResidencyCache::park(const glm::ivec3& key, std::shared_ptr<Chunk> chunk) {
+    if (!chunk) {
+        return;
+    }
+    remove(key); // Replace any stale entry for the same key
+
+    int tier;
+    switch (chunk->getState()) {
+        case ChunkState::FULLY_INITIALIZED:
+            tier = static_cast<int>(ResidencyTier::GPU_MESH);
+            break;
+        case ChunkState::MESH_READY:
+            tier = static_cast<int>(ResidencyTier::CPU_MESH);
+            break;
+        case ChunkState::DATA_READY:
+            tier = static_cast<int>(ResidencyTier::VOXEL_DATA);
+            break;
+        case ChunkState::UNINITIALIZED:
+            if (chunk->isCompressed()) {
+                tier = static_cast<int>(ResidencyTier::COMPRESSED);
+                break;
+            }
+            return; // Nothing built yet, nothing worth keeping
+        default:
+            // A worker thread still owns it; let it finish and be collected
+            return;
+    }
+    insert(tier, key, std::move(chunk), true);
+    enforceBudgets();
+}
+
+std::shared_ptr<Chunk> ChunkResidencyCache::take(const glm::ivec3& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    ++hits_[it->second.tier];
+    return remove(key);
+}
+
+std::shared_ptr<Chunk> ChunkResidencyCache::remove(const glm::ivec3& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    Tier& tier = tiers_[it->second.tier];
+    std::shared_ptr<Chunk> chunk = std::move(it->second.entry->chunk);
+    tier.bytes -= it->second.entry->bytes;
+    tier.entries.erase(it->second.entry);
+    index_.erase(it);
+    return chunk;
+}
+
+void ChunkResidencyCache::clear() {
+    for (Tier& tier : tiers_) {
+        tier.entries.clear();
+        tier.bytes = 0;
+    }
+    index_.clear();
+}
+
+void ChunkResidencyCache::forEach(const std::function<void(const glm::ivec3&, const std::shared_ptr<Chunk>&)>& visit) const {
+    for (const Tier& tier : tiers_) {
+        for (const Entry& entry : tier.entries) {
+            visit(entry.key, entry.chunk);
+        }
+    }
+}
+
+void ChunkResidencyCache::insert(int tier, const glm::ivec3& key, std::shared_ptr<Chunk> chunk, bool mostRecent) {
+    size_t bytes = residentBytes(tier, *chunk);
+    Tier& target = tiers_[tier];
+    auto entry = mostRecent ? target.entries.insert(target.entries.begin(), Entry{key, std::move(chunk), bytes})
+                            : target.entries.insert(target.entries.end(), Entry{key, std::move(chunk), bytes});
+    target.bytes += bytes;
+    index_[key] = Location{tier, entry};
+}
+
+void ChunkResidencyCache::enforceBudgets() {
+    // Top-down, so chunks demoted into a lower tier are accounted before that tier is checked
+    for (int tier = 0; tier < TIER_COUNT; ++tier) {
+        Tier& current = tiers_[tier];
+        while (current.bytes > budgets_[tier] && !current.entries.empty()) {
+            Entry oldest = std::move(current.entries.back());
+            current.entries.pop_back();
+            current.bytes -= oldest.bytes;
+            index_.erase(oldest.key);
+            demote(tier, std::move(oldest));
+        }
+    }
+}
+
+void ChunkResidencyCache::demote(int tier, Entry entry) {
+    bool demoted = false;
+    switch (static_cast<ResidencyTier>(tier)) {
+        case ResidencyTier::GPU_MESH:   demoted = entry.chunk->releaseGpuMesh(); break;
+        case ResidencyTier::CPU_MESH:   demoted = entry.chunk->releaseCpuMesh(); break;
+        case ResidencyTier::VOXEL_DATA: demoted = entry.chunk->compressVoxelData(); break;
+        default: break;
+    }
+    if (!demoted) {
+        ++evictions_;
+        AZV_LOG_TRACE(Streaming) << "Residency cache evicted chunk " << entry.key.x << "," << entry.key.y << "," << entry.key.z;
+        return; // Dropping the last reference frees the chunk (and its GPU objects)
+    }
+    // Keep LRU order across tiers: a demoted chunk is older than anything parked directly below
+    insert(tier + 1, entry.key, std::move(entry.chunk), false);
+}
+
+void ChunkResidencyCache::printStats(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    out << std::fixed << std::setprecision(1);
+    for (int tier = 0; tier < TIER_COUNT; ++tier) {
+        out << "  " << std::left << std::setw(12) << residencyTierName(static_cast<ResidencyTier>(tier))
+            << std::right << std::setw(6) << tiers_[tier].entries.size() << " chunks "
+            << std::setw(8) << static_cast<double>(tiers_[tier].bytes) / MiB << " / "
+            << static_cast<double>(budgets_[tier]) / MiB << " MiB, "
+            << hits_[tier] << " hits\n";
+    }
+    out << "  evicted " << evictions_ << " chunks\n";
+
+    out.copyfmt(oldState);
+}
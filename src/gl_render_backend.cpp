@@ -0,0 +1,293 @@
+#include "../headers/gl_render_backend.h"
+#include "../headers/chunk.h"
+#include "../headers/block.h"
+#include "../headers/texture.h"
+#include "../headers/logger.h"
+#include "../headers/mesh_scratch.h" // CHUNK_VERTEX_FLOATS
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp> // For glm::value_ptr
+
+bool GLRenderBackend::prepareChunkRendering() {
+    if (glfwGetCurrentContext() == nullptr) {
+        AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (GLRenderBackend): No OpenGL context current on this thread!";
+        return false;
+    }
+
+    // Initialize shader and texture if needed
+    if (Block::shaderProgram == 0) {
+        Block::InitBlockShader();
+        if (Block::shaderProgram == 0) {
+            AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (GLRenderBackend): Failed to initialize block shader program!";
+            return false;
+        }
+    }
+    if (!Block::spritesheetLoaded) {
+        Block::InitSpritesheet("res/textures/Spritesheet.PNG");
+        if (!Block::spritesheetLoaded) {
+            AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (GLRenderBackend): Failed to load global spritesheet!";
+            // Continue, but textures might be wrong
+        }
+    }
+    return true;
+}
+
+bool GLRenderBackend::uploadChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                                      const std::vector<unsigned int>& indices) {
+    while (glGetError() != GL_NO_ERROR) {} // Clear previous errors
+
+    mesh.VAO = acquireVertexArray();
+    if (mesh.VAO == 0) {
+        AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (GLRenderBackend): Failed to generate VAO. OpenGL error: " << glGetError();
+        mesh = ChunkMesh();
+        return false;
+    }
+    glBindVertexArray(mesh.VAO);
+
+    mesh.VBO = acquireBuffer();
+    if (mesh.VBO == 0) {
+        AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (GLRenderBackend): Failed to generate VBO. OpenGL error: " << glGetError();
+        glBindVertexArray(0);
+        releaseChunkMesh(mesh);
+        return false;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    mesh.EBO = acquireBuffer();
+    if (mesh.EBO == 0) {
+        AZV_LOG_ERROR(Upload) << "CRITICAL ERROR (GLRenderBackend): Failed to generate EBO. OpenGL error: " << glGetError();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+        releaseChunkMesh(mesh);
+        return false;
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    // Attribute state is reset as well, since a recycled VAO keeps whatever it was set up with
+    const GLsizei stride = CHUNK_VERTEX_FLOATS * sizeof(float);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    mesh.indexCount = static_cast<int>(indices.size());
+    return true;
+}
+
+bool GLRenderBackend::updateChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                                      const std::vector<unsigned int>& indices) {
+    if (mesh.VAO == 0 || mesh.VBO == 0 || mesh.EBO == 0) {
+        releaseChunkMesh(mesh);
+        return uploadChunkMesh(mesh, vertices, indices);
+    }
+    // Same objects, new storage: the driver orphans the old data if a draw still reads it, and
+    // the VAO's attribute setup stays valid
+    glBindVertexArray(mesh.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    mesh.indexCount = static_cast<int>(indices.size());
+    return true;
+}
+
+void GLRenderBackend::releaseChunkMesh(ChunkMesh& mesh) {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (mesh.VAO != 0) {
+            pendingVertexArrays_.push_back(mesh.VAO);
+        }
+        if (mesh.VBO != 0) {
+            pendingBuffers_.push_back(mesh.VBO);
+        }
+        if (mesh.EBO != 0) {
+            pendingBuffers_.push_back(mesh.EBO);
+        }
+    }
+    mesh = ChunkMesh();
+}
+
+// Render a pre-built chunk surface mesh using a single draw call
+void GLRenderBackend::renderChunkMesh(const ChunkMesh& mesh, const glm::vec3& chunkPosition,
+                                      const glm::mat4& projection, const glm::mat4& view, bool wireframe) {
+    if (mesh.indexCount == 0 || mesh.VAO == 0) {
+        return;
+    }
+    if (Block::shaderProgram == 0) {
+        return;
+    }
+    while (glGetError() != GL_NO_ERROR) {} // Clear previous OpenGL errors
+
+    glUseProgram(Block::shaderProgram);
+
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkPosition);
+
+    GLint modelLoc = glGetUniformLocation(Block::shaderProgram, "model");
+    if (modelLoc != -1) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    GLint viewLoc = glGetUniformLocation(Block::shaderProgram, "view");
+    if (viewLoc != -1) glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+
+    GLint projLoc = glGetUniformLocation(Block::shaderProgram, "projection");
+    if (projLoc != -1) glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+
+    GLint useTextureLoc = glGetUniformLocation(Block::shaderProgram, "useTexture");
+    GLint blockColorLoc = glGetUniformLocation(Block::shaderProgram, "blockColor");
+
+    if (wireframe) {
+        if (useTextureLoc != -1) glUniform1i(useTextureLoc, 0); // Don't use texture in wireframe
+        if (blockColorLoc != -1) {
+            float r = (static_cast<int>(chunkPosition.x) * 0.1f) + 0.2f;
+            float g = (static_cast<int>(chunkPosition.z) * 0.1f) + 0.2f;
+            float b = 0.8f;
+            glUniform3f(blockColorLoc, r, g, b);
+        }
+    } else {
+        if (useTextureLoc != -1) {
+            if (Block::spritesheetLoaded && Block::spritesheetTexture.getID() != 0) {
+                glUniform1i(useTextureLoc, 1);
+                glActiveTexture(GL_TEXTURE0);
+                Block::spritesheetTexture.bind(0);
+                glUniform1i(glGetUniformLocation(Block::shaderProgram, "blockTexture"), 0);
+            } else {
+                glUniform1i(useTextureLoc, 0);
+                if (blockColorLoc != -1) {
+                    glUniform3f(blockColorLoc, 0.5f, 0.2f, 0.8f); // Fallback purple
+                }
+            }
+        }
+    }
+
+    glBindVertexArray(mesh.VAO);
+    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        AZV_LOG_ERROR(Render) << "OpenGL error after rendering chunk at " << chunkPosition.x << "," << chunkPosition.z << ": " << error;
+    }
+}
+
+void GLRenderBackend::releaseVertexArray(unsigned int vertexArrayId) {
+    if (vertexArrayId != 0) {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingVertexArrays_.push_back(vertexArrayId);
+    }
+}
+
+void GLRenderBackend::releaseBuffer(unsigned int bufferId) {
+    if (bufferId != 0) {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingBuffers_.push_back(bufferId);
+    }
+}
+
+unsigned int GLRenderBackend::acquireVertexArray() {
+    if (!freeVertexArrays_.empty()) {
+        unsigned int id = freeVertexArrays_.back();
+        freeVertexArrays_.pop_back();
+        ++recycledObjects_;
+        return id;
+    }
+    unsigned int id = 0;
+    glGenVertexArrays(1, &id);
+    if (glGetError() != GL_NO_ERROR) {
+        return 0;
+    }
+    ++generatedObjects_;
+    return id;
+}
+
+unsigned int GLRenderBackend::acquireBuffer() {
+    if (!freeBuffers_.empty()) {
+        unsigned int id = freeBuffers_.back();
+        freeBuffers_.pop_back();
+        ++recycledObjects_;
+        return id;
+    }
+    unsigned int id = 0;
+    glGenBuffers(1, &id);
+    if (glGetError() != GL_NO_ERROR) {
+        return 0;
+    }
+    ++generatedObjects_;
+    return id;
+}
+
+void GLRenderBackend::processPendingReleases() {
+    std::vector<unsigned int> vertexArrays;
+    std::vector<unsigned int> buffers;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (pendingVertexArrays_.empty() && pendingBuffers_.empty()) {
+            return;
+        }
+        // Oldest first; anything past the batch size waits for the next frame
+        size_t vertexArrayCount = std::min(pendingVertexArrays_.size(), MAX_RELEASES_PER_FRAME);
+        vertexArrays.assign(pendingVertexArrays_.begin(), pendingVertexArrays_.begin() + vertexArrayCount);
+        pendingVertexArrays_.erase(pendingVertexArrays_.begin(), pendingVertexArrays_.begin() + vertexArrayCount);
+        size_t bufferCount = std::min(pendingBuffers_.size(), MAX_RELEASES_PER_FRAME);
+        buffers.assign(pendingBuffers_.begin(), pendingBuffers_.begin() + bufferCount);
+        pendingBuffers_.erase(pendingBuffers_.begin(), pendingBuffers_.begin() + bufferCount);
+    }
+
+    std::vector<unsigned int> deleteVertexArrays;
+    for (unsigned int id : vertexArrays) {
+        if (freeVertexArrays_.size() < MAX_FREE_VERTEX_ARRAYS) {
+            freeVertexArrays_.push_back(id);
+        } else {
+            deleteVertexArrays.push_back(id);
+        }
+    }
+    std::vector<unsigned int> deleteBuffers;
+    for (unsigned int id : buffers) {
+        if (freeBuffers_.size() < MAX_FREE_BUFFERS) {
+            // Drop the storage now; the handle is refilled by the next upload that takes it
+            glBindBuffer(GL_ARRAY_BUFFER, id);
+            glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+            freeBuffers_.push_back(id);
+        } else {
+            deleteBuffers.push_back(id);
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (!deleteVertexArrays.empty()) {
+        glDeleteVertexArrays(static_cast<GLsizei>(deleteVertexArrays.size()), deleteVertexArrays.data());
+    }
+    if (!deleteBuffers.empty()) {
+        glDeleteBuffers(static_cast<GLsizei>(deleteBuffers.size()), deleteBuffers.data());
+    }
+    deletedObjects_ += deleteVertexArrays.size() + deleteBuffers.size();
+}
+
+void GLRenderBackend::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        freeVertexArrays_.insert(freeVertexArrays_.end(), pendingVertexArrays_.begin(), pendingVertexArrays_.end());
+        freeBuffers_.insert(freeBuffers_.end(), pendingBuffers_.begin(), pendingBuffers_.end());
+        pendingVertexArrays_.clear();
+        pendingBuffers_.clear();
+    }
+    if (!freeVertexArrays_.empty()) {
+        glDeleteVertexArrays(static_cast<GLsizei>(freeVertexArrays_.size()), freeVertexArrays_.data());
+    }
+    if (!freeBuffers_.empty()) {
+        glDeleteBuffers(static_cast<GLsizei>(freeBuffers_.size()), freeBuffers_.data());
+    }
+    deletedObjects_ += freeVertexArrays_.size() + freeBuffers_.size();
+    freeVertexArrays_.clear();
+    freeBuffers_.clear();
+    AZV_LOG_INFO(Render) << "GL chunk objects: " << generatedObjects_ << " generated, " << recycledObjects_
+                         << " recycled, " << deletedObjects_ << " deleted";
+}
@@ -0,0 +1,554 @@
+#include "../headers/light_engine.h"
+#include "../headers/block_registry.h"
+#include "../headers/chunk.h"
+#include "../headers/voxel_data.h" // IVec3Hash
+#include "../headers/profiler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+
+// Voxel indices are unpacked with fixed shifts (x at bit 8, y at bit 4) and nodes keep the index
+// in their low 12 bits, so the engine only handles 16^3 chunks
+static_assert(CHUNK_SIZE_X == 16 && CHUNK_SIZE_Y == 16 && CHUNK_SIZE_Z == 16,
+              "the light engine's index math expects 16x16x16 chunks");
+
+constexpr int SIZE = CHUNK_SIZE_X; // Chunks are cubes
+constexpr int LAST = SIZE - 1;
+constexpr uint8_t MAX_LEVEL = LightData::MAX_LEVEL;
+
+// Index step to the face neighbour, in mesher face order (-Z, +Z, -X, +X, -Y, +Y); VoxelData
+// stores z fastest, then y, then x
+constexpr int FACE_STEP[6] = {-1, 1, -SIZE * SIZE, SIZE * SIZE, -SIZE, SIZE};
+const glm::ivec3 FACE_OFFSET[6] = {
+    {0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}
+};
+
+constexpr int OUTSIDE = -1; // Chunk not in the region: light entering it becomes a spill seed
+constexpr int ABSENT = -2;  // No chunk at all: light entering it is dropped
+
+// Coordinate of a voxel along the axis of a face
+inline int axisCoordinate(uint32_t index, int face) {
+    switch (face >> 1) {
+        case 0: return static_cast<int>(index & LAST);              // z
+        case 1: return static_cast<int>(index >> 8);                // x
+        default: return static_cast<int>((index >> 4) & LAST);      // y
+    }
+}
+
+inline bool onFace(uint32_t index, int face) {
+    return axisCoordinate(index, face) == ((face & 1) ? LAST : 0);
+}
+
+// Voxel of the given face layer; a and b walk the other two axes
+inline uint32_t faceLayerIndex(int face, int a, int b) {
+    const int fixed = (face & 1) ? LAST : 0;
+    switch (face >> 1) {
+        case 0: return static_cast<uint32_t>(VoxelData::index(a, b, fixed));
+        case 1: return static_cast<uint32_t>(VoxelData::index(fixed, a, b));
+        default: return static_cast<uint32_t>(VoxelData::index(a, fixed, b));
+    }
+}
+
+inline int sectionOf(uint32_t index) {
+    return Chunk::sectionIndex(static_cast<int>(index >> 8), static_cast<int>((index >> 4) & LAST),
+                               static_cast<int>(index & LAST));
+}
+
+// Queue node: slot in the high 16 bits, then the level (4 bits) and the voxel index (12 bits)
+inline uint32_t packNode(int slot, uint32_t index, uint8_t level) {
+    return (static_cast<uint32_t>(slot) << 16) | (static_cast<uint32_t>(level) << 12) | index;
+}
+inline int nodeSlot(uint32_t node) { return static_cast<int>(node >> 16); }
+inline uint8_t nodeLevel(uint32_t node) { return static_cast<uint8_t>((node >> 12) & 0x0F); }
+inline uint32_t nodeIndex(uint32_t node) { return node & 0x0FFF; }
+
+// Per-thread queues, reused by every pass so a batch allocates nothing per node
+struct LightQueues {
+    std::vector<uint32_t> add;
+    std::vector<uint32_t> remove;
+};
+
+LightQueues& threadQueues() {
+    thread_local LightQueues queues;
+    return queues;
+}
+
+struct Slot {
+    glm::ivec3 key{0};
+    const VoxelData* voxels = nullptr;
+    uint8_t* light = nullptr;        // Written only when writable
+    bool writable = false;
+    LightSkyContext sky;
+    std::array<int, 6> neighbors{{ABSENT, ABSENT, ABSENT, ABSENT, ABSENT, ABSENT}};
+    std::array<uint64_t, VoxelData::VOLUME / 64> changed{};
+    bool anyChanged = false;
+};
+
+// One channel's flood fill over a set of chunk slots
+class LightPass {
+public:
+    LightPass(std::vector<Slot>& slots, LightChannel channel, std::vector<LightSeed>* spills)
+        : slots_(slots), channel_(channel), spills_(spills), registry_(BlockRegistry::getInstance()),
+          queues_(threadQueues()) {
+        queues_.add.clear();
+        queues_.remove.clear();
+    }
+
+    uint8_t get(int slot, uint32_t index) const {
+        const uint8_t value = slots_[slot].light[index];
+        return channel_ == LightChannel::SKY ? static_cast<uint8_t>(value >> 4) : static_cast<uint8_t>(value & 0x0F);
+    }
+
+    void set(int slot, uint32_t index, uint8_t level) {
+        Slot& s = slots_[slot];
+        uint8_t& value = s.light[index];
+        const uint8_t next = channel_ == LightChannel::SKY ? static_cast<uint8_t>((value & 0x0F) | (level << 4))
+                                                           : static_cast<uint8_t>((value & 0xF0) | level);
+        if (next != value) {
+            value = next;
+            s.changed[index >> 6] |= uint64_t(1) << (index & 63);
+            s.anyChanged = true;
+        }
+    }
+
+    uint16_t typeAt(int slot, uint32_t index) const {
+        return static_cast<uint16_t>(slots_[slot].voxels->atIndex(index).type);
+    }
+    bool opaque(int slot, uint32_t index) const { return registry_.isBlockOpaque(typeAt(slot, index)); }
+    uint8_t emission(int slot, uint32_t index) const {
+        return channel_ == LightChannel::BLOCK ? registry_.getBlockLightLevel(typeAt(slot, index)) : 0;
+    }
+
+    // Face neighbour of a voxel: its slot (or OUTSIDE / ABSENT) and index in that slot
+    int step(int slot, uint32_t index, int face, uint32_t& neighborIndex) const {
+        if (onFace(index, face)) {
+            neighborIndex = static_cast<uint32_t>(static_cast<int>(index) - FACE_STEP[face] * LAST);
+            return slots_[slot].neighbors[face];
+        }
+        neighborIndex = static_cast<uint32_t>(static_cast<int>(index) + FACE_STEP[face]);
+        return slot;
+    }
+
+    // Level light of the given level has after one step through face
+    uint8_t propagated(int slot, int face, uint8_t level) const {
+        if (channel_ == LightChannel::SKY && level == MAX_LEVEL && face == slots_[slot].sky.downFace) {
+            return MAX_LEVEL;
+        }
+        return level > 0 ? static_cast<uint8_t>(level - 1) : 0;
+    }
+
+    // Removal threshold one step through face: dependent light below it came from the removed light
+    uint8_t removalThreshold(int slot, int face, uint8_t level) const {
+        if (channel_ == LightChannel::SKY && level == MAX_LEVEL && face == slots_[slot].sky.downFace) {
+            return MAX_LEVEL + 1;
+        }
+        return level;
+    }
+
+    bool upFaceOpenToSky(int slot, uint32_t index) const {
+        const Slot& s = slots_[slot];
+        const int upFace = s.sky.downFace ^ 1;
+        return s.sky.openSky && s.neighbors[upFace] < 0 && onFace(index, upFace);
+    }
+
+    void pushAdd(int slot, uint32_t index) { queues_.add.push_back(packNode(slot, index, 0)); }
+
+    // Light of level reaches a voxel of a writable slot
+    void offer(int slot, uint32_t index, uint8_t level) {
+        if (level > get(slot, index) && !opaque(slot, index)) {
+            set(slot, index, level);
+            pushAdd(slot, index);
+        }
+    }
+
+    // Light that reached a voxel with the given removal threshold is gone
+    void removeAt(int slot, uint32_t index, uint8_t threshold) {
+        const uint8_t level = get(slot, index);
+        if (level == 0) {
+            return;
+        }
+        if (level < threshold) {
+            set(slot, index, 0);
+            queues_.remove.push_back(packNode(slot, index, level));
+            if (uint8_t emitted = emission(slot, index)) {
+                set(slot, index, emitted);
+                pushAdd(slot, index);
+            }
+        } else {
+            // Lit from elsewhere: re-propagate it into the cleared area
+            pushAdd(slot, index);
+        }
+    }
+
+    // The block of a voxel changed: drop its light and let its surroundings, its emission and
+    // open sky above it light it again
+    void edit(int slot, uint32_t index) {
+        const uint8_t old = get(slot, index);
+        if (old > 0) {
+            set(slot, index, 0);
+            queues_.remove.push_back(packNode(slot, index, old));
+        }
+        if (!opaque(slot, index)) {
+            for (int face = 0; face < 6; ++face) {
+                uint32_t neighborIndex;
+                const int neighbor = step(slot, index, face, neighborIndex);
+                if (neighbor >= 0 && slots_[neighbor].writable && get(neighbor, neighborIndex) > 0) {
+                    pushAdd(neighbor, neighborIndex);
+                }
+            }
+            if (channel_ == LightChannel::SKY && upFaceOpenToSky(slot, index)) {
+                set(slot, index, MAX_LEVEL);
+                pushAdd(slot, index);
+            }
+        }
+        if (uint8_t emitted = emission(slot, index)) {
+            set(slot, index, emitted);
+            pushAdd(slot, index);
+        }
+    }
+
+    void seedOpenSky(int slot) {
+        const Slot& s = slots_[slot];
+        const int upFace = s.sky.downFace ^ 1;
+        if (channel_ != LightChannel::SKY || !s.sky.openSky || s.neighbors[upFace] >= 0) {
+            return;
+        }
+        for (int a = 0; a < SIZE; ++a) {
+            for (int b = 0; b < SIZE; ++b) {
+                const uint32_t index = faceLayerIndex(upFace, a, b);
+                if (!opaque(slot, index)) {
+                    set(slot, index, MAX_LEVEL);
+                    pushAdd(slot, index);
+                }
+            }
+        }
+    }
+
+    void seedEmitters(int slot) {
+        if (channel_ != LightChannel::BLOCK) {
+            return;
+        }
+        const VoxelData& voxels = *slots_[slot].voxels;
+        const bool anyEmitter = std::any_of(voxels.palette().begin(), voxels.palette().end(),
+                                            [&](uint16_t type) { return registry_.getBlockLightLevel(type) > 0; });
+        if (!anyEmitter) {
+            return;
+        }
+        for (uint32_t index = 0; index < VoxelData::VOLUME; ++index) {
+            if (uint8_t emitted = emission(slot, index)) {
+                set(slot, index, emitted);
+                pushAdd(slot, index);
+            }
+        }
+    }
+
+    // Pull the light of a read-only neighbour slot across the face it shares with slot
+    void seedFromNeighbor(int slot, int face) {
+        const int neighbor = slots_[slot].neighbors[face];
+        if (neighbor < 0) {
+            return;
+        }
+        for (int a = 0; a < SIZE; ++a) {
+            for (int b = 0; b < SIZE; ++b) {
+                const uint32_t index = faceLayerIndex(face, a, b);
+                const uint32_t neighborIndex = static_cast<uint32_t>(static_cast<int>(index) - FACE_STEP[face] * LAST);
+                const uint8_t level = get(neighbor, neighborIndex);
+                if (level > 1) {
+                    offer(slot, index, propagated(neighbor, face ^ 1, level));
+                }
+            }
+        }
+    }
+
+    void spill(int slot, int face, uint32_t neighborIndex, LightSeed::Kind kind, uint8_t level) {
+        if (!spills_) {
+            return;
+        }
+        LightSeed seed;
+        seed.chunk = slots_[slot].key + FACE_OFFSET[face];
+        seed.index = static_cast<uint16_t>(neighborIndex);
+        seed.kind = kind;
+        seed.channel = channel_;
+        seed.level = level;
+        spills_->push_back(seed);
+    }
+
+    void runRemovals() {
+        std::vector<uint32_t>& queue = queues_.remove;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const uint32_t node = queue[head];
+            const int slot = nodeSlot(node);
+            const uint32_t index = nodeIndex(node);
+            const uint8_t level = nodeLevel(node);
+            for (int face = 0; face < 6; ++face) {
+                uint32_t neighborIndex;
+                const int neighbor = step(slot, index, face, neighborIndex);
+                const uint8_t threshold = removalThreshold(slot, face, level);
+                if (neighbor == ABSENT) {
+                    continue;
+                }
+                if (neighbor == OUTSIDE || !slots_[neighbor].writable) {
+                    spill(slot, face, neighborIndex, LightSeed::REMOVE, threshold);
+                    continue;
+                }
+                removeAt(neighbor, neighborIndex, threshold);
+            }
+        }
+        queue.clear();
+    }
+
+    void runAdds() {
+        std::vector<uint32_t>& queue = queues_.add;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const uint32_t node = queue[head];
+            const int slot = nodeSlot(node);
+            const uint32_t index = nodeIndex(node);
+            const uint8_t level = get(slot, index);
+            if (level <= 1) {
+                continue; // Nothing left to pass on
+            }
+            for (int face = 0; face < 6; ++face) {
+                uint32_t neighborIndex;
+                const int neighbor = step(slot, index, face, neighborIndex);
+                const uint8_t next = propagated(slot, face, level);
+                if (neighbor == ABSENT || next == 0) {
+                    continue;
+                }
+                if (neighbor == OUTSIDE) {
+                    spill(slot, face, neighborIndex, LightSeed::ADD, next);
+                } else if (!slots_[neighbor].writable) {
+                    // Read-only neighbour: only report light that would brighten it
+                    if (next > get(neighbor, neighborIndex) && !opaque(neighbor, neighborIndex)) {
+                        spill(slot, face, neighborIndex, LightSeed::ADD, next);
+                    }
+                } else {
+                    offer(neighbor, neighborIndex, next);
+                }
+            }
+        }
+        queue.clear();
+    }
+
+private:
+    std::vector<Slot>& slots_;
+    LightChannel channel_;
+    std::vector<LightSeed>* spills_;
+    const BlockRegistry& registry_;
+    LightQueues& queues_;
+};
+
+constexpr LightChannel CHANNELS[2] = {LightChannel::SKY, LightChannel::BLOCK};
+
+// Slots for a region, one per chunk with data, linked to their face neighbours in the region
+std::vector<Slot> regionSlots(const std::vector<LightRegionChunk>& region, std::vector<std::shared_ptr<LightData>>& copies) {
+    std::vector<Slot> slots;
+    slots.reserve(region.size());
+    copies.clear();
+    std::unordered_map<glm::ivec3, int, IVec3Hash> slotOf;
+    for (const LightRegionChunk& chunk : region) {
+        if (!chunk.voxels || slotOf.count(chunk.key)) {
+            continue;
+        }
+        auto copy = chunk.light ? std::make_shared<LightData>(*chunk.light) : std::make_shared<LightData>();
+        Slot slot;
+        slot.key = chunk.key;
+        slot.voxels = chunk.voxels.get();
+        slot.light = copy->values.data();
+        slot.writable = true;
+        slot.sky = chunk.sky;
+        slotOf[chunk.key] = static_cast<int>(slots.size());
+        slots.push_back(slot);
+        copies.push_back(std::move(copy));
+    }
+    for (Slot& slot : slots) {
+        for (int face = 0; face < 6; ++face) {
+            auto it = slotOf.find(slot.key + FACE_OFFSET[face]);
+            slot.neighbors[face] = it != slotOf.end() ? it->second : OUTSIDE;
+        }
+    }
+    return slots;
+}
+
+// New light and dirty sections of every slot the passes changed
+LightBatchResult collectResult(std::vector<Slot>& slots, std::vector<std::shared_ptr<LightData>>& copies,
+                               std::vector<LightSeed>& spills) {
+    LightBatchResult result;
+    std::vector<uint32_t> dirty(slots.size(), 0);
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        const Slot& s = slots[slot];
+        if (!s.anyChanged) {
+            continue;
+        }
+        for (size_t word = 0; word < s.changed.size(); ++word) {
+            uint64_t bits = s.changed[word];
+            while (bits != 0) {
+                const uint32_t index = static_cast<uint32_t>(word * 64 + countTrailingZeros(bits));
+                bits &= bits - 1;
+                ++result.changedVoxels;
+                // The faces sampling a voxel's light belong to its six neighbours
+                for (int face = 0; face < 6; ++face) {
+                    int neighbor = static_cast<int>(slot);
+                    uint32_t neighborIndex;
+                    if (onFace(index, face)) {
+                        neighbor = s.neighbors[face];
+                        neighborIndex = static_cast<uint32_t>(static_cast<int>(index) - FACE_STEP[face] * LAST);
+                    } else {
+                        neighborIndex = static_cast<uint32_t>(static_cast<int>(index) + FACE_STEP[face]);
+                    }
+                    if (neighbor >= 0) {
+                        dirty[neighbor] |= 1u << sectionOf(neighborIndex);
+                    }
+                }
+            }
+        }
+    }
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        if (!slots[slot].anyChanged && dirty[slot] == 0) {
+            continue;
+        }
+        LightUpdate update;
+        update.key = slots[slot].key;
+        update.dirtySections = dirty[slot];
+        if (slots[slot].anyChanged) {
+            update.light = std::move(copies[slot]);
+        }
+        result.updates.push_back(std::move(update));
+    }
+    result.spills.swap(spills);
+    return result;
+}
+
+} // namespace
+
+LightSkyContext skyContextForChunk(const glm::vec3& chunkPosition, const std::optional<glm::vec3>& planetCenter,
+                                   const std::optional<float>& planetRadius) {
+    LightSkyContext sky;
+    if (!planetCenter.has_value() || !planetRadius.has_value()) {
+        return sky;
+    }
+    // Down is the axis pointing most directly at the planet centre
+    const float chunkSize = static_cast<float>(SIZE);
+    const glm::vec3 toCenter = planetCenter.value() - (chunkPosition + glm::vec3(chunkSize * 0.5f));
+    const glm::vec3 magnitude(std::abs(toCenter.x), std::abs(toCenter.y), std::abs(toCenter.z));
+    int axisFace; // First face of the axis: 0 = Z, 2 = X, 4 = Y
+    float component;
+    if (magnitude.y >= magnitude.x && magnitude.y >= magnitude.z) {
+        axisFace = 4;
+        component = toCenter.y;
+    } else if (magnitude.x >= magnitude.z) {
+        axisFace = 2;
+        component = toCenter.x;
+    } else {
+        axisFace = 0;
+        component = toCenter.z;
+    }
+    sky.downFace = axisFace + (component > 0.0f ? 1 : 0);
+
+    // Open sky when the planet never creates the chunk above (same test as Planet::update)
+    const glm::vec3 upCenter = chunkPosition + glm::vec3(chunkSize * 0.5f) + glm::vec3(FACE_OFFSET[sky.downFace ^ 1]) * chunkSize;
+    sky.openSky = glm::length(upCenter - planetCenter.value()) > planetRadius.value() + chunkSize * 1.732f;
+    return sky;
+}
+
+void LightEngine::lightChunk(const VoxelData& voxels, const ChunkNeighbors& neighbors, const LightSkyContext& sky,
+                             LightData& light, std::vector<LightSeed>* spills) {
+    AZV_PROFILE_ZONE("LightEngine::lightChunk");
+    light.values.fill(0);
+
+    // Slot 0 is the chunk; lit neighbours are read-only slots that only feed it and receive spills
+    std::vector<Slot> slots(1);
+    slots[0].voxels = &voxels;
+    slots[0].light = light.values.data();
+    slots[0].writable = true;
+    slots[0].sky = sky;
+    for (int face = 0; face < 6; ++face) {
+        if (!neighbors.faces[face] || !neighbors.light[face]) {
+            continue;
+        }
+        Slot neighbor;
+        neighbor.key = FACE_OFFSET[face];
+        neighbor.voxels = neighbors.faces[face].get();
+        neighbor.light = const_cast<uint8_t*>(neighbors.light[face]->values.data());
+        neighbor.sky = sky;
+        neighbor.neighbors[face ^ 1] = 0;
+        slots[0].neighbors[face] = static_cast<int>(slots.size());
+        slots.push_back(neighbor);
+    }
+
+    for (LightChannel channel : CHANNELS) {
+        LightPass pass(slots, channel, spills);
+        pass.seedOpenSky(0);
+        pass.seedEmitters(0);
+        for (int face = 0; face < 6; ++face) {
+            pass.seedFromNeighbor(0, face);
+        }
+        pass.runAdds();
+    }
+}
+
+LightBatchResult LightEngine::propagate(const std::vector<LightRegionChunk>& region, const std::vector<LightSeed>& seeds) {
+    AZV_PROFILE_ZONE("LightEngine::propagate");
+    std::vector<std::shared_ptr<LightData>> copies;
+    std::vector<Slot> slots = regionSlots(region, copies);
+    std::unordered_map<glm::ivec3, int, IVec3Hash> slotOf;
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        slotOf[slots[slot].key] = static_cast<int>(slot);
+    }
+
+    std::vector<LightSeed> spills;
+    for (LightChannel channel : CHANNELS) {
+        // Every removal runs before any light is added, so added light is never cleared by a
+        // removal that was queued before it
+        LightPass pass(slots, channel, &spills);
+        for (const LightSeed& seed : seeds) {
+            auto it = slotOf.find(seed.chunk);
+            if (it == slotOf.end() || seed.index >= VoxelData::VOLUME) {
+                continue;
+            }
+            if (seed.kind == LightSeed::EDIT) {
+                pass.edit(it->second, seed.index);
+            } else if (seed.kind == LightSeed::REMOVE && seed.channel == channel) {
+                pass.removeAt(it->second, seed.index, seed.level);
+            }
+        }
+        pass.runRemovals();
+        for (const LightSeed& seed : seeds) {
+            auto it = slotOf.find(seed.chunk);
+            if (seed.kind == LightSeed::ADD && seed.channel == channel && it != slotOf.end() && seed.index < VoxelData::VOLUME) {
+                pass.offer(it->second, seed.index, std::min<uint8_t>(seed.level, MAX_LEVEL));
+            }
+        }
+        pass.runAdds();
+    }
+    return collectResult(slots, copies, spills);
+}
+
+LightBatchResult LightEngine::relight(const std::vector<LightRegionChunk>& region) {
+    AZV_PROFILE_ZONE("LightEngine::relight");
+    std::vector<std::shared_ptr<LightData>> copies;
+    std::vector<Slot> slots = regionSlots(region, copies);
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        // Cleared light counts as changed wherever it was lit before
+        for (uint32_t index = 0; index < VoxelData::VOLUME; ++index) {
+            if (slots[slot].light[index] != 0) {
+                slots[slot].light[index] = 0;
+                slots[slot].changed[index >> 6] |= uint64_t(1) << (index & 63);
+                slots[slot].anyChanged = true;
+            }
+        }
+    }
+
+    std::vector<LightSeed> spills;
+    for (LightChannel channel : CHANNELS) {
+        LightPass pass(slots, channel, &spills);
+        for (size_t slot = 0; slot < slots.size(); ++slot) {
+            pass.seedOpenSky(static_cast<int>(slot));
+            pass.seedEmitters(static_cast<int>(slot));
+        }
+        pass.runAdds();
+    }
+    return collectResult(slots, copies, spills);
+}
@@ -0,0 +1,243 @@
+#include "../headers/logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool parseLevel(const std::string& name, LogLevel& level) {
+    for (uint8_t i = 0; i <= static_cast<uint8_t>(LogLevel::Off); ++i) {
+        if (name == logLevelName(static_cast<LogLevel>(i))) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseCategory(const std::string& name, LogCategory& category) {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(LogCategory::Count); ++i) {
+        if (name == logCategoryName(static_cast<LogCategory>(i))) {
+            category = static_cast<LogCategory>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "trace";
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info:  return "info";
+        case LogLevel::Warn:  return "warn";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off:   return "off";
+    }
+    return "unknown";
+}
+
+const char* logCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General:    return "general";
+        case LogCategory::World:      return "world";
+        case LogCategory::Streaming:  return "streaming";
+        case LogCategory::Generation: return "generation";
+        case LogCategory::Meshing:    return "meshing";
+        case LogCategory::Upload:     return "upload";
+        case LogCategory::Render:     return "render";
+        case LogCategory::Registry:   return "registry";
+        default:                      return "unknown";
+    }
+}
+
+// --- LogRateLimiter ---
+
+bool LogRateLimiter::allow() {
+    int64_t now = steadyNowNs();
+    int64_t nextAllowed = nextAllowedNs_.load(std::memory_order_relaxed);
+    if (now >= nextAllowed &&
+        nextAllowedNs_.compare_exchange_strong(nextAllowed, now + intervalNs_, std::memory_order_relaxed)) {
+        return true;
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+// --- LogMessage ---
+
+LogMessage::~LogMessage() {
+    std::string text = stream_.str();
+    // Call sites converted from std::endl style may still end with a newline
+    while (!text.empty() && text.back() == '\n') {
+        text.pop_back();
+    }
+    if (limiter_) {
+        uint32_t suppressed = limiter_->takeSuppressed();
+        if (suppressed > 0) {
+            text += " (" + std::to_string(suppressed) + " similar messages suppressed)";
+        }
+    }
+    Logger::getInstance().submit(level_, category_, std::move(text));
+}
+
+// --- Logger ---
+
+Logger& Logger::getInstance() {
+    // Intentionally leaked so logging stays valid during static destruction; the writer
+    // thread is drained and joined from an atexit handler instead.
+    static Logger* instance = [] {
+        Logger* logger = new Logger();
+        std::atexit([] { Logger::getInstance().shutdown(); });
+        return logger;
+    }();
+    return *instance;
+}
+
+Logger::Logger() : dropped_(0) {
+    for (auto& threshold : thresholds_) {
+        threshold.store(static_cast<uint8_t>(LogLevel::Info), std::memory_order_relaxed);
+    }
+    if (const char* spec = std::getenv("AZUREVOXEL_LOG")) {
+        if (!configure(spec)) {
+            std::cerr << "Logger: ignoring unrecognised entries in AZUREVOXEL_LOG=\"" << spec << "\"" << std::endl;
+        }
+    }
+
+    running_ = true;
+    writer_ = std::thread(&Logger::writerLoop, this);
+}
+
+void Logger::setLevel(LogCategory category, LogLevel level) {
+    thresholds_[static_cast<size_t>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Logger::setLevel(LogLevel level) {
+    for (auto& threshold : thresholds_) {
+        threshold.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+}
+
+bool Logger::configure(const std::string& spec) {
+    bool allValid = true;
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string entry = toLower(spec.substr(start, end - start));
+        start = end + 1;
+        if (entry.empty()) continue;
+
+        LogLevel level;
+        size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            if (parseLevel(entry, level)) {
+                setLevel(level);
+            } else {
+                allValid = false;
+            }
+            continue;
+        }
+
+        LogCategory category;
+        if (parseCategory(entry.substr(0, equals), category) && parseLevel(entry.substr(equals + 1), level)) {
+            setLevel(category, level);
+        } else {
+            allValid = false;
+        }
+    }
+    return allValid;
+}
+
+void Logger::submit(LogLevel level, LogCategory category, std::string message) {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    if (!running_) {
+        // Writer already stopped (late shutdown path): write directly
+        lock.unlock();
+        writeEntry(Entry{level, category, std::move(message)});
+        return;
+    }
+    if (queue_.size() >= MAX_QUEUED_MESSAGES && level < LogLevel::Warn) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queue_.push_back(Entry{level, category, std::move(message)});
+    ++submittedCount_;
+    lock.unlock();
+    queueCondition_.notify_one();
+}
+
+void Logger::writeEntry(const Entry& entry) {
+    std::ostream& out = entry.level >= LogLevel::Warn ? std::cerr : std::cout;
+    // Verbose lines are tagged so they can be told apart once a category is turned up
+    if (entry.level <= LogLevel::Debug) {
+        out << '[' << logLevelName(entry.level) << ':' << logCategoryName(entry.category) << "] ";
+    }
+    out << entry.text << '\n';
+}
+
+void Logger::writerLoop() {
+    std::deque<Entry> batch;
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    while (true) {
+        queueCondition_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+        if (queue_.empty() && !running_) {
+            break;
+        }
+
+        batch.swap(queue_);
+        lock.unlock();
+        for (const auto& entry : batch) {
+            writeEntry(entry);
+        }
+        // One flush per batch instead of one per line
+        std::cout.flush();
+        std::cerr.flush();
+        size_t written = batch.size();
+        batch.clear();
+        lock.lock();
+
+        writtenCount_ += written;
+        drainedCondition_.notify_all();
+    }
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    if (!running_) return;
+    uint64_t target = submittedCount_;
+    drainedCondition_.wait(lock, [this, target] { return writtenCount_ >= target || !running_; });
+}
+
+void Logger::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    queueCondition_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    drainedCondition_.notify_all();
+
+    uint64_t dropped = droppedMessages();
+    if (dropped > 0) {
+        std::cerr << "Logger: " << dropped << " messages were dropped because the queue was full" << std::endl;
+    }
+    std::cout.flush();
+}
@@ -0,0 +1,76 @@
+#include "../headers/mesh_scratch.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+
+namespace {
+
+std::atomic<uint64_t> meshCount{0};
+std::atomic<uint64_t> reallocationCount{0};
+std::atomic<uint64_t> meshesWithReallocationCount{0};
+std::atomic<size_t> peakVertexFloats{0};
+std::atomic<size_t> peakIndices{0};
+
+void raiseTo(std::atomic<size_t>& peak, size_t value) {
+    size_t current = peak.load(std::memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+uint64_t& meshThreadAllocationCount() {
+    thread_local uint64_t count = 0;
+    return count;
+}
+
+MeshScratch& MeshScratch::begin() {
+    thread_local MeshScratch scratch;
+    scratch.vertices.clear();
+    scratch.indices.clear();
+    // Grow to the largest mesh seen so far up front; this is the arena's sizing, not a reallocation
+    scratch.vertices.reserve(peakVertexFloats.load(std::memory_order_relaxed));
+    scratch.indices.reserve(peakIndices.load(std::memory_order_relaxed));
+    scratch.allocationsAtBegin_ = meshThreadAllocationCount();
+    return scratch;
+}
+
+void MeshScratch::end() {
+    uint64_t reallocations = meshThreadAllocationCount() - allocationsAtBegin_;
+    meshCount.fetch_add(1, std::memory_order_relaxed);
+    if (reallocations > 0) {
+        reallocationCount.fetch_add(reallocations, std::memory_order_relaxed);
+        meshesWithReallocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    raiseTo(peakVertexFloats, vertices.size());
+    raiseTo(peakIndices, indices.size());
+}
+
+MeshAllocationStats MeshScratch::getStats() {
+    MeshAllocationStats stats;
+    stats.meshes = meshCount.load(std::memory_order_relaxed);
+    stats.reallocations = reallocationCount.load(std::memory_order_relaxed);
+    stats.meshesWithReallocation = meshesWithReallocationCount.load(std::memory_order_relaxed);
+    stats.peakVertexFloats = peakVertexFloats.load(std::memory_order_relaxed);
+    stats.peakIndices = peakIndices.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MeshScratch::resetStats() {
+    meshCount.store(0, std::memory_order_relaxed);
+    reallocationCount.store(0, std::memory_order_relaxed);
+    meshesWithReallocationCount.store(0, std::memory_order_relaxed);
+}
+
+void MeshAllocationStats::printStatus(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    double perMesh = meshes > 0 ? static_cast<double>(reallocations) / static_cast<double>(meshes) : 0.0;
+    out << std::fixed << std::setprecision(3)
+        << meshes << " meshes, " << reallocations << " scratch reallocations (" << perMesh << " per mesh, "
+        << meshesWithReallocation << " meshes grew), peak " << peakVertexFloats / CHUNK_VERTEX_FLOATS << " vertices / "
+        << peakIndices << " indices";
+
+    out.copyfmt(oldState);
+}
@@ -1,9 +1,13 @@
 #include "headers/planet.h"
 #include "headers/world.h" // For World context if needed by chunks
 #include "headers/block.h" // For Block class
+#include "headers/block_registry.h"
+#include "headers/profiler.h"
+#include "headers/logger.h"
 #include <iostream> // For debugging output
 #include <cmath>    // For std::ceil, std::floor, std::sqrt
 #include <algorithm> // For std::sort
+#include <unordered_set>
 
 // Helper to convert world position to chunk's 3D grid key relative to planet center
 glm::ivec3 worldToPlanetChunkKey(const glm::vec3& worldPos, const glm::vec3& planetCenter, float chunkSize) {
@@ -15,6 +19,11 @@ glm::ivec3 worldToPlanetChunkKey(const glm::vec3& worldPos, const glm::vec3& pla
     );
 }
 
+// Face-adjacent chunk offsets, in ChunkNeighbors order (-Z, +Z, -X, +X, -Y, +Y)
+static const glm::ivec3 FACE_NEIGHBOR_OFFSETS[6] = {
+    {0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}
+};
+
 Planet::Planet(glm::vec3 position, float radius, int seed, const std::string& name)
     : position_(position), radius_(radius), seed_(seed), name_(name) {
     
@@ -23,102 +32,178 @@ Planet::Planet(glm::vec3 position, float radius, int seed, const std::string& na
     float chunkSize = static_cast<float>(CHUNK_SIZE_X); 
     chunksInRadius_ = static_cast<int>(std::ceil(radius_ / chunkSize));
 
-    std::cout << "Planet '" << name_ << "' created at (" << position.x << "," << position.y << "," << position.z
-              << ") with radius " << radius_ << " and seed " << seed_ 
-              << ". Chunks in radius: " << chunksInRadius_ << std::endl;
+    AZV_LOG_INFO(Streaming) << "Planet '" << name_ << "' created at (" << position.x << "," << position.y << "," << position.z
+                            << ") with radius " << radius_ << " and seed " << seed_ 
+                            << ". Chunks in radius: " << chunksInRadius_;
     
     // Don't generate the entire planet structure upfront for large planets
     // Instead, chunks will be generated dynamically near the player
-    std::cout << "Planet '" << name_ << "' will generate chunks dynamically near the player." << std::endl;
+    AZV_LOG_INFO(Streaming) << "Planet '" << name_ << "' will generate chunks dynamically near the player.";
 }
 
 Planet::~Planet() {
+    residencyCache_.clear();
     chunks_.clear(); // shared_ptrs will handle individual Chunk deallocation
-    std::cout << "Planet '" << name_ << "' destroyed." << std::endl;
+    AZV_LOG_INFO(Streaming) << "Planet '" << name_ << "' destroyed.";
 }
 
 void Planet::update(const Camera& camera, const World* world_context) {
+    AZV_PROFILE_ZONE("Planet::update");
+    // Edits made since the last frame become visible before this frame renders
+    rebuildEditedChunks();
     activeChunkKeys_.clear();
 
     if (!world_context) {
-        std::cerr << "Planet::update - world_context is null for planet " << name_ << std::endl;
+        AZV_LOG_ERROR(Streaming) << "Planet::update - world_context is null for planet " << name_;
         return;
     }
 
+    // Streaming radius and admission limit follow the world's frame budget controller
+    const StreamingBudgetController& budget = world_context->getStreamingBudget();
+    chunkRenderDistance_ = budget.renderDistance();
+    maxChunksPerFrame_ = budget.chunksPerFrame();
+
     glm::vec3 camPos = camera.getPosition();
     float chunkSizeF = static_cast<float>(CHUNK_SIZE_X); // Assuming uniform chunk size
 
-    // Check if player is close enough to the planet to warrant chunk generation
-    float distanceToPlanetCenter = glm::length(camPos - position_);
+    // Predict where the camera will be after the lookahead window from its smoothed velocity,
+    // capped so a teleport or a very fast fly-by does not stream a region far off the path
+    const StreamingPrefetchSettings& prefetch = world_context->getPrefetchSettings();
+    glm::vec3 lookahead = world_context->getCameraVelocity() * prefetch.lookaheadSeconds;
+    float lookaheadLength = glm::length(lookahead);
+    float maxLookahead = prefetch.maxLookaheadChunks * chunkSizeF;
+    if (lookaheadLength > maxLookahead) {
+        lookahead *= maxLookahead / lookaheadLength;
+        lookaheadLength = maxLookahead;
+    }
+    // Less than a chunk ahead is already covered by the region around the camera
+    bool prefetching = prefetch.enabled && lookaheadLength >= chunkSizeF;
+    glm::vec3 predictedPos = prefetching ? camPos + lookahead : camPos;
+
+    // Check if player (or where the player is heading) is close enough to the planet to warrant chunk generation
+    float distanceToPlanetCenter = std::min(glm::length(camPos - position_), glm::length(predictedPos - position_));
     float planetSurfaceDistance = distanceToPlanetCenter - radius_;
     
     // Only generate chunks if player is within a reasonable distance of the planet surface
     float maxGenerationDistance = chunkSizeF * chunkRenderDistance_ * 2.0f; // 2x render distance
     if (planetSurfaceDistance > maxGenerationDistance) {
-        std::cout << "Player too far from planet " << name_ << " (distance: " << planetSurfaceDistance << "), skipping chunk generation" << std::endl;
+        AZV_LOG_RATE_LIMITED(LogLevel::Info, LogCategory::Streaming, 5000) << "Player too far from planet " << name_ << " (distance: " << planetSurfaceDistance << "), skipping chunk generation";
         
-        // Aggressively clean up all chunks when player is very far away
+        // Park all chunks when player is very far away; the residency cache trims them to its budgets
         if (planetSurfaceDistance > maxGenerationDistance * 3.0f && !chunks_.empty()) {
-            std::cout << "Player very far from planet " << name_ << " - cleaning up all " << chunks_.size() << " chunks" << std::endl;
+            AZV_LOG_INFO(Streaming) << "Player very far from planet " << name_ << " - parking all " << chunks_.size() << " chunks";
+            for (auto& [chunkKey, chunk] : chunks_) {
+                residencyCache_.park(chunkKey, chunk);
+            }
             chunks_.clear();
         }
         
         return;
     }
 
-    glm::vec3 relativeCamPos = camPos - position_;
-    glm::ivec3 cameraChunkKey(
-        static_cast<int>(std::floor(relativeCamPos.x / chunkSizeF)),
-        static_cast<int>(std::floor(relativeCamPos.y / chunkSizeF)),
-        static_cast<int>(std::floor(relativeCamPos.z / chunkSizeF))
-    );
+    glm::ivec3 cameraChunkKey = worldToPlanetChunkKey(camPos, position_, chunkSizeF);
+    glm::ivec3 predictedChunkKey = worldToPlanetChunkKey(predictedPos, position_, chunkSizeF);
+    glm::vec3 cameraFront = camera.getFront();
+
+    // Streaming priority (lower = sooner). Chunks in front of the camera are needed before the ones
+    // behind it, and chunks around the predicted position rank by their distance from it, slightly
+    // behind chunks the camera needs right now.
+    auto streamingPriority = [&](const glm::ivec3& chunkKey) {
+        glm::vec3 toChunk = glm::vec3(chunkKey - cameraChunkKey);
+        float distance = glm::length(toChunk);
+        if (distance > 0.0f) {
+            float facing = glm::dot(toChunk / distance, cameraFront);
+            distance *= 1.0f - prefetch.facingBias * std::max(0.0f, facing);
+        }
+        if (prefetching) {
+            float predictedDistance = glm::length(glm::vec3(chunkKey - predictedChunkKey));
+            distance = std::min(distance, predictedDistance + prefetch.lookaheadPenaltyChunks);
+        }
+        return distance;
+    };
 
-    // Collect chunks that need to be active, sorted by distance
+    // Collect chunks that need to be active (the sphere around the camera plus, when moving, the
+    // sphere around the predicted position), sorted by streaming priority
     std::vector<std::pair<float, glm::ivec3>> chunksToCheck;
-    
-    for (int x_offset = -chunkRenderDistance_; x_offset <= chunkRenderDistance_; ++x_offset) {
-        for (int y_offset = -chunkRenderDistance_; y_offset <= chunkRenderDistance_; ++y_offset) {
-            for (int z_offset = -chunkRenderDistance_; z_offset <= chunkRenderDistance_; ++z_offset) {
-                glm::ivec3 currentChunkKey = cameraChunkKey + glm::ivec3(x_offset, y_offset, z_offset);
-                
-                // Calculate distance for prioritization
-                float distance = glm::length(glm::vec3(x_offset, y_offset, z_offset));
-                if (distance <= static_cast<float>(chunkRenderDistance_)) {
-                    
+    std::unordered_set<glm::ivec3, IVec3Hash> collectedKeys;
+
+    auto collectRegion = [&](const glm::ivec3& centerKey, int regionRadius) {
+        for (int x_offset = -regionRadius; x_offset <= regionRadius; ++x_offset) {
+            for (int y_offset = -regionRadius; y_offset <= regionRadius; ++y_offset) {
+                for (int z_offset = -regionRadius; z_offset <= regionRadius; ++z_offset) {
+                    if (glm::length(glm::vec3(x_offset, y_offset, z_offset)) > static_cast<float>(regionRadius)) {
+                        continue;
+                    }
+                    glm::ivec3 currentChunkKey = centerKey + glm::ivec3(x_offset, y_offset, z_offset);
+
                     // Check if this chunk should exist within the planet's bounds
                     glm::vec3 chunkCenterOffset(
                         (static_cast<float>(currentChunkKey.x) + 0.5f) * chunkSizeF,
                         (static_cast<float>(currentChunkKey.y) + 0.5f) * chunkSizeF,
                         (static_cast<float>(currentChunkKey.z) + 0.5f) * chunkSizeF
                     );
-                    
+
                     // Check if chunk intersects with planet (with some margin for chunk corners)
-                    if (glm::length(chunkCenterOffset) <= radius_ + chunkSizeF * 1.732f) {
-                        chunksToCheck.push_back({distance, currentChunkKey});
+                    if (glm::length(chunkCenterOffset) <= radius_ + chunkSizeF * 1.732f &&
+                        collectedKeys.insert(currentChunkKey).second) {
+                        chunksToCheck.push_back({streamingPriority(currentChunkKey), currentChunkKey});
                     }
                 }
             }
         }
+    };
+
+    collectRegion(cameraChunkKey, chunkRenderDistance_);
+    int prefetchRadius = std::min(prefetch.prefetchRadiusChunks, chunkRenderDistance_);
+    if (prefetching && prefetchRadius > 0) {
+        collectRegion(predictedChunkKey, prefetchRadius);
     }
     
-    // Sort by distance (closest first)
+    // Sort by priority (most urgent first)
     std::sort(chunksToCheck.begin(), chunksToCheck.end(), 
               [](const std::pair<float, glm::ivec3>& a, const std::pair<float, glm::ivec3>& b) {
-                  return a.first < b.first; // Compare only the distance
+                  return a.first < b.first; // Compare only the priority
               });
     
     int chunksProcessedThisFrame = 0;
-    int maxChunksPerFrame = 3; // Increased for better performance with threading
     
     // Process chunks in order of distance with multi-threaded pipeline
-    for (const auto& [distance, chunkKey] : chunksToCheck) {
+    for (const auto& [priority, chunkKey] : chunksToCheck) {
         activeChunkKeys_.push_back(chunkKey);
         
         auto it = chunks_.find(chunkKey);
         if (it == chunks_.end()) {
-            // Create new chunk
-            if (chunksProcessedThisFrame >= maxChunksPerFrame) {
-                break; // Limit chunks processed per frame
+            // A chunk we streamed before comes back from the residency cache with whatever it still holds;
+            // the pipeline cases below rebuild only what was dropped
+            if (std::shared_ptr<Chunk> cached = residencyCache_.take(chunkKey)) {
+                chunks_[chunkKey] = cached;
+                if (cached->hasDirtySections()) {
+                    editedChunkKeys_.insert(chunkKey);
+                }
+                auto parkedSeeds = parkedLightSeeds_.find(chunkKey);
+                if (parkedSeeds != parkedLightSeeds_.end()) {
+                    pendingLightSeeds_.insert(pendingLightSeeds_.end(), parkedSeeds->second.begin(), parkedSeeds->second.end());
+                    parkedLightSeeds_.erase(parkedSeeds);
+                }
+                if (cached->getState() == ChunkState::UNINITIALIZED) {
+                    int planet_seed = seed_;
+                    glm::vec3 planet_position = position_;
+                    float planet_radius = radius_;
+                    const_cast<World*>(world_context)->addChunkGenerationTask(
+                        [cached, world_context, planet_seed, planet_position, planet_radius]() {
+                            cached->generateDataAsync(world_context, planet_seed, planet_position, planet_radius);
+                        }
+                    );
+                }
+                AZV_LOG_DEBUG(Streaming) << "♻ Restored cached chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z
+                                         << " (state " << static_cast<int>(cached->getState()) << ")";
+                continue;
+            }
+
+            // Create new chunk; one that was evicted while parked is lit from scratch
+            parkedLightSeeds_.erase(chunkKey);
+            if (chunksProcessedThisFrame >= maxChunksPerFrame_) {
+                continue; // Limit chunks started per frame, but keep the remaining ones active
             }
             
             glm::vec3 chunkWorldPos = position_ + glm::vec3(
@@ -144,7 +229,7 @@ void Planet::update(const Camera& camera, const World* world_context) {
             );
             
             chunksProcessedThisFrame++;
-            std::cout << "🚀 Started data generation for new chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z << std::endl;
+            AZV_LOG_DEBUG(Streaming) << "🚀 Started data generation for new chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z;
             
         } else {
             // Process existing chunk through the pipeline
@@ -156,32 +241,39 @@ void Planet::update(const Camera& camera, const World* world_context) {
             switch (state) {
                 case ChunkState::DATA_READY:
                     // Start mesh building phase
-                    if (chunksProcessedThisFrame < maxChunksPerFrame) {
+                    if (chunksProcessedThisFrame < maxChunksPerFrame_ && !bordersLightRegion(chunkKey)) {
                         std::shared_ptr<Chunk> shared_chunk_ptr = chunk;
+                        // Clear before gathering: a neighbour's border edit after this point
+                        // keeps its dirty bit, since these snapshots do not hold it
+                        chunk->clearDirtySections();
+                        ChunkNeighbors neighbors = gatherNeighbors(chunkKey);
                         const_cast<World*>(world_context)->addMeshBuildingTask(
-                            [shared_chunk_ptr, world_context]() {
-                                shared_chunk_ptr->buildMeshAsync(world_context);
+                            [shared_chunk_ptr, world_context, neighbors]() {
+                                shared_chunk_ptr->buildMeshAsync(world_context, neighbors);
                             }
                         );
                         chunksProcessedThisFrame++;
-                        std::cout << "🔧 Started mesh building for chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z << std::endl;
+                        AZV_LOG_DEBUG(Streaming) << "🔧 Started mesh building for chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z;
                     }
                     break;
                     
                 case ChunkState::MESH_READY:
                     // Queue OpenGL initialization for main thread
                     {
+                        // Light the first lighting passes on to already lit neighbours, and
+                        // edits made while it ran (their own seeds found the chunk unlit)
+                        size_t firstSpill = pendingLightSeeds_.size();
+                        chunk->takeLightSpills(pendingLightSeeds_);
+                        for (size_t i = firstSpill; i < pendingLightSeeds_.size(); ++i) {
+                            pendingLightSeeds_[i].chunk += chunkKey;
+                        }
                         std::shared_ptr<Chunk> shared_chunk_ptr = chunk;
                         const_cast<World*>(world_context)->addMainThreadTask(
                             [shared_chunk_ptr, world_context]() {
-                                if (glfwGetCurrentContext() == nullptr) {
-                                    std::cerr << "Planet: No GL context for main thread OpenGL initialization!" << std::endl;
-                                    return;
-                                }
                                 shared_chunk_ptr->initializeOpenGL(const_cast<World*>(world_context));
                             }
                         );
-                        std::cout << "🎨 Queued OpenGL initialization for chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z << std::endl;
+                        AZV_LOG_DEBUG(Streaming) << "🎨 Queued OpenGL initialization for chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z;
                     }
                     break;
                     
@@ -196,13 +288,16 @@ void Planet::update(const Camera& camera, const World* world_context) {
         }
     }
     
+    dispatchLightUpdates(world_context);
+    
     if (chunksProcessedThisFrame > 0) {
-        std::cout << "🌍 Processed " << chunksProcessedThisFrame << " chunks this frame for planet " << name_ << std::endl;
+        AZV_LOG_DEBUG(Streaming) << "🌍 Processed " << chunksProcessedThisFrame << " chunks this frame for planet " << name_;
     }
     
     // Clean up distant chunks to prevent memory buildup
     std::vector<glm::ivec3> chunksToRemove;
     float cleanupDistance = chunkSizeF * (chunkRenderDistance_ + 2); // Remove chunks beyond render distance + buffer
+    float prefetchKeepDistance = chunkSizeF * (prefetchRadius + 2);   // Keep prefetched chunks until the camera arrives
     
     for (auto it = chunks_.begin(); it != chunks_.end(); ) {
         const glm::ivec3& chunkKey = it->first;
@@ -213,10 +308,12 @@ void Planet::update(const Camera& camera, const World* world_context) {
         );
         glm::vec3 chunkWorldCenter = position_ + chunkCenterOffset;
         float distanceToCamera = glm::length(chunkWorldCenter - camPos);
+        bool prefetched = prefetching && glm::length(chunkWorldCenter - predictedPos) <= prefetchKeepDistance;
         
-        if (distanceToCamera > cleanupDistance) {
-            std::cout << "🗑️ Removing distant chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z 
-                      << " (distance: " << distanceToCamera << ")" << std::endl;
+        if (distanceToCamera > cleanupDistance && !prefetched) {
+            AZV_LOG_DEBUG(Streaming) << "🗑️ Parking distant chunk at " << chunkKey.x << "," << chunkKey.y << "," << chunkKey.z 
+                                     << " (distance: " << distanceToCamera << ")";
+            residencyCache_.park(chunkKey, it->second);
             it = chunks_.erase(it);
         } else {
             ++it;
@@ -224,7 +321,323 @@ void Planet::update(const Camera& camera, const World* world_context) {
     }
 }
 
+ChunkNeighbors Planet::gatherNeighbors(const glm::ivec3& chunkKey) const {
+    ChunkNeighbors neighbors;
+    for (int face = 0; face < 6; ++face) {
+        auto it = chunks_.find(chunkKey + FACE_NEIGHBOR_OFFSETS[face]);
+        if (it != chunks_.end() && it->second && it->second->getState() >= ChunkState::DATA_READY) {
+            neighbors.faces[face] = it->second->getVoxelSnapshot();
+            neighbors.light[face] = it->second->getLightSnapshot();
+        }
+    }
+    return neighbors;
+}
+
+bool Planet::setBlockAtWorldPos(const glm::vec3& worldPos, uint16_t blockType) {
+    float chunkSize = static_cast<float>(CHUNK_SIZE_X);
+    glm::ivec3 chunkKey = worldToPlanetChunkKey(worldPos, position_, chunkSize);
+    auto it = chunks_.find(chunkKey);
+    if (it == chunks_.end() || !it->second) {
+        return false;
+    }
+    Chunk& chunk = *it->second;
+    glm::vec3 chunkMinCornerWorldPos = chunk.getPosition();
+    glm::ivec3 local(
+        static_cast<int>(std::floor(worldPos.x - chunkMinCornerWorldPos.x)),
+        static_cast<int>(std::floor(worldPos.y - chunkMinCornerWorldPos.y)),
+        static_cast<int>(std::floor(worldPos.z - chunkMinCornerWorldPos.z))
+    );
+    if (!chunk.setBlockTypeAtLocal(local.x, local.y, local.z, blockType)) {
+        return false;
+    }
+    editedChunkKeys_.insert(chunkKey);
+    LightSeed seed;
+    seed.chunk = chunkKey;
+    seed.index = static_cast<uint16_t>(VoxelData::index(local.x, local.y, local.z));
+    pendingLightSeeds_.push_back(seed);
+
+    // A block on the chunk border also decides whether the facing border faces of the
+    // neighbouring chunk are culled, and with ambient occlusion shades the corners of the blocks
+    // around that facing block
+    const bool ambientOcclusion = Chunk::getAmbientOcclusion();
+    for (const glm::ivec3& offset : FACE_NEIGHBOR_OFFSETS) {
+        glm::ivec3 adjacent = local + offset;
+        if (adjacent.x >= 0 && adjacent.x < CHUNK_SIZE_X && adjacent.y >= 0 && adjacent.y < CHUNK_SIZE_Y &&
+            adjacent.z >= 0 && adjacent.z < CHUNK_SIZE_Z) {
+            continue;
+        }
+        glm::ivec3 neighborKey = chunkKey + offset;
+        auto neighborIt = chunks_.find(neighborKey);
+        if (neighborIt == chunks_.end() || !neighborIt->second) {
+            continue;
+        }
+        const glm::ivec3 facing((adjacent.x + CHUNK_SIZE_X) % CHUNK_SIZE_X, (adjacent.y + CHUNK_SIZE_Y) % CHUNK_SIZE_Y,
+                                (adjacent.z + CHUNK_SIZE_Z) % CHUNK_SIZE_Z);
+        const int reach = ambientOcclusion ? 1 : 0;
+        const int axis = offset.x != 0 ? 0 : (offset.y != 0 ? 1 : 2);
+        for (int da = -reach; da <= reach; ++da) {
+            for (int db = -reach; db <= reach; ++db) {
+                glm::ivec3 block = facing;
+                block[(axis + 1) % 3] += da;
+                block[(axis + 2) % 3] += db;
+                neighborIt->second->markDirtyAt(block.x, block.y, block.z); // Ignores blocks past the chunk
+            }
+        }
+        editedChunkKeys_.insert(neighborKey);
+    }
+    return true;
+}
+
+void Planet::recordBulkEdit(const glm::ivec3& chunkKey, BulkEdit& edit) {
+    const BlockRegistry& registry = BlockRegistry::getInstance();
+    edit.changed += edit.changes.size();
+    editedChunkKeys_.insert(chunkKey);
+
+    glm::ivec3 changedMin(CHUNK_SIZE_X);
+    glm::ivec3 changedMax(-1);
+    for (const BlockChange& change : edit.changes) {
+        const glm::ivec3 local(change.index / (CHUNK_SIZE_Y * CHUNK_SIZE_Z), change.index / CHUNK_SIZE_Z % CHUNK_SIZE_Y,
+                               change.index % CHUNK_SIZE_Z);
+        changedMin = glm::min(changedMin, local);
+        changedMax = glm::max(changedMax, local);
+        // Swapping stone for dirt leaves the light as it is
+        if (registry.isBlockOpaque(change.oldType) != registry.isBlockOpaque(change.newType) ||
+            registry.getBlockLightLevel(change.oldType) != registry.getBlockLightLevel(change.newType)) {
+            LightSeed seed;
+            seed.chunk = chunkKey;
+            seed.index = change.index;
+            pendingLightSeeds_.push_back(seed);
+        }
+    }
+    const glm::ivec3 chunkMin = chunkKey * glm::ivec3(CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z);
+    edit.changedChunks.push_back({chunkKey, {chunkMin + changedMin, chunkMin + changedMax}});
+}
+
+size_t Planet::finishBulkEdit(const BulkEdit& edit) {
+    AZV_PROFILE_ZONE("Planet::finishBulkEdit");
+    const glm::ivec3 chunkSize(CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z);
+    // Border faces and ambient occlusion of a face neighbour change within one block of an
+    // edit, as in setBlockAtWorldPos; each neighbour is marked for the union of those blocks
+    for (const auto& [chunkKey, bounds] : edit.changedChunks) {
+        for (const glm::ivec3& offset : FACE_NEIGHBOR_OFFSETS) {
+            const glm::ivec3 neighborKey = chunkKey + offset;
+            auto neighborIt = chunks_.find(neighborKey);
+            if (neighborIt == chunks_.end() || !neighborIt->second) {
+                continue;
+            }
+            const glm::ivec3 neighborMin = neighborKey * chunkSize;
+            const glm::ivec3 lo = glm::max(bounds.first - 1, neighborMin);
+            const glm::ivec3 hi = glm::min(bounds.second + 1, neighborMin + chunkSize - 1);
+            if (hi.x < lo.x || hi.y < lo.y || hi.z < lo.z) {
+                continue;
+            }
+            neighborIt->second->markDirtyInBox(lo - neighborMin, hi - neighborMin);
+            editedChunkKeys_.insert(neighborKey);
+        }
+    }
+    if (edit.changed > 0) {
+        AZV_LOG_DEBUG(World) << "Bulk edit on " << name_ << ": " << edit.changed << " blocks in " << edit.changedChunks.size() << " chunks";
+    }
+    return edit.changed;
+}
+
+// Mark the sections of a chunk that lie against one of its faces (FACE_NEIGHBOR_OFFSETS order)
+static void markFaceSectionsDirty(Chunk& chunk, int face) {
+    const glm::ivec3& offset = FACE_NEIGHBOR_OFFSETS[face];
+    const int axis = offset.x != 0 ? 0 : (offset.y != 0 ? 1 : 2);
+    for (int a = 0; a < CHUNK_SIZE_X; a += CHUNK_SECTION_SIZE) {
+        for (int b = 0; b < CHUNK_SIZE_X; b += CHUNK_SECTION_SIZE) {
+            glm::ivec3 local;
+            local[axis] = offset[axis] < 0 ? 0 : CHUNK_SIZE_X - 1; // Cubic chunks
+            local[(axis + 1) % 3] = a;
+            local[(axis + 2) % 3] = b;
+            chunk.markDirtyAt(local.x, local.y, local.z);
+        }
+    }
+}
+
+size_t Planet::markChunksUsingBlocks(const std::vector<bool>& changedTypes, const std::vector<bool>& cullingTypes,
+                                     const std::vector<bool>& lightTypes) {
+    AZV_PROFILE_ZONE("Planet::markChunksUsingBlocks");
+    std::unordered_map<glm::ivec3, std::shared_ptr<Chunk>, IVec3Hash> resident = chunks_;
+    residencyCache_.forEach([&](const glm::ivec3& key, const std::shared_ptr<Chunk>& chunk) { resident.emplace(key, chunk); });
+
+    auto usesAny = [](const VoxelData& voxels, const std::vector<bool>& types) {
+        for (uint16_t type : voxels.palette()) {
+            if (type < types.size() && types[type]) return true;
+        }
+        return false;
+    };
+    // Chunks without a mesh pick up the new definitions when they are meshed
+    auto hasMesh = [](const Chunk& chunk) {
+        ChunkState state = chunk.getState();
+        return state == ChunkState::MESH_READY || state == ChunkState::FULLY_INITIALIZED;
+    };
+    std::unordered_set<glm::ivec3, IVec3Hash> marked;
+    // Active chunks are rebuilt by rebuildEditedChunks; parked ones are re-queued when restored
+    auto queue = [&](const glm::ivec3& key) {
+        marked.insert(key);
+        if (chunks_.count(key) != 0) {
+            editedChunkKeys_.insert(key);
+        }
+    };
+
+    for (const auto& [key, chunk] : resident) {
+        VoxelSnapshot voxels = chunk ? chunk->getVoxelSnapshot() : nullptr;
+        if (!voxels) {
+            continue;
+        }
+        // Chunks without light are lit with the new definitions when they are meshed
+        if (chunk->getLightSnapshot() && usesAny(*voxels, lightTypes)) {
+            std::vector<LightSeed>& seeds = chunks_.count(key) != 0 ? pendingLightSeeds_ : parkedLightSeeds_[key];
+            for (size_t i = 0; i < VoxelData::VOLUME; ++i) {
+                const uint16_t type = static_cast<uint16_t>(voxels->atIndex(i).type);
+                if (type < lightTypes.size() && lightTypes[type]) {
+                    LightSeed seed;
+                    seed.chunk = key;
+                    seed.index = static_cast<uint16_t>(i);
+                    seeds.push_back(seed);
+                }
+            }
+            marked.insert(key);
+        }
+        if (!hasMesh(*chunk) || !usesAny(*voxels, changedTypes)) {
+            continue;
+        }
+        chunk->markAllSectionsDirty();
+        queue(key);
+        if (!usesAny(*voxels, cullingTypes)) {
+            continue;
+        }
+        for (int face = 0; face < 6; ++face) {
+            auto neighborIt = resident.find(key + FACE_NEIGHBOR_OFFSETS[face]);
+            if (neighborIt != resident.end() && neighborIt->second && hasMesh(*neighborIt->second)) {
+                markFaceSectionsDirty(*neighborIt->second, face ^ 1); // The neighbour's face toward this chunk
+                queue(neighborIt->first);
+            }
+        }
+    }
+    return marked.size();
+}
+
+void Planet::rebuildEditedChunks() {
+    if (editedChunkKeys_.empty()) {
+        return;
+    }
+    AZV_PROFILE_ZONE("Planet::rebuildEditedChunks");
+    for (auto it = editedChunkKeys_.begin(); it != editedChunkKeys_.end(); ) {
+        auto chunkIt = chunks_.find(*it);
+        // A parked chunk keeps its dirty sections and is re-queued when it is restored
+        if (chunkIt == chunks_.end() || !chunkIt->second ||
+            chunkIt->second->rebuildDirtySections(gatherNeighbors(*it))) {
+            it = editedChunkKeys_.erase(it);
+        } else {
+            ++it; // Mesh not built yet (e.g. a worker is meshing it); try again next frame
+        }
+    }
+}
+
+bool Planet::bordersLightRegion(const glm::ivec3& chunkKey) const {
+    if (!lightBatchInFlight_) {
+        return false;
+    }
+    for (const glm::ivec3& offset : FACE_NEIGHBOR_OFFSETS) {
+        if (lightRegionKeys_.count(chunkKey + offset)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Planet::dispatchLightUpdates(const World* world_context) {
+    if (lightBatchInFlight_ || pendingLightSeeds_.empty() || !world_context) {
+        return false;
+    }
+    AZV_PROFILE_ZONE("Planet::dispatchLightUpdates");
+
+    // The region is every lit chunk within one chunk of a seed: light from a voxel reaches at
+    // most 15 blocks, so an edit's removal and refill never need more. Light going further (sky
+    // light falling down a shaft) spills and continues in the next batch.
+    std::vector<LightSeed> seeds;
+    seeds.swap(pendingLightSeeds_);
+    std::vector<LightRegionChunk> region;
+    std::unordered_set<glm::ivec3, IVec3Hash> seedChunks;
+    for (const LightSeed& seed : seeds) {
+        seedChunks.insert(seed.chunk);
+    }
+    for (const glm::ivec3& seedChunk : seedChunks) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    glm::ivec3 key = seedChunk + glm::ivec3(dx, dy, dz);
+                    if (lightRegionKeys_.count(key)) {
+                        continue;
+                    }
+                    auto it = chunks_.find(key);
+                    if (it == chunks_.end() || !it->second) {
+                        continue;
+                    }
+                    LightRegionChunk member;
+                    member.key = key;
+                    member.voxels = it->second->getVoxelSnapshot();
+                    member.light = it->second->getLightSnapshot();
+                    if (!member.voxels || !member.light) {
+                        continue; // Not lit yet: its first lighting reads the current neighbours
+                    }
+                    member.sky = skyContextForChunk(it->second->getPosition(), position_, radius_);
+                    lightRegionKeys_.insert(key);
+                    region.push_back(std::move(member));
+                }
+            }
+        }
+    }
+    if (region.empty()) {
+        return false;
+    }
+
+    AZV_LOG_TRACE(Streaming) << "Light batch: " << seeds.size() << " seeds over " << region.size() << " chunks";
+    lightBatchInFlight_ = true;
+    World* world = const_cast<World*>(world_context);
+    world->addMeshBuildingTask([this, world, region = std::move(region), seeds = std::move(seeds)]() mutable {
+        LightBatchResult result = LightEngine::propagate(region, seeds);
+        // The chunks are published on the main thread: one may have been parked or compressed
+        // while the batch ran, and its result must not land on whatever it holds now
+        world->addMainThreadTask([this, region = std::move(region), seeds = std::move(seeds),
+                                  result = std::move(result)]() {
+            std::unordered_set<glm::ivec3, IVec3Hash> parkedKeys;
+            for (const LightUpdate& update : result.updates) {
+                auto it = chunks_.find(update.key);
+                if (it == chunks_.end() || !it->second) {
+                    parkedKeys.insert(update.key);
+                    continue;
+                }
+                auto member = std::find_if(region.begin(), region.end(),
+                                           [&](const LightRegionChunk& m) { return m.key == update.key; });
+                // A chunk relit from scratch since the batch read it keeps its new light
+                if (update.light && member != region.end() && it->second->getLightSnapshot() == member->light) {
+                    it->second->publishLight(update.light);
+                }
+                if (update.dirtySections != 0) {
+                    it->second->markSectionsDirty(update.dirtySections);
+                    editedChunkKeys_.insert(update.key);
+                }
+            }
+            // A chunk parked during the batch relights its own seeds when it is restored
+            for (const LightSeed& seed : seeds) {
+                if (parkedKeys.count(seed.chunk)) {
+                    parkedLightSeeds_[seed.chunk].push_back(seed);
+                }
+            }
+            pendingLightSeeds_.insert(pendingLightSeeds_.end(), result.spills.begin(), result.spills.end());
+            lightRegionKeys_.clear();
+            lightBatchInFlight_ = false;
+        });
+    });
+    return true;
+}
+
 void Planet::render(const glm::mat4& projection, const glm::mat4& view, bool wireframeState) const {
+    AZV_PROFILE_ZONE("Planet::render");
     int chunksRendered = 0;
     int chunksSkipped = 0;
     float chunkSizeF = static_cast<float>(CHUNK_SIZE_X);
@@ -275,9 +688,88 @@ void Planet::render(const glm::mat4& projection, const glm::mat4& view, bool wir
     // Only log rendering info occasionally to avoid spam
     static int renderLogCounter = 0;
     if ((chunksRendered > 0 || chunksSkipped > 0) && (renderLogCounter++ % 120 == 0)) { // Log every 120 frames (2 seconds at 60fps)
-        std::cout << "🎮 Planet " << name_ << " rendered " << chunksRendered 
-                  << " chunks, skipped " << chunksSkipped << " chunks" << std::endl;
+        AZV_LOG_DEBUG(Streaming) << "🎮 Planet " << name_ << " rendered " << chunksRendered 
+                                 << " chunks, skipped " << chunksSkipped << " chunks";
+    }
+}
+
+VoxelSnapshot Planet::voxelsAt(const glm::ivec3& chunkKey) const {
+    auto it = chunks_.find(chunkKey);
+    return it != chunks_.end() && it->second ? it->second->getVoxelSnapshot() : VoxelSnapshot();
+}
+
+VoxelCollider Planet::makeCollider(bool unloadedIsSolid) const {
+    return VoxelCollider(position_, [this](const glm::ivec3& chunkKey) { return voxelsAt(chunkKey); }, unloadedIsSolid);
+}
+
+size_t Planet::queryBlocks(const glm::ivec3& minBlock, const glm::ivec3& maxBlock, uint16_t* out, uint16_t unloadedFill) const {
+    const glm::ivec3 size = maxBlock - minBlock + 1;
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0) {
+        return 0;
+    }
+    const glm::ivec3 minKey(chunkCoordinateOf(minBlock.x), chunkCoordinateOf(minBlock.y), chunkCoordinateOf(minBlock.z));
+    const glm::ivec3 maxKey(chunkCoordinateOf(maxBlock.x), chunkCoordinateOf(maxBlock.y), chunkCoordinateOf(maxBlock.z));
+
+    size_t unloaded = 0;
+    for (int kx = minKey.x; kx <= maxKey.x; ++kx) {
+        for (int ky = minKey.y; ky <= maxKey.y; ++ky) {
+            for (int kz = minKey.z; kz <= maxKey.z; ++kz) {
+                const glm::ivec3 chunkKey(kx, ky, kz);
+                const glm::ivec3 chunkOrigin = chunkKey * CHUNK_SIZE_X;
+                const glm::ivec3 lo = glm::max(minBlock, chunkOrigin);
+                const glm::ivec3 hi = glm::min(maxBlock, chunkOrigin + (CHUNK_SIZE_X - 1));
+                const VoxelSnapshot voxels = voxelsAt(chunkKey);
+
+                // Rows along z are contiguous in both the voxel version and the output
+                const int run = hi.z - lo.z + 1;
+                for (int x = lo.x; x <= hi.x; ++x) {
+                    for (int y = lo.y; y <= hi.y; ++y) {
+                        uint16_t* row = out + (static_cast<size_t>(x - minBlock.x) * size.y + (y - minBlock.y)) * size.z + (lo.z - minBlock.z);
+                        if (!voxels) {
+                            std::fill_n(row, run, unloadedFill);
+                            unloaded += static_cast<size_t>(run);
+                            continue;
+                        }
+                        const BlockInfo* source = &voxels->at(x - chunkOrigin.x, y - chunkOrigin.y, lo.z - chunkOrigin.z);
+                        for (int z = 0; z < run; ++z) {
+                            row[z] = static_cast<uint16_t>(source[z].type);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return unloaded;
+}
+
+RaycastHit Planet::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RaycastFilter filter) const {
+    // Chunks only exist within the planet's bounds (the same margin as World::getBlockAtWorldPos),
+    // so the walk ends where the ray leaves them; this also bounds an infinite maxDistance
+    const float length = glm::length(direction);
+    if (!(length > 0.0f)) {
+        return RaycastHit();
+    }
+    const glm::vec3 dir = direction / length;
+    const glm::vec3 toCenter = position_ - origin;
+    const float along = glm::dot(toCenter, dir);
+    const float closestSquared = glm::dot(toCenter, toCenter) - along * along;
+    const float boundsRadius = radius_ + CHUNK_SIZE_X * 1.732f;
+    if (closestSquared > boundsRadius * boundsRadius) {
+        return RaycastHit();
+    }
+    const float exitDistance = along + std::sqrt(std::max(0.0f, boundsRadius * boundsRadius - closestSquared));
+    if (exitDistance < 0.0f) {
+        return RaycastHit();
+    }
+    maxDistance = std::min(maxDistance, exitDistance);
+
+    RaycastHit hit = VoxelRaycaster::cast(position_, origin, direction, maxDistance, filter,
+                                          [this](const glm::ivec3& chunkKey) { return voxelsAt(chunkKey); });
+    if (hit.hit) {
+        hit.blockCenter = position_ + glm::vec3(hit.block) + glm::vec3(0.5f);
+        hit.planet = this;
     }
+    return hit;
 }
 
 std::shared_ptr<Block> Planet::getBlockAtWorldPos(const glm::vec3& worldPos) const {
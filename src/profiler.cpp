@@ -0,0 +1,165 @@
+#include "../headers/profiler.h"
+#include "../headers/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct ZoneEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t endNs;
+};
+
+// One per thread that ever recorded a zone. The owning thread is the only writer; the
+// mutex is uncontended except while a trace is being written or cleared.
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::string name;
+    uint32_t threadId = 0;
+    std::vector<ZoneEvent> events; // Ring buffer, allocated on first zone
+    uint64_t written = 0;          // Total zones ever written; index = written % capacity
+};
+
+struct ProfilerState {
+    std::atomic<bool> enabled{false};
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers; // Kept alive after their thread exits
+    uint32_t nextThreadId = 1;
+};
+
+ProfilerState& state() {
+    static ProfilerState instance;
+    return instance;
+}
+
+ThreadBuffer& localBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        ProfilerState& s = state();
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        buffer->threadId = s.nextThreadId++;
+        buffer->name = "Thread " + std::to_string(buffer->threadId);
+        s.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void writeEscaped(std::ostream& out, const std::string& text) {
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+}
+
+} // namespace
+
+void Profiler::setEnabled(bool enabled) {
+    if (enabled && !isEnabled()) {
+        clear();
+    }
+    state().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+int64_t Profiler::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - state().epoch).count();
+}
+
+void Profiler::recordZone(const char* name, int64_t startNs, int64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.empty()) {
+        buffer.events.resize(EVENTS_PER_THREAD);
+    }
+    buffer.events[buffer.written % EVENTS_PER_THREAD] = ZoneEvent{name, startNs, endNs};
+    ++buffer.written;
+}
+
+void Profiler::clear() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> registryLock(s.registryMutex);
+    for (auto& buffer : s.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->written = 0;
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    struct ThreadSnapshot {
+        std::string name;
+        uint32_t threadId;
+        std::vector<ZoneEvent> events;
+    };
+
+    // Copy everything out first so recording threads are blocked only briefly
+    std::vector<ThreadSnapshot> snapshots;
+    {
+        ProfilerState& s = state();
+        std::lock_guard<std::mutex> registryLock(s.registryMutex);
+        snapshots.reserve(s.buffers.size());
+        for (auto& buffer : s.buffers) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            ThreadSnapshot snapshot{buffer->name, buffer->threadId, {}};
+            uint64_t count = std::min<uint64_t>(buffer->written, EVENTS_PER_THREAD);
+            uint64_t first = buffer->written - count;
+            snapshot.events.reserve(count);
+            for (uint64_t i = first; i < buffer->written; ++i) {
+                snapshot.events.push_back(buffer->events[i % EVENTS_PER_THREAD]);
+            }
+            snapshots.push_back(std::move(snapshot));
+        }
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        AZV_LOG_ERROR(General) << "Error: Could not open profiler trace file for writing: " << path;
+        return false;
+    }
+
+    size_t zoneCount = 0;
+    bool firstEntry = true;
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const auto& snapshot : snapshots) {
+        file << (firstEntry ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << snapshot.threadId
+             << ",\"args\":{\"name\":\"";
+        writeEscaped(file, snapshot.name);
+        file << "\"}}";
+        firstEntry = false;
+
+        for (const auto& event : snapshot.events) {
+            file << ",\n{\"name\":\"";
+            writeEscaped(file, event.name);
+            file << "\",\"cat\":\"azurevoxel\",\"ph\":\"X\",\"pid\":1,\"tid\":" << snapshot.threadId
+                 << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+                 << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0 << "}";
+            ++zoneCount;
+        }
+    }
+    file << "\n]}\n";
+
+    AZV_LOG_INFO(General) << "Profiler: wrote " << zoneCount << " zones from " << snapshots.size()
+                          << " threads to " << path;
+    return true;
+}
@@ -0,0 +1,36 @@
+#include "../headers/render_backend.h"
+#include "../headers/chunk.h"
+
+namespace {
+
+std::unique_ptr<RenderBackend>& backendSlot() {
+    static std::unique_ptr<RenderBackend> backend = std::make_unique<NullRenderBackend>();
+    return backend;
+}
+
+} // namespace
+
+RenderBackend& RenderBackend::getInstance() {
+    return *backendSlot();
+}
+
+void RenderBackend::setInstance(std::unique_ptr<RenderBackend> backend) {
+    backendSlot() = backend ? std::move(backend) : std::make_unique<NullRenderBackend>();
+}
+
+bool RenderBackend::updateChunkMesh(ChunkMesh& mesh, const std::vector<float>& vertices,
+                                    const std::vector<unsigned int>& indices) {
+    releaseChunkMesh(mesh);
+    return uploadChunkMesh(mesh, vertices, indices);
+}
+
+bool NullRenderBackend::uploadChunkMesh(ChunkMesh& mesh, const std::vector<float>& /*vertices*/,
+                                        const std::vector<unsigned int>& indices) {
+    // No GPU objects; keep the index count so callers see the mesh as uploaded
+    mesh.indexCount = static_cast<int>(indices.size());
+    return true;
+}
+
+void NullRenderBackend::releaseChunkMesh(ChunkMesh& mesh) {
+    mesh = ChunkMesh();
+}
@@ -0,0 +1,123 @@
+#include "../headers/replay_report.h"
+#include "../headers/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+double ReplayReport::frameTimePercentileMs(double p) const {
+    if (frames_.empty()) {
+        return 0.0;
+    }
+    std::vector<double> times;
+    times.reserve(frames_.size());
+    for (const Frame& frame : frames_) {
+        times.push_back(frame.frameMs);
+    }
+    std::sort(times.begin(), times.end());
+    p = std::clamp(p, 0.0, 1.0);
+    size_t index = static_cast<size_t>(std::ceil(p * static_cast<double>(times.size())));
+    return times[index == 0 ? 0 : index - 1];
+}
+
+double ReplayReport::meanFrameMs() const {
+    if (frames_.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (const Frame& frame : frames_) {
+        sum += frame.frameMs;
+    }
+    return sum / static_cast<double>(frames_.size());
+}
+
+std::vector<size_t> ReplayReport::timelineFrames() const {
+    std::vector<size_t> indices;
+    double nextSecond = 0.0;
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        if (frames_[i].simTime >= nextSecond) {
+            indices.push_back(i);
+            nextSecond = std::floor(frames_[i].simTime) + 1.0;
+        }
+    }
+    return indices;
+}
+
+void ReplayReport::printReport(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    size_t peakBacklog = 0;
+    for (const Frame& frame : frames_) {
+        peakBacklog = std::max(peakBacklog, frame.backlog.total());
+    }
+    double simSeconds = frames_.empty() ? 0.0 : frames_.back().simTime;
+    uint64_t streamed = frames_.empty() ? 0 : frames_.back().chunksStreamed;
+
+    out << std::fixed << std::setprecision(2);
+    out << "=== CAMERA PATH REPLAY (" << frames_.size() << " frames, " << simSeconds << " s simulated) ===\n";
+    out << "Frame time ms: mean " << meanFrameMs()
+        << "  p50 " << frameTimePercentileMs(0.50)
+        << "  p90 " << frameTimePercentileMs(0.90)
+        << "  p99 " << frameTimePercentileMs(0.99)
+        << "  max " << frameTimePercentileMs(1.0) << "\n";
+    out << "Chunks streamed: " << streamed << "  peak backlog: " << peakBacklog << "\n";
+    out << std::setw(8) << "t(s)" << std::setw(10) << "streamed" << std::setw(8) << "gen"
+        << std::setw(8) << "mesh" << std::setw(8) << "main" << "\n";
+    for (size_t i : timelineFrames()) {
+        const Frame& frame = frames_[i];
+        out << std::setw(8) << std::setprecision(1) << frame.simTime
+            << std::setw(10) << frame.chunksStreamed
+            << std::setw(8) << frame.backlog.generationQueued
+            << std::setw(8) << frame.backlog.meshQueued
+            << std::setw(8) << frame.backlog.mainThreadQueued << "\n";
+    }
+
+    out.copyfmt(oldState);
+}
+
+void ReplayReport::writeJSON(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    size_t peakBacklog = 0;
+    for (const Frame& frame : frames_) {
+        peakBacklog = std::max(peakBacklog, frame.backlog.total());
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"frames\": " << frames_.size()
+        << ",\n  \"sim_seconds\": " << (frames_.empty() ? 0.0 : frames_.back().simTime)
+        << ",\n  \"frame_ms\": {\"mean\": " << meanFrameMs()
+        << ", \"p50\": " << frameTimePercentileMs(0.50)
+        << ", \"p90\": " << frameTimePercentileMs(0.90)
+        << ", \"p99\": " << frameTimePercentileMs(0.99)
+        << ", \"max\": " << frameTimePercentileMs(1.0) << "}"
+        << ",\n  \"chunks_streamed\": " << (frames_.empty() ? 0 : frames_.back().chunksStreamed)
+        << ",\n  \"peak_backlog\": " << peakBacklog
+        << ",\n  \"timeline\": [\n";
+    std::vector<size_t> timeline = timelineFrames();
+    for (size_t n = 0; n < timeline.size(); ++n) {
+        const Frame& frame = frames_[timeline[n]];
+        out << "    {\"t\": " << frame.simTime
+            << ", \"chunks_streamed\": " << frame.chunksStreamed
+            << ", \"generation_queued\": " << frame.backlog.generationQueued
+            << ", \"mesh_queued\": " << frame.backlog.meshQueued
+            << ", \"main_thread_queued\": " << frame.backlog.mainThreadQueued << "}"
+            << (n + 1 < timeline.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+
+    out.copyfmt(oldState);
+}
+
+bool ReplayReport::writeJSONFile(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        AZV_LOG_ERROR(General) << "Error: Could not open replay report file for writing: " << path;
+        return false;
+    }
+    writeJSON(file);
+    AZV_LOG_INFO(General) << "Replay report written to " << path;
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "../headers/shader.h"
+#include "../headers/logger.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -31,7 +32,7 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
         vertexCode = vShaderStream.str();
         fragmentCode = fShaderStream.str();
     } catch(std::ifstream::failure& e) {
-        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what();
     }
     
     const char* vShaderCode = vertexCode.c_str();
@@ -100,15 +101,15 @@ void Shader::checkCompileErrors(unsigned int shader, std::string type) {
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
         if (!success) {
             glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-            std::cerr << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog 
-                      << "\n -- --------------------------------------------------- -- " << std::endl;
+            AZV_LOG_ERROR(Render) << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog 
+                                  << "\n -- --------------------------------------------------- -- ";
         }
     } else {
         glGetProgramiv(shader, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-            std::cerr << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog 
-                      << "\n -- --------------------------------------------------- -- " << std::endl;
+            AZV_LOG_ERROR(Render) << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog 
+                                  << "\n -- --------------------------------------------------- -- ";
         }
     }
 } 
\ No newline at end of file
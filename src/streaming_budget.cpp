@@ -0,0 +1,82 @@
+#include "../headers/streaming_budget.h"
+#include "../headers/logger.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+// ~10-frame smoothing window, so a single slow frame (a save, a driver hitch) does not trigger a change
+constexpr double FRAME_TIME_SMOOTHING = 0.1;
+
+} // namespace
+
+StreamingBudgetController::StreamingBudgetController() {
+    setSettings(StreamingBudgetSettings());
+}
+
+void StreamingBudgetController::setSettings(const StreamingBudgetSettings& settings) {
+    settings_ = settings;
+    settings_.minRenderDistance = std::max(1, settings_.minRenderDistance);
+    settings_.maxRenderDistance = std::max(settings_.minRenderDistance, settings_.maxRenderDistance);
+    settings_.minChunksPerFrame = std::max(1, settings_.minChunksPerFrame);
+    settings_.maxChunksPerFrame = std::max(settings_.minChunksPerFrame, settings_.maxChunksPerFrame);
+    renderDistance_ = std::clamp(settings_.initialRenderDistance, settings_.minRenderDistance, settings_.maxRenderDistance);
+    chunksPerFrame_ = std::clamp(settings_.initialChunksPerFrame, settings_.minChunksPerFrame, settings_.maxChunksPerFrame);
+    hasSample_ = false;
+    framesSinceAdjust_ = 0;
+}
+
+void StreamingBudgetController::recordFrame(double frameMs, const PipelineBacklog& backlog) {
+    if (!hasSample_) {
+        smoothedFrameMs_ = frameMs;
+        hasSample_ = true;
+    } else {
+        smoothedFrameMs_ += (frameMs - smoothedFrameMs_) * FRAME_TIME_SMOOTHING;
+    }
+    if (!settings_.enabled || ++framesSinceAdjust_ < settings_.adjustIntervalFrames) {
+        return;
+    }
+    adjust(backlog.total());
+}
+
+void StreamingBudgetController::adjust(size_t backlog) {
+    int oldDistance = renderDistance_;
+    int oldChunksPerFrame = chunksPerFrame_;
+
+    if (smoothedFrameMs_ > settings_.targetFrameMs * settings_.shrinkAboveFraction) {
+        if (chunksPerFrame_ > settings_.minChunksPerFrame) {
+            chunksPerFrame_ = std::max(settings_.minChunksPerFrame, chunksPerFrame_ / 2);
+        } else {
+            renderDistance_ = std::max(settings_.minRenderDistance, renderDistance_ - 1);
+        }
+    } else if (backlog > settings_.backlogHighWater) {
+        // Workers cannot keep up; admitting more only lengthens the queues
+        chunksPerFrame_ = std::max(settings_.minChunksPerFrame, chunksPerFrame_ - 1);
+    } else if (smoothedFrameMs_ < settings_.targetFrameMs * settings_.growBelowFraction) {
+        chunksPerFrame_ = std::min(settings_.maxChunksPerFrame, chunksPerFrame_ + 1);
+        if (backlog <= settings_.backlogHighWater / 4) {
+            renderDistance_ = std::min(settings_.maxRenderDistance, renderDistance_ + 1);
+        }
+    }
+    framesSinceAdjust_ = 0;
+
+    if (renderDistance_ != oldDistance || chunksPerFrame_ != oldChunksPerFrame) {
+        ++adjustments_;
+        AZV_LOG_DEBUG(Streaming) << "Streaming budget: render distance " << oldDistance << " -> " << renderDistance_
+                                 << ", chunks/frame " << oldChunksPerFrame << " -> " << chunksPerFrame_
+                                 << " (frame " << smoothedFrameMs_ << " ms, target " << settings_.targetFrameMs
+                                 << " ms, backlog " << backlog << ")";
+    }
+}
+
+void StreamingBudgetController::printStatus(std::ostream& out) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(out);
+
+    out << std::fixed << std::setprecision(2)
+        << "render distance " << renderDistance_ << ", chunks/frame " << chunksPerFrame_
+        << ", frame " << smoothedFrameMs_ << " / " << settings_.targetFrameMs << " ms"
+        << (settings_.enabled ? "" : " (fixed)") << ", " << adjustments_ << " adjustments";
+
+    out.copyfmt(oldState);
+}
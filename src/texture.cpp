@@ -1,11 +1,11 @@
 #include "../headers/texture.h"
+#include "../headers/logger.h"
 #include <iostream>
 #include <filesystem> // For std::filesystem::absolute -- DEBUGGING
 #include <thread>
 #include <GLFW/glfw3.h> // For glfwGetCurrentContext
 
-// Include stb_image.h for texture loading
-#define STB_IMAGE_IMPLEMENTATION
+// stb_image.h for texture loading (implemented once, in the core library's texture_atlas.cpp)
 #include "../external/stb_image.h"
 
 Texture::Texture() : textureID(0), width(0), height(0), channels(0), isShared(false) {
@@ -45,7 +45,7 @@ Texture& Texture::operator=(const Texture& other) {
 bool Texture::loadFromFile(const std::string& filepath) {
     // Check if OpenGL context is current
     if (glfwGetCurrentContext() == nullptr) {
-        std::cerr << "ERROR::TEXTURE::NO_CONTEXT: No OpenGL context is current during texture loading!" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::NO_CONTEXT: No OpenGL context is current during texture loading!";
         return false;
     }
     
@@ -58,26 +58,26 @@ bool Texture::loadFromFile(const std::string& filepath) {
     // Load image using stb_image
     stbi_set_flip_vertically_on_load(true); // Flip the image vertically (OpenGL expects bottom-left origin)
     
-    std::cout << "Attempting to load texture from (absolute path): " << std::filesystem::absolute(filepath) << std::endl; // DEBUGGING
+    AZV_LOG_DEBUG(Render) << "Attempting to load texture from (absolute path): " << std::filesystem::absolute(filepath); // DEBUGGING
     
     // Check if file exists before loading
     if (!std::filesystem::exists(filepath)) {
-        std::cerr << "ERROR::TEXTURE::FILE_NOT_FOUND: " << filepath << std::endl;
-        std::cerr << "Working directory: " << std::filesystem::current_path() << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::FILE_NOT_FOUND: " << filepath;
+        AZV_LOG_ERROR(Render) << "Working directory: " << std::filesystem::current_path();
         return false;
     }
 
     unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
     
     if (!data) {
-        std::cerr << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
-        std::cerr << "ERROR::TEXTURE::LOAD_FAILED: Could not load texture file: " << filepath << std::endl;
-        std::cerr << "STB_IMAGE Error: " << stbi_failure_reason() << std::endl;
-        std::cerr << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
+        AZV_LOG_ERROR(Render) << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!";
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::LOAD_FAILED: Could not load texture file: " << filepath;
+        AZV_LOG_ERROR(Render) << "STB_IMAGE Error: " << stbi_failure_reason();
+        AZV_LOG_ERROR(Render) << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!";
         return false;
     }
     
-    std::cout << "Successfully loaded texture: " << filepath << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
+    AZV_LOG_INFO(Render) << "Successfully loaded texture: " << filepath << " (" << width << "x" << height << ", " << channels << " channels)";
     
     // Clear any previous OpenGL errors
     while (glGetError() != GL_NO_ERROR) {}
@@ -91,23 +91,23 @@ bool Texture::loadFromFile(const std::string& filepath) {
     
     GLenum error = glGetError();
     if (error != GL_NO_ERROR || newTextureID == 0) {
-        std::cerr << "ERROR::TEXTURE::CREATION_FAILED: Failed to generate texture (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::CREATION_FAILED: Failed to generate texture (error " << error << ")";
         
         // Additional debugging info
-        std::cout << "DEBUG: OpenGL context: " << glfwGetCurrentContext() << std::endl;
-        std::cout << "DEBUG: OpenGL version: " << glGetString(GL_VERSION) << std::endl;
+        AZV_LOG_DEBUG(Render) << "OpenGL context: " << glfwGetCurrentContext();
+        AZV_LOG_DEBUG(Render) << "OpenGL version: " << glGetString(GL_VERSION);
         
         // Try a second time after a short delay
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        std::cout << "Retrying texture generation..." << std::endl;
+        AZV_LOG_INFO(Render) << "Retrying texture generation...";
         glGenTextures(1, &newTextureID);
         error = glGetError();
         if (error != GL_NO_ERROR || newTextureID == 0) {
-            std::cerr << "ERROR::TEXTURE::RETRY_FAILED: Second attempt failed (error " << error << ")" << std::endl;
+            AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::RETRY_FAILED: Second attempt failed (error " << error << ")";
             stbi_image_free(data);
             return false;
         } else {
-            std::cout << "Retry successful! Texture ID: " << newTextureID << std::endl;
+            AZV_LOG_INFO(Render) << "Retry successful! Texture ID: " << newTextureID;
         }
     }
     
@@ -115,7 +115,7 @@ bool Texture::loadFromFile(const std::string& filepath) {
     
     error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cerr << "ERROR::TEXTURE::BIND_FAILED: Failed to bind texture (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::BIND_FAILED: Failed to bind texture (error " << error << ")";
         glDeleteTextures(1, &newTextureID);
         stbi_image_free(data);
         return false;
@@ -142,7 +142,7 @@ bool Texture::loadFromFile(const std::string& filepath) {
     
     error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cerr << "ERROR::TEXTURE::UPLOAD_FAILED: Failed to upload texture data (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::UPLOAD_FAILED: Failed to upload texture data (error " << error << ")";
         glDeleteTextures(1, &newTextureID);
         stbi_image_free(data);
         return false;
@@ -153,7 +153,7 @@ bool Texture::loadFromFile(const std::string& filepath) {
     
     error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cerr << "ERROR::TEXTURE::MIPMAP_FAILED: Failed to generate mipmaps (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::MIPMAP_FAILED: Failed to generate mipmaps (error " << error << ")";
         // Not fatal, continue
     }
     
@@ -166,14 +166,58 @@ bool Texture::loadFromFile(const std::string& filepath) {
     // This is not a shared texture
     isShared = false;
     
-    std::cout << "Texture created successfully with ID: " << textureID << std::endl;
+    AZV_LOG_INFO(Render) << "Texture created successfully with ID: " << textureID;
+    return true;
+}
+
+bool Texture::loadFromPixels(int pixelWidth, int pixelHeight, const unsigned char* rgba, int maxMipLevel) {
+    if (glfwGetCurrentContext() == nullptr) {
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::NO_CONTEXT: No OpenGL context is current during texture creation!";
+        return false;
+    }
+    if (textureID != 0 && !isShared) {
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+
+    while (glGetError() != GL_NO_ERROR) {} // Clear previous errors
+
+    GLuint newTextureID = 0;
+    glGenTextures(1, &newTextureID);
+    if (newTextureID == 0) {
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::CREATION_FAILED: Failed to generate texture";
+        return false;
+    }
+    glBindTexture(GL_TEXTURE_2D, newTextureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // Use nearest for Minecraft-like look
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    // Deeper levels would average across the tile padding into neighbouring tiles
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxMipLevel);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixelWidth, pixelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::UPLOAD_FAILED: Failed to upload texture data (error " << error << ")";
+        glDeleteTextures(1, &newTextureID);
+        return false;
+    }
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    textureID = newTextureID;
+    width = pixelWidth;
+    height = pixelHeight;
+    channels = 4;
+    isShared = false;
     return true;
 }
 
 bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int atlasY, int atlasWidth, int atlasHeight) {
     // Check if OpenGL context is current
     if (glfwGetCurrentContext() == nullptr) {
-        std::cerr << "ERROR::TEXTURE::NO_CONTEXT: No OpenGL context is current during spritesheet loading!" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::NO_CONTEXT: No OpenGL context is current during spritesheet loading!";
         return false;
     }
     
@@ -185,32 +229,32 @@ bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int a
     stbi_set_flip_vertically_on_load(true);
     int fullWidth, fullHeight, fullChannels;
     
-    std::cout << "Attempting to load spritesheet from (absolute path): " << std::filesystem::absolute(filepath) << std::endl; // DEBUGGING
+    AZV_LOG_DEBUG(Render) << "Attempting to load spritesheet from (absolute path): " << std::filesystem::absolute(filepath); // DEBUGGING
     
     // Check if file exists before loading
     if (!std::filesystem::exists(filepath)) {
-        std::cerr << "ERROR::TEXTURE::SPRITESHEET_FILE_NOT_FOUND: " << filepath << std::endl;
-        std::cerr << "Working directory: " << std::filesystem::current_path() << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::SPRITESHEET_FILE_NOT_FOUND: " << filepath;
+        AZV_LOG_ERROR(Render) << "Working directory: " << std::filesystem::current_path();
         return false;
     }
 
     unsigned char* fullData = stbi_load(filepath.c_str(), &fullWidth, &fullHeight, &fullChannels, 0);
 
     if (!fullData) {
-        std::cerr << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
-        std::cerr << "ERROR::TEXTURE::LOAD_FAILED: Could not load texture file: " << filepath << std::endl;
-        std::cerr << "STB_IMAGE Error: " << stbi_failure_reason() << std::endl;
-        std::cerr << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
+        AZV_LOG_ERROR(Render) << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!";
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::LOAD_FAILED: Could not load texture file: " << filepath;
+        AZV_LOG_ERROR(Render) << "STB_IMAGE Error: " << stbi_failure_reason();
+        AZV_LOG_ERROR(Render) << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!";
         return false;
     }
     
-    std::cout << "Successfully loaded spritesheet: " << filepath << " (" << fullWidth << "x" << fullHeight << ", " << fullChannels << " channels)" << std::endl;
-    std::cout << "Extracting region: x=" << atlasX << ", y=" << atlasY << ", w=" << atlasWidth << ", h=" << atlasHeight << std::endl;
+    AZV_LOG_INFO(Render) << "Successfully loaded spritesheet: " << filepath << " (" << fullWidth << "x" << fullHeight << ", " << fullChannels << " channels)";
+    AZV_LOG_INFO(Render) << "Extracting region: x=" << atlasX << ", y=" << atlasY << ", w=" << atlasWidth << ", h=" << atlasHeight;
 
     // Validate atlas coordinates and dimensions
     if (atlasX < 0 || atlasY < 0 || atlasWidth <= 0 || atlasHeight <= 0 ||
         atlasX + atlasWidth > fullWidth || atlasY + atlasHeight > fullHeight) {
-        std::cerr << "ERROR::TEXTURE::SPRITESHEET_INVALID_REGION: Invalid region specified for spritesheet." << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::SPRITESHEET_INVALID_REGION: Invalid region specified for spritesheet.";
         stbi_image_free(fullData);
         return false;
     }
@@ -242,7 +286,7 @@ bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int a
     
     GLenum error = glGetError();
     if (error != GL_NO_ERROR || newTextureID == 0) {
-        std::cerr << "ERROR::TEXTURE::CREATION_FAILED: Failed to generate texture for spritesheet (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::CREATION_FAILED: Failed to generate texture for spritesheet (error " << error << ")";
         stbi_image_free(fullData);
         delete[] subImageData;
         return false;
@@ -252,7 +296,7 @@ bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int a
     
     error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cerr << "ERROR::TEXTURE::BIND_FAILED: Failed to bind texture for spritesheet (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::BIND_FAILED: Failed to bind texture for spritesheet (error " << error << ")";
         glDeleteTextures(1, &newTextureID);
         stbi_image_free(fullData);
         delete[] subImageData;
@@ -277,7 +321,7 @@ bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int a
     
     error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cerr << "ERROR::TEXTURE::UPLOAD_FAILED: Failed to upload spritesheet data (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::UPLOAD_FAILED: Failed to upload spritesheet data (error " << error << ")";
         glDeleteTextures(1, &newTextureID);
         stbi_image_free(fullData);
         delete[] subImageData;
@@ -288,7 +332,7 @@ bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int a
     
     error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cerr << "ERROR::TEXTURE::MIPMAP_FAILED: Failed to generate mipmaps for spritesheet (error " << error << ")" << std::endl;
+        AZV_LOG_ERROR(Render) << "ERROR::TEXTURE::MIPMAP_FAILED: Failed to generate mipmaps for spritesheet (error " << error << ")";
         // Not fatal, continue
     }
 
@@ -299,7 +343,7 @@ bool Texture::loadFromSpritesheet(const std::string& filepath, int atlasX, int a
     textureID = newTextureID;
     isShared = false;
     
-    std::cout << "Spritesheet texture created successfully with ID: " << textureID << std::endl;
+    AZV_LOG_INFO(Render) << "Spritesheet texture created successfully with ID: " << textureID;
     return true;
 }
 
@@ -0,0 +1,314 @@
+#include "../headers/texture_atlas.h"
+#include "../headers/logger.h"
+#include "../headers/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+// The one stb_image implementation in the build; the game's Texture loader uses it through the core library
+#define STB_IMAGE_IMPLEMENTATION
+#include "../external/stb_image.h"
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] = {'A', 'Z', 'V', 'A', 'T', 'L', 'A', 'S'};
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr int MISSING_TILE_SIZE = 16;
+const char* const SOURCE_EXTENSIONS[] = {".png", ".tga", ".bmp"};
+
+struct DecodedImage {
+    std::string name;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels; // RGBA, bottom row first
+};
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void writeString(std::ofstream& out, const std::string& value) {
+    writeValue(out, static_cast<uint32_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+bool readString(std::ifstream& in, std::string& value) {
+    uint32_t length = 0;
+    if (!readValue(in, length) || length > 4096) {
+        return false;
+    }
+    value.resize(length);
+    in.read(&value[0], length);
+    return static_cast<bool>(in);
+}
+
+void writeRect(std::ofstream& out, const BlockFaceUV& rect) {
+    writeValue(out, rect.u0);
+    writeValue(out, rect.v0);
+    writeValue(out, rect.u1);
+    writeValue(out, rect.v1);
+}
+
+bool readRect(std::ifstream& in, BlockFaceUV& rect) {
+    return readValue(in, rect.u0) && readValue(in, rect.v0) && readValue(in, rect.u1) && readValue(in, rect.v1);
+}
+
+DecodedImage missingTile() {
+    DecodedImage image;
+    image.width = MISSING_TILE_SIZE;
+    image.height = MISSING_TILE_SIZE;
+    image.pixels.resize(static_cast<size_t>(MISSING_TILE_SIZE) * MISSING_TILE_SIZE * 4);
+    for (int y = 0; y < MISSING_TILE_SIZE; ++y) {
+        for (int x = 0; x < MISSING_TILE_SIZE; ++x) {
+            bool magenta = ((x / 8) + (y / 8)) % 2 == 0;
+            uint8_t* pixel = &image.pixels[(static_cast<size_t>(y) * MISSING_TILE_SIZE + x) * 4];
+            pixel[0] = magenta ? 255 : 0;
+            pixel[1] = 0;
+            pixel[2] = magenta ? 255 : 0;
+            pixel[3] = 255;
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+TextureAtlasBuilder::TextureAtlasBuilder(const TextureAtlasSettings& settings) : settings_(settings) {
+    settings_.padding = std::max(0, settings_.padding);
+}
+
+bool TextureAtlasBuilder::build(const std::vector<std::string>& textureNames, TextureAtlas& atlas) {
+    AZV_PROFILE_ZONE("TextureAtlasBuilder::build");
+    loadedFromCache_ = false;
+    decodedImages_ = 0;
+    atlas = TextureAtlas();
+
+    std::vector<SourceStamp> sources = stampSources(textureNames);
+    bool anySource = std::any_of(sources.begin(), sources.end(), [](const SourceStamp& s) { return !s.path.empty(); });
+    if (!anySource) {
+        AZV_LOG_DEBUG(Render) << "No block textures in " << settings_.sourceDirectory << "; keeping the spritesheet";
+        return false;
+    }
+
+    if (readCache(sources, atlas)) {
+        loadedFromCache_ = true;
+        AZV_LOG_INFO(Render) << "Loaded texture atlas from cache " << settings_.cachePath << " (" << atlas.width << "x"
+                             << atlas.height << ", " << atlas.rects.size() << " textures)";
+        return true;
+    }
+
+    atlas = TextureAtlas();
+    if (!pack(sources, atlas)) {
+        return false;
+    }
+    AZV_LOG_INFO(Render) << "Built texture atlas " << atlas.width << "x" << atlas.height << " from " << decodedImages_
+                         << " images";
+    if (!writeCache(sources, atlas)) {
+        AZV_LOG_WARN(Render) << "Could not write texture atlas cache " << settings_.cachePath;
+    }
+    return true;
+}
+
+std::vector<TextureAtlasBuilder::SourceStamp> TextureAtlasBuilder::stampSources(const std::vector<std::string>& textureNames) const {
+    std::vector<std::string> names = textureNames;
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    std::vector<SourceStamp> sources;
+    sources.reserve(names.size());
+    for (const std::string& name : names) {
+        if (name.empty()) {
+            continue;
+        }
+        SourceStamp stamp;
+        stamp.name = name;
+        for (const char* extension : SOURCE_EXTENSIONS) {
+            std::filesystem::path path = std::filesystem::path(settings_.sourceDirectory) / (name + extension);
+            std::error_code error;
+            if (std::filesystem::is_regular_file(path, error)) {
+                stamp.path = path.string();
+                stamp.size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+                stamp.modified = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+                break;
+            }
+        }
+        sources.push_back(std::move(stamp));
+    }
+    return sources;
+}
+
+bool TextureAtlasBuilder::readCache(const std::vector<SourceStamp>& sources, TextureAtlas& atlas) const {
+    std::ifstream in(settings_.cachePath, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t version = 0;
+    int32_t padding = 0;
+    uint32_t sourceCount = 0;
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + sizeof(magic), CACHE_MAGIC) || !readValue(in, version) ||
+        version != CACHE_VERSION || !readValue(in, padding) || padding != settings_.padding ||
+        !readValue(in, sourceCount) || sourceCount != sources.size()) {
+        return false;
+    }
+
+    // Any added, removed, resized or touched source invalidates the whole atlas
+    for (const SourceStamp& source : sources) {
+        std::string name, path;
+        uint64_t size = 0;
+        int64_t modified = 0;
+        if (!readString(in, name) || !readString(in, path) || !readValue(in, size) || !readValue(in, modified) ||
+            name != source.name || path != source.path || size != source.size || modified != source.modified) {
+            return false;
+        }
+    }
+
+    int32_t width = 0, height = 0, maxMipLevel = 0;
+    uint32_t rectCount = 0;
+    if (!readValue(in, width) || !readValue(in, height) || !readValue(in, maxMipLevel) || width <= 0 || height <= 0 ||
+        !readValue(in, rectCount) || rectCount > sources.size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < rectCount; ++i) {
+        std::string name;
+        BlockFaceUV rect;
+        if (!readString(in, name) || !readRect(in, rect)) {
+            return false;
+        }
+        atlas.rects[name] = rect;
+    }
+    if (!readRect(in, atlas.missing)) {
+        return false;
+    }
+
+    atlas.width = width;
+    atlas.height = height;
+    atlas.maxMipLevel = maxMipLevel;
+    atlas.pixels.resize(static_cast<size_t>(width) * height * 4);
+    in.read(reinterpret_cast<char*>(atlas.pixels.data()), static_cast<std::streamsize>(atlas.pixels.size()));
+    return static_cast<bool>(in);
+}
+
+bool TextureAtlasBuilder::writeCache(const std::vector<SourceStamp>& sources, const TextureAtlas& atlas) const {
+    std::filesystem::path cachePath(settings_.cachePath);
+    std::filesystem::path tempPath = cachePath;
+    tempPath += ".tmp";
+    std::error_code error;
+    if (cachePath.has_parent_path()) {
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+    }
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        writeValue(out, CACHE_VERSION);
+        writeValue(out, static_cast<int32_t>(settings_.padding));
+        writeValue(out, static_cast<uint32_t>(sources.size()));
+        for (const SourceStamp& source : sources) {
+            writeString(out, source.name);
+            writeString(out, source.path);
+            writeValue(out, source.size);
+            writeValue(out, source.modified);
+        }
+        writeValue(out, static_cast<int32_t>(atlas.width));
+        writeValue(out, static_cast<int32_t>(atlas.height));
+        writeValue(out, static_cast<int32_t>(atlas.maxMipLevel));
+        writeValue(out, static_cast<uint32_t>(atlas.rects.size()));
+        for (const auto& [name, rect] : atlas.rects) {
+            writeString(out, name);
+            writeRect(out, rect);
+        }
+        writeRect(out, atlas.missing);
+        out.write(reinterpret_cast<const char*>(atlas.pixels.data()), static_cast<std::streamsize>(atlas.pixels.size()));
+        if (!out) {
+            return false;
+        }
+    }
+    // Replace in one step, so a crash mid-write never leaves a truncated cache behind
+    std::filesystem::rename(tempPath, cachePath, error);
+    return !error;
+}
+
+bool TextureAtlasBuilder::pack(const std::vector<SourceStamp>& sources, TextureAtlas& atlas) {
+    AZV_PROFILE_ZONE("TextureAtlasBuilder::pack");
+    std::vector<DecodedImage> images;
+    stbi_set_flip_vertically_on_load(true); // Bottom row first, matching GL's v = 0
+    for (const SourceStamp& source : sources) {
+        if (source.path.empty()) {
+            continue;
+        }
+        int width = 0, height = 0, channels = 0;
+        unsigned char* data = stbi_load(source.path.c_str(), &width, &height, &channels, 4);
+        if (!data) {
+            AZV_LOG_WARN(Render) << "Could not decode block texture " << source.path << ": " << stbi_failure_reason();
+            continue;
+        }
+        DecodedImage image;
+        image.name = source.name;
+        image.width = width;
+        image.height = height;
+        image.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(data);
+        images.push_back(std::move(image));
+        ++decodedImages_;
+    }
+    if (images.empty()) {
+        return false;
+    }
+    images.push_back(missingTile()); // Last, with an empty name
+
+    int padding = settings_.padding;
+    atlas.maxMipLevel = padding > 0 ? static_cast<int>(std::floor(std::log2(padding))) : 0;
+    int alignment = 1 << atlas.maxMipLevel;
+    int largest = 0;
+    for (const DecodedImage& image : images) {
+        largest = std::max({largest, image.width, image.height});
+    }
+    int cell = (largest + 2 * padding + alignment - 1) / alignment * alignment;
+    int tilesPerRow = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(images.size()))));
+    int rows = (static_cast<int>(images.size()) + tilesPerRow - 1) / tilesPerRow;
+    atlas.width = tilesPerRow * cell;
+    atlas.height = rows * cell;
+    atlas.pixels.assign(static_cast<size_t>(atlas.width) * atlas.height * 4, 0);
+
+    for (size_t tile = 0; tile < images.size(); ++tile) {
+        const DecodedImage& image = images[tile];
+        int originX = static_cast<int>(tile % tilesPerRow) * cell + padding;
+        int originY = static_cast<int>(tile / tilesPerRow) * cell + padding;
+        // Copy the tile and extend its edge pixels into the padding
+        for (int y = -padding; y < image.height + padding; ++y) {
+            int sourceY = std::clamp(y, 0, image.height - 1);
+            uint8_t* row = &atlas.pixels[(static_cast<size_t>(originY + y) * atlas.width + originX) * 4];
+            for (int x = -padding; x < image.width + padding; ++x) {
+                int sourceX = std::clamp(x, 0, image.width - 1);
+                const uint8_t* pixel = &image.pixels[(static_cast<size_t>(sourceY) * image.width + sourceX) * 4];
+                std::copy_n(pixel, 4, row + static_cast<ptrdiff_t>(x) * 4);
+            }
+        }
+
+        BlockFaceUV rect;
+        rect.u0 = static_cast<float>(originX) / atlas.width;
+        rect.v0 = static_cast<float>(originY) / atlas.height;
+        rect.u1 = static_cast<float>(originX + image.width) / atlas.width;
+        rect.v1 = static_cast<float>(originY + image.height) / atlas.height;
+        if (image.name.empty()) {
+            atlas.missing = rect;
+        } else {
+            atlas.rects[image.name] = rect;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,147 @@
+#include "../headers/voxel_physics.h"
+#include "../headers/block_registry.h"
+#include "../headers/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// Faces closer than this count as touching, not overlapping, so a body resting on the ground or
+// against a wall is not stuck by float rounding
+constexpr float CONTACT_SKIN = 1e-3f;
+
+} // namespace
+
+VoxelCollider::VoxelCollider(const glm::vec3& gridOrigin, ChunkLookup lookup, bool unloadedIsSolid)
+    : gridOrigin_(gridOrigin), lookup_(std::move(lookup)), unloadedIsSolid_(unloadedIsSolid) {}
+
+void VoxelCollider::beginTick() {
+    chunks_.clear();
+    last_ = nullptr;
+}
+
+const VoxelCollider::ChunkOccupancy& VoxelCollider::chunkAt(const glm::ivec3& chunkKey) {
+    if (last_ && lastKey_ == chunkKey) {
+        return *last_;
+    }
+    auto [it, inserted] = chunks_.try_emplace(chunkKey);
+    if (inserted) {
+        it->second.voxels = lookup_(chunkKey);
+        if (it->second.voxels) {
+            const BlockRegistry& registry = BlockRegistry::getInstance();
+            const std::vector<uint16_t>& palette = it->second.voxels->palette();
+            it->second.hasSolid = std::any_of(palette.begin(), palette.end(), [&](uint16_t type) { return registry.isBlockSolid(type); });
+        }
+    }
+    lastKey_ = chunkKey;
+    last_ = &it->second;
+    return it->second;
+}
+
+bool VoxelCollider::isSolid(const glm::ivec3& block) {
+    const glm::ivec3 chunkKey(chunkCoordinateOf(block.x), chunkCoordinateOf(block.y), chunkCoordinateOf(block.z));
+    const ChunkOccupancy& chunk = chunkAt(chunkKey);
+    if (!chunk.voxels) {
+        return unloadedIsSolid_;
+    }
+    if (!chunk.hasSolid) {
+        return false;
+    }
+    const glm::ivec3 local = block - chunkKey * CHUNK_SIZE_X;
+    return BlockRegistry::getInstance().isBlockSolid(static_cast<uint16_t>(chunk.voxels->at(local.x, local.y, local.z).type));
+}
+
+bool VoxelCollider::layerBlocked(int axis, int layer, int u0, int u1, int v0, int v1) {
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    glm::ivec3 block;
+    block[axis] = layer;
+    for (block[u] = u0; block[u] <= u1; ++block[u]) {
+        for (block[v] = v0; block[v] <= v1; ++block[v]) {
+            if (isSolid(block)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+float VoxelCollider::sweep(const glm::vec3& boxMin, const glm::vec3& boxMax, int axis, float delta) {
+    if (delta == 0.0f) {
+        return 0.0f;
+    }
+    const glm::vec3 lo = boxMin - gridOrigin_;
+    const glm::vec3 hi = boxMax - gridOrigin_;
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    // Blocks the box overlaps across the other two axes
+    const int u0 = static_cast<int>(std::floor(lo[u] + CONTACT_SKIN));
+    const int u1 = static_cast<int>(std::floor(hi[u] - CONTACT_SKIN));
+    const int v0 = static_cast<int>(std::floor(lo[v] + CONTACT_SKIN));
+    const int v1 = static_cast<int>(std::floor(hi[v] - CONTACT_SKIN));
+
+    if (delta > 0.0f) {
+        const int first = static_cast<int>(std::ceil(hi[axis] - CONTACT_SKIN));
+        const int last = static_cast<int>(std::ceil(hi[axis] + delta)) - 1;
+        for (int layer = first; layer <= last; ++layer) {
+            if (layerBlocked(axis, layer, u0, u1, v0, v1)) {
+                return std::clamp(static_cast<float>(layer) - hi[axis], 0.0f, delta);
+            }
+        }
+    } else {
+        const int first = static_cast<int>(std::floor(lo[axis] + CONTACT_SKIN)) - 1;
+        const int last = static_cast<int>(std::floor(lo[axis] + delta));
+        for (int layer = first; layer >= last; --layer) {
+            if (layerBlocked(axis, layer, u0, u1, v0, v1)) {
+                return std::clamp(static_cast<float>(layer + 1) - lo[axis], delta, 0.0f);
+            }
+        }
+    }
+    return delta;
+}
+
+bool VoxelCollider::overlaps(const glm::vec3& boxMin, const glm::vec3& boxMax) {
+    const glm::ivec3 first(glm::floor(boxMin - gridOrigin_ + CONTACT_SKIN));
+    const glm::ivec3 last(glm::floor(boxMax - gridOrigin_ - CONTACT_SKIN));
+    for (int x = first.x; x <= last.x; ++x) {
+        if (layerBlocked(0, x, first.y, last.y, first.z, last.z)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VoxelPhysics::step(VoxelCollider& collider, std::vector<PhysicsBody>& bodies, float deltaTime, const PhysicsSettings& settings) {
+    AZV_PROFILE_ZONE("VoxelPhysics::step");
+    collider.beginTick();
+    for (PhysicsBody& body : bodies) {
+        glm::vec3 down(0.0f, -1.0f, 0.0f);
+        if (settings.planetCenter) {
+            const glm::vec3 toCenter = *settings.planetCenter - body.position;
+            const float distance = glm::length(toCenter);
+            down = distance > 0.0f ? toCenter / distance : down;
+        }
+        body.velocity = glm::clamp(body.velocity + down * (settings.gravity * deltaTime),
+                                   glm::vec3(-settings.terminalVelocity), glm::vec3(settings.terminalVelocity));
+        const glm::vec3 delta = body.velocity * deltaTime;
+
+        // Gravity's main axis first, so a falling body lands before it slides
+        const glm::vec3 pull = glm::abs(down);
+        const int gravityAxis = pull.x > pull.y ? (pull.x > pull.z ? 0 : 2) : (pull.y > pull.z ? 1 : 2);
+        const int axes[3] = {gravityAxis, (gravityAxis + 1) % 3, (gravityAxis + 2) % 3};
+
+        body.onGround = false;
+        for (int axis : axes) {
+            if (delta[axis] == 0.0f) continue;
+            const float moved = collider.sweep(body.position - body.halfExtents, body.position + body.halfExtents, axis, delta[axis]);
+            body.position[axis] += moved;
+            if (moved != delta[axis]) {
+                body.velocity[axis] = 0.0f;
+                if (axis == gravityAxis && delta[axis] * down[axis] > 0.0f) {
+                    body.onGround = true;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "../headers/voxel_raycast.h"
+#include "../headers/block_registry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+static_assert(CHUNK_SIZE_X == CHUNK_SIZE_Y && CHUNK_SIZE_Y == CHUNK_SIZE_Z, "the raycaster expects cubic chunks");
+
+bool passesFilter(const BlockRegistry& registry, RaycastFilter filter, uint16_t type) {
+    switch (filter) {
+        case RaycastFilter::ANY_BLOCK: return type != 0;
+        case RaycastFilter::SOLID: return registry.isBlockSolid(type);
+        case RaycastFilter::OPAQUE: return registry.isBlockOpaque(type);
+    }
+    return false;
+}
+
+// Whether any block of the version can stop the ray; the palette is a handful of types
+bool mayStopRay(const BlockRegistry& registry, RaycastFilter filter, const VoxelData& voxels) {
+    for (uint16_t type : voxels.palette()) {
+        if (passesFilter(registry, filter, type)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+RaycastHit VoxelRaycaster::cast(const glm::vec3& gridOrigin, const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                RaycastFilter filter, const ChunkLookup& lookup) {
+    RaycastHit result;
+    // The walk only ends at a hit or at maxDistance, so it must be finite (a ray with nothing in
+    // front of it would cross empty chunks forever)
+    const float length = glm::length(direction);
+    if (!(length > 0.0f) || !std::isfinite(length) || !(maxDistance >= 0.0f) || !std::isfinite(maxDistance) ||
+        !std::isfinite(origin.x) || !std::isfinite(origin.y) || !std::isfinite(origin.z)) {
+        return result;
+    }
+    const BlockRegistry& registry = BlockRegistry::getInstance();
+    const glm::vec3 dir = direction / length;
+    const glm::vec3 start = origin - gridOrigin;
+
+    // Per axis: the step direction, the ray distance to the next block boundary, the ray distance
+    // between two boundaries, and the voxel index stride. Plain arrays keep the loop in registers.
+    const glm::ivec3 startBlock(glm::floor(start));
+    int block[3] = {startBlock.x, startBlock.y, startBlock.z};
+    int step[3] = {0, 0, 0};
+    float nextBoundary[3];
+    float boundarySpacing[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        nextBoundary[axis] = boundarySpacing[axis] = std::numeric_limits<float>::infinity();
+        if (dir[axis] > 0.0f) {
+            step[axis] = 1;
+            boundarySpacing[axis] = 1.0f / dir[axis];
+            nextBoundary[axis] = (static_cast<float>(block[axis]) + 1.0f - start[axis]) * boundarySpacing[axis];
+        } else if (dir[axis] < 0.0f) {
+            step[axis] = -1;
+            boundarySpacing[axis] = -1.0f / dir[axis];
+            nextBoundary[axis] = (start[axis] - static_cast<float>(block[axis])) * boundarySpacing[axis];
+        }
+    }
+    const int stride[3] = {CHUNK_SIZE_Y * CHUNK_SIZE_Z, CHUNK_SIZE_Z, 1};
+    const int indexStep[3] = {step[0] * stride[0], step[1] * stride[1], step[2] * stride[2]};
+
+    glm::ivec3 chunkKey(chunkCoordinateOf(block[0]), chunkCoordinateOf(block[1]), chunkCoordinateOf(block[2]));
+    int local[3] = {block[0] - chunkKey.x * CHUNK_SIZE_X, block[1] - chunkKey.y * CHUNK_SIZE_Y, block[2] - chunkKey.z * CHUNK_SIZE_Z};
+    int index = static_cast<int>(VoxelData::index(local[0], local[1], local[2]));
+    VoxelSnapshot voxels;
+    bool searchChunk = false;
+    auto enterChunk = [&]() {
+        voxels = lookup(chunkKey);
+        searchChunk = voxels && mayStopRay(registry, filter, *voxels);
+    };
+    enterChunk();
+
+    float distance = 0.0f;
+    int enteredAxis = -1;
+    while (true) {
+        if (searchChunk) {
+            const uint16_t type = static_cast<uint16_t>(voxels->atIndex(static_cast<size_t>(index)).type);
+            if (passesFilter(registry, filter, type)) {
+                result.hit = true;
+                result.blockType = type;
+                result.block = glm::ivec3(block[0], block[1], block[2]);
+                if (enteredAxis >= 0) {
+                    result.normal[enteredAxis] = -step[enteredAxis];
+                }
+                result.distance = distance;
+                return result;
+            }
+        } else {
+            // Nothing in this chunk can stop the ray: jump to the block where it leaves the chunk.
+            // The exit axis is the one whose last boundary inside the chunk comes first; the other
+            // axes advance by the boundaries they cross before that point.
+            int boundariesLeft[3];
+            float exitDistance[3];
+            for (int a = 0; a < 3; ++a) {
+                boundariesLeft[a] = step[a] > 0 ? CHUNK_SIZE_X - local[a] : local[a] + 1;
+                exitDistance[a] = step[a] != 0 ? nextBoundary[a] + static_cast<float>(boundariesLeft[a] - 1) * boundarySpacing[a]
+                                               : std::numeric_limits<float>::infinity();
+            }
+            int exitAxis = exitDistance[0] < exitDistance[1] ? 0 : 1;
+            exitAxis = exitDistance[exitAxis] < exitDistance[2] ? exitAxis : 2;
+            distance = exitDistance[exitAxis];
+            if (distance > maxDistance) {
+                return result;
+            }
+            for (int a = 0; a < 3; ++a) {
+                if (step[a] == 0) continue;
+                int crossed = boundariesLeft[a];
+                if (a != exitAxis) {
+                    crossed = static_cast<int>(std::ceil((distance - nextBoundary[a]) / boundarySpacing[a]));
+                    crossed = std::max(0, std::min(crossed, boundariesLeft[a] - 1));
+                }
+                nextBoundary[a] += static_cast<float>(crossed) * boundarySpacing[a];
+                block[a] += crossed * step[a];
+                local[a] += crossed * step[a];
+            }
+            local[exitAxis] -= step[exitAxis] * CHUNK_SIZE_X;
+            chunkKey[exitAxis] += step[exitAxis];
+            index = static_cast<int>(VoxelData::index(local[0], local[1], local[2]));
+            enteredAxis = exitAxis;
+            enterChunk();
+            continue;
+        }
+
+        // Nearest boundary; ties go to the lower axis
+        int axis = nextBoundary[0] < nextBoundary[1] ? 0 : 1;
+        axis = nextBoundary[axis] < nextBoundary[2] ? axis : 2;
+        distance = nextBoundary[axis];
+        if (distance > maxDistance) {
+            return result;
+        }
+        nextBoundary[axis] += boundarySpacing[axis];
+        block[axis] += step[axis];
+        local[axis] += step[axis];
+        index += indexStep[axis];
+        enteredAxis = axis;
+        if (static_cast<unsigned>(local[axis]) >= static_cast<unsigned>(CHUNK_SIZE_X)) {
+            local[axis] -= step[axis] * CHUNK_SIZE_X;
+            index -= indexStep[axis] * CHUNK_SIZE_X;
+            chunkKey[axis] += step[axis];
+            enterChunk();
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "../headers/window.h"
+#include "../headers/logger.h"
 #include <iostream>
 
 // Static variables to store input state
@@ -11,7 +12,7 @@ Window::Window(int width, int height, const std::string& title)
     
     // Initialize GLFW
     if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to initialize GLFW";
         return;
     }
     
@@ -23,7 +24,7 @@ Window::Window(int width, int height, const std::string& title)
     // Create window
     window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
     if (!window) {
-        std::cerr << "Failed to create GLFW window" << std::endl;
+        AZV_LOG_ERROR(General) << "Failed to create GLFW window";
         glfwTerminate();
         return;
     }
@@ -48,7 +49,7 @@ Window::Window(GLFWwindow* existingWindow, int width, int height)
     
     // The window is already created, just make sure we have the callbacks set
     if (!window) {
-        std::cerr << "Error: Null window handle provided to Window constructor" << std::endl;
+        AZV_LOG_ERROR(General) << "Error: Null window handle provided to Window constructor";
         return;
     }
     
@@ -58,7 +59,7 @@ Window::Window(GLFWwindow* existingWindow, int width, int height)
     glfwSetKeyCallback(window, keyCallback);
     glfwSetCursorPosCallback(window, mouseCallback);
     
-    std::cout << "Window object initialized with existing GLFWwindow handle" << std::endl;
+    AZV_LOG_INFO(General) << "Window object initialized with existing GLFWwindow handle";
 }
 
 Window::~Window() {
@@ -152,9 +153,9 @@ void Window::toggleWireframeMode() {
     wireframeMode = !wireframeMode;
     if (wireframeMode) {
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        std::cout << "Wireframe mode enabled" << std::endl;
+        AZV_LOG_INFO(General) << "Wireframe mode enabled";
     } else {
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        std::cout << "Wireframe mode disabled" << std::endl;
+        AZV_LOG_INFO(General) << "Wireframe mode disabled";
     }
 }
@@ -1,5 +1,12 @@
 #include "../headers/world.h"
+#include "../headers/block_registry.h"
+#include "../headers/profiler.h"
+#include "../headers/logger.h"
+#include "../headers/render_backend.h"
+#include "../headers/mesh_scratch.h"
+#include <array>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <algorithm> // For std::sort
 #include <sys/stat.h> // For mkdir
@@ -10,11 +17,11 @@
 const std::string CHUNK_DATA_DIR = "chunk_data";
 
 // ChunkThreadPool implementation
-ChunkThreadPool::ChunkThreadPool(size_t numThreads) : stop_(false) {
+ChunkThreadPool::ChunkThreadPool(size_t numThreads, const std::string& name) : stop_(false), name_(name) {
     for (size_t i = 0; i < numThreads; ++i) {
-        workers_.emplace_back(&ChunkThreadPool::workerFunction, this);
+        workers_.emplace_back(&ChunkThreadPool::workerFunction, this, i);
     }
-    std::cout << "ChunkThreadPool initialized with " << numThreads << " threads." << std::endl;
+    AZV_LOG_INFO(World) << "ChunkThreadPool '" << name_ << "' initialized with " << numThreads << " threads.";
 }
 
 ChunkThreadPool::~ChunkThreadPool() {
@@ -30,6 +37,16 @@ void ChunkThreadPool::enqueueTask(std::function<void()> task) {
     condition_.notify_one();
 }
 
+size_t ChunkThreadPool::getQueuedTaskCount() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    return tasks_.size();
+}
+
+void ChunkThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    idleCondition_.wait(lock, [this] { return tasks_.empty() && activeTasks_ == 0; });
+}
+
 void ChunkThreadPool::shutdown() {
     {
         std::unique_lock<std::mutex> lock(queueMutex_);
@@ -45,7 +62,8 @@ void ChunkThreadPool::shutdown() {
     workers_.clear();
 }
 
-void ChunkThreadPool::workerFunction() {
+void ChunkThreadPool::workerFunction(size_t workerIndex) {
+    AZV_PROFILE_THREAD_NAME(name_ + " " + std::to_string(workerIndex));
     while (true) {
         std::function<void()> task;
         {
@@ -62,6 +80,7 @@ void ChunkThreadPool::workerFunction() {
             
             task = std::move(tasks_.front());
             tasks_.pop();
+            ++activeTasks_;
         }
         
         try {
@@ -69,10 +88,16 @@ void ChunkThreadPool::workerFunction() {
                 task();
             }
         } catch (const std::exception& e) {
-            std::cerr << "ChunkThreadPool worker caught exception: " << e.what() << std::endl;
+            AZV_LOG_ERROR(World) << "ChunkThreadPool worker caught exception: " << e.what();
         } catch (...) {
-            std::cerr << "ChunkThreadPool worker caught unknown exception." << std::endl;
+            AZV_LOG_ERROR(World) << "ChunkThreadPool worker caught unknown exception.";
         }
+        
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            --activeTasks_;
+        }
+        idleCondition_.notify_all();
     }
 }
 
@@ -94,16 +119,16 @@ World::World(const std::string& worldName, int defaultSeed)
     // Use fewer threads for mesh building (less CPU intensive, more frequent)
     size_t meshBuildThreads = std::max(1u, hardwareThreads / 4);
     
-    chunkGenerationPool_ = std::make_unique<ChunkThreadPool>(chunkGenThreads);
-    meshBuildingPool_ = std::make_unique<ChunkThreadPool>(meshBuildThreads);
+    chunkGenerationPool_ = std::make_unique<ChunkThreadPool>(chunkGenThreads, "ChunkGen");
+    meshBuildingPool_ = std::make_unique<ChunkThreadPool>(meshBuildThreads, "MeshBuild");
     
-    std::cout << "World '" << worldName_ << "' initialized with " 
-              << chunkGenThreads << " chunk generation threads and " 
-              << meshBuildThreads << " mesh building threads. Data path: " << worldDataPath_ << std::endl;
+    AZV_LOG_INFO(World) << "World '" << worldName_ << "' initialized with " 
+                        << chunkGenThreads << " chunk generation threads and " 
+                        << meshBuildThreads << " mesh building threads. Data path: " << worldDataPath_;
 }
 
 World::~World() {
-    std::cout << "Destroying world '" << worldName_ << "'..." << std::endl;
+    AZV_LOG_INFO(World) << "Destroying world '" << worldName_ << "'...";
     
     // Shutdown thread pools
     if (chunkGenerationPool_) {
@@ -114,7 +139,7 @@ World::~World() {
     }
     
     planets_.clear();
-    std::cout << "World '" << worldName_ << "' destroyed." << std::endl;
+    AZV_LOG_INFO(World) << "World '" << worldName_ << "' destroyed.";
 }
 
 void World::createWorldDirectories() {
@@ -123,14 +148,14 @@ void World::createWorldDirectories() {
         std::filesystem::create_directories("shaders"); // Ensure shaders dir exists at root for build if needed
         std::filesystem::create_directories("res/textures"); // Ensure res dir exists for textures
     } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "Error creating directories: " << e.what() << std::endl;
+        AZV_LOG_ERROR(World) << "Error creating directories: " << e.what();
     }
 }
 
 void World::addPlanet(const glm::vec3& position, float radius, int seed, const std::string& name) {
     auto planet = std::make_shared<Planet>(position, radius, seed, name);
     planets_.push_back(planet);
-    std::cout << "Added planet '" << name << "' to world." << std::endl;
+    AZV_LOG_INFO(World) << "Added planet '" << name << "' to world.";
 }
 
 void World::addChunkGenerationTask(const std::function<void()>& task) {
@@ -153,6 +178,10 @@ void World::addMainThreadTask(const std::function<void()>& task) {
 }
 
 void World::processMainThreadTasks() {
+    AZV_PROFILE_ZONE("World::processMainThreadTasks");
+    // GPU objects of chunks destroyed since the last call (possibly on worker threads)
+    RenderBackend::getInstance().processPendingReleases();
+
     std::queue<std::function<void()>> tasksToProcess;
     {
         std::unique_lock<std::mutex> lock(mainThreadTasksMutex_);
@@ -170,9 +199,9 @@ void World::processMainThreadTasks() {
                 task();
                 tasksProcessed++;
             } catch (const std::exception& e) {
-                std::cerr << "Main thread task caught exception: " << e.what() << std::endl;
+                AZV_LOG_ERROR(World) << "Main thread task caught exception: " << e.what();
             } catch (...) {
-                std::cerr << "Main thread task caught unknown exception." << std::endl;
+                AZV_LOG_ERROR(World) << "Main thread task caught unknown exception.";
             }
         }
     }
@@ -190,15 +219,76 @@ void World::reportPerformanceMetrics() {
         int meshesBuilt = meshesBuiltThisSecond_.exchange(0);
         
         if (chunksGenerated > 0 || meshesBuilt > 0) {
-            std::cout << "Performance: " << chunksGenerated << " chunks generated, " 
-                      << meshesBuilt << " meshes built in last " << elapsed.count() << " seconds" << std::endl;
+            AZV_LOG_INFO(World) << "Performance: " << chunksGenerated << " chunks generated, " 
+                                << meshesBuilt << " meshes built in last " << elapsed.count() << " seconds";
+        }
+        if (pipelineMetrics_.completedChunks() > 0) {
+            std::ostringstream report;
+            pipelineMetrics_.printReport(report);
+            AZV_LOG_INFO(World) << report.str();
+        }
+        std::ostringstream meshAllocations;
+        MeshScratch::getStats().printStatus(meshAllocations);
+        AZV_LOG_DEBUG(Meshing) << "Mesh scratch: " << meshAllocations.str();
+        std::ostringstream budget;
+        streamingBudget_.printStatus(budget);
+        AZV_LOG_DEBUG(Streaming) << "Streaming budget: " << budget.str();
+        for (const auto& planet : planets_) {
+            if (planet) {
+                std::ostringstream residency;
+                planet->getResidencyCache().printStats(residency);
+                AZV_LOG_DEBUG(Streaming) << "Residency cache for planet " << planet->getName() << ":\n" << residency.str();
+            }
         }
         
         lastPerformanceReport_ = now;
     }
 }
 
-void World::update(const Camera& camera) {
+bool World::dumpPerformanceMetrics(const std::string& path) const {
+    if (!pipelineMetrics_.writeJSONFile(path)) {
+        return false;
+    }
+    AZV_LOG_INFO(World) << "Chunk pipeline metrics written to " << path;
+    return true;
+}
+
+void World::recordFrameTime(double frameMs) {
+    streamingBudget_.recordFrame(frameMs, getPipelineBacklog());
+}
+
+PipelineBacklog World::getPipelineBacklog() {
+    PipelineBacklog backlog;
+    if (chunkGenerationPool_) {
+        backlog.generationQueued = chunkGenerationPool_->getQueuedTaskCount();
+    }
+    if (meshBuildingPool_) {
+        backlog.meshQueued = meshBuildingPool_->getQueuedTaskCount();
+    }
+    std::unique_lock<std::mutex> lock(mainThreadTasksMutex_);
+    backlog.mainThreadQueued = mainThreadTasks_.size();
+    return backlog;
+}
+
+void World::updateCameraVelocity(const glm::vec3& cameraPosition, float deltaTime) {
+    auto now = std::chrono::steady_clock::now();
+    if (deltaTime <= 0.0f && hasCameraSample_) {
+        deltaTime = std::chrono::duration<float>(now - lastCameraSampleTime_).count();
+    }
+    if (hasCameraSample_ && deltaTime > 0.0f) {
+        glm::vec3 instantVelocity = (cameraPosition - lastCameraPosition_) / deltaTime;
+        // Exponential smoothing with a ~0.25 s time constant, independent of frame rate
+        float alpha = 1.0f - std::exp(-deltaTime / 0.25f);
+        cameraVelocity_ += (instantVelocity - cameraVelocity_) * alpha;
+    }
+    lastCameraPosition_ = cameraPosition;
+    lastCameraSampleTime_ = now;
+    hasCameraSample_ = true;
+}
+
+void World::update(const Camera& camera, float deltaTime) {
+    AZV_PROFILE_ZONE("World::update");
+    updateCameraVelocity(camera.getPosition(), deltaTime);
     for (auto& planet : planets_) {
         if (planet) {
             planet->update(camera, this); // Pass world as context if planet needs to queue chunk tasks
@@ -236,14 +326,260 @@ std::shared_ptr<Block> World::getBlockAtWorldPos(const glm::vec3& worldPos) cons
     return nullptr; // No block found in any planet at this position
 }
 
+std::shared_ptr<Planet> World::getPlanetAt(const glm::vec3& worldPos) const {
+    for (const auto& planet : planets_) {
+        if (!planet) {
+            continue;
+        }
+        const float planetEffectiveRadius = planet->getRadius() + CHUNK_SIZE_X * 1.732f;
+        if (glm::length(worldPos - planet->getPosition()) <= planetEffectiveRadius) {
+            return planet;
+        }
+    }
+    return nullptr;
+}
+
+RaycastHit World::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RaycastFilter filter) const {
+    RaycastHit nearest;
+    const float length = glm::length(direction);
+    if (!(length > 0.0f) || !std::isfinite(length) || std::isnan(maxDistance) ||
+        !std::isfinite(origin.x) || !std::isfinite(origin.y) || !std::isfinite(origin.z)) {
+        return nearest;
+    }
+    const glm::vec3 dir = direction / length;
+    for (const auto& planet : planets_) {
+        if (!planet) {
+            continue;
+        }
+        // Skip planets whose bounding sphere (with the same margin as getBlockAtWorldPos) the
+        // segment misses
+        const glm::vec3 toCenter = planet->getPosition() - origin;
+        const float along = glm::clamp(glm::dot(toCenter, dir), 0.0f, maxDistance);
+        const float planetEffectiveRadius = planet->getRadius() + CHUNK_SIZE_X * 1.732f;
+        if (glm::length(toCenter - dir * along) > planetEffectiveRadius) {
+            continue;
+        }
+        RaycastHit hit = planet->raycast(origin, dir, nearest.hit ? nearest.distance : maxDistance, filter);
+        if (hit.hit && (!nearest.hit || hit.distance < nearest.distance)) {
+            nearest = hit;
+        }
+    }
+    return nearest;
+}
+
+std::shared_ptr<Planet> World::planetTouchingBox(const glm::vec3& worldMin, const glm::vec3& worldMax) const {
+    for (const auto& planet : planets_) {
+        if (!planet) {
+            continue;
+        }
+        const glm::vec3 closest = glm::clamp(planet->getPosition(), worldMin, worldMax);
+        const float planetEffectiveRadius = planet->getRadius() + CHUNK_SIZE_X * 1.732f;
+        if (glm::length(closest - planet->getPosition()) <= planetEffectiveRadius) {
+            return planet;
+        }
+    }
+    return nullptr;
+}
+
+size_t World::queryBlocks(const glm::vec3& worldMin, const glm::vec3& worldMax, std::vector<uint16_t>& blocks,
+                         BlockQueryRegion& region, uint16_t unloadedFill) const {
+    region = BlockQueryRegion();
+    region.planet = planetTouchingBox(worldMin, worldMax).get();
+
+    const glm::vec3 gridOrigin = region.planet ? region.planet->getPosition() : glm::vec3(0.0f);
+    region.minBlock = glm::ivec3(glm::floor(worldMin - gridOrigin));
+    region.size = glm::max(glm::ivec3(glm::floor(worldMax - gridOrigin)) - region.minBlock + 1, glm::ivec3(0));
+    region.worldOrigin = gridOrigin + glm::vec3(region.minBlock);
+    const size_t volume = static_cast<size_t>(region.size.x) * region.size.y * region.size.z;
+    blocks.resize(volume);
+    if (!region.planet) {
+        std::fill(blocks.begin(), blocks.end(), unloadedFill);
+        return volume;
+    }
+    return region.planet->queryBlocks(region.minBlock, region.minBlock + region.size - 1, blocks.data(), unloadedFill);
+}
+
+size_t World::queryBlocksInSphere(const glm::vec3& center, float radius, std::vector<uint16_t>& blocks,
+                                  BlockQueryRegion& region, uint16_t unloadedFill) const {
+    const size_t unloaded = queryBlocks(center - glm::vec3(radius), center + glm::vec3(radius), blocks, region, unloadedFill);
+    const float radiusSquared = radius * radius;
+    size_t i = 0;
+    for (int x = 0; x < region.size.x; ++x) {
+        for (int y = 0; y < region.size.y; ++y) {
+            for (int z = 0; z < region.size.z; ++z, ++i) {
+                const glm::vec3 offset = region.worldOrigin + glm::vec3(x, y, z) + glm::vec3(0.5f) - center;
+                if (glm::dot(offset, offset) > radiusSquared) {
+                    blocks[i] = 0;
+                }
+            }
+        }
+    }
+    return unloaded;
+}
+
+bool World::setBlockAtWorldPos(const glm::vec3& worldPos, uint16_t blockType) {
+    for (const auto& planet : planets_) {
+        if (planet) {
+            float distToPlanetCenter = glm::length(worldPos - planet->getPosition());
+            float planetEffectiveRadius = planet->getRadius() + CHUNK_SIZE_X * 1.732f;
+            if (distToPlanetCenter <= planetEffectiveRadius && planet->setBlockAtWorldPos(worldPos, blockType)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+size_t World::fillBox(const glm::vec3& worldMin, const glm::vec3& worldMax, uint16_t blockType) {
+    std::shared_ptr<Planet> planet = planetTouchingBox(worldMin, worldMax);
+    if (!planet) {
+        return 0;
+    }
+    return planet->editBlocks(glm::ivec3(glm::floor(worldMin - planet->getPosition())), glm::ivec3(glm::floor(worldMax - planet->getPosition())),
+                              [blockType](const glm::ivec3&, uint16_t) { return blockType; });
+}
+
+size_t World::fillSphere(const glm::vec3& center, float radius, uint16_t blockType) {
+    std::shared_ptr<Planet> planet = planetTouchingBox(center - glm::vec3(radius), center + glm::vec3(radius));
+    if (!planet) {
+        return 0;
+    }
+    const glm::vec3 gridCenter = center - planet->getPosition();
+    const float radiusSquared = radius * radius;
+    return planet->editBlocks(glm::ivec3(glm::floor(gridCenter - radius)), glm::ivec3(glm::floor(gridCenter + radius)),
+                              [=](const glm::ivec3& block, uint16_t current) {
+                                  const glm::vec3 offset = glm::vec3(block) + glm::vec3(0.5f) - gridCenter;
+                                  return glm::dot(offset, offset) <= radiusSquared ? blockType : current;
+                              });
+}
+
+size_t World::replaceBlocks(const glm::vec3& worldMin, const glm::vec3& worldMax, uint16_t fromType, uint16_t toType) {
+    std::shared_ptr<Planet> planet = planetTouchingBox(worldMin, worldMax);
+    if (!planet) {
+        return 0;
+    }
+    return planet->editBlocks(glm::ivec3(glm::floor(worldMin - planet->getPosition())), glm::ivec3(glm::floor(worldMax - planet->getPosition())),
+                              [=](const glm::ivec3&, uint16_t current) { return current == fromType ? toType : current; });
+}
+
+size_t World::explode(const glm::vec3& center, float radius, float power) {
+    std::shared_ptr<Planet> planet = planetTouchingBox(center - glm::vec3(radius), center + glm::vec3(radius));
+    if (!planet || !(radius > 0.0f)) {
+        return 0;
+    }
+    const BlockRegistry& registry = BlockRegistry::getInstance();
+    const glm::vec3 gridCenter = center - planet->getPosition();
+    return planet->editBlocks(glm::ivec3(glm::floor(gridCenter - radius)), glm::ivec3(glm::floor(gridCenter + radius)),
+                              [&](const glm::ivec3& block, uint16_t current) -> uint16_t {
+                                  if (current == 0) {
+                                      return 0;
+                                  }
+                                  const float distance = glm::length(glm::vec3(block) + glm::vec3(0.5f) - gridCenter);
+                                  if (distance > radius) {
+                                      return current;
+                                  }
+                                  const BlockDefinition* definition = registry.getBlockDefinition(current);
+                                  if (!definition) {
+                                      return 0;
+                                  }
+                                  const bool breaks = definition->hardness >= 0.0f &&
+                                                      definition->blast_resistance < power * (1.0f - distance / radius);
+                                  return breaks ? 0 : current;
+                              });
+}
+
+void World::rebuildEditedChunks() {
+    for (auto& planet : planets_) {
+        if (planet) {
+            planet->rebuildEditedChunks();
+        }
+    }
+}
+
+// What a chunk mesh and its light are built from for one block type: face culling flags,
+// opacity, light level and face UVs
+struct BlockMeshInputs {
+    bool solid = false;
+    bool transparent = false;
+    bool opaque = false;      // Blocks light and darkens ambient occlusion corners
+    uint8_t lightLevel = 0;
+    std::array<BlockFaceUV, BlockRegistry::FACE_COUNT> uvs;
+};
+
+static std::vector<BlockMeshInputs> captureBlockMeshInputs(const BlockRegistry& registry) {
+    std::vector<BlockMeshInputs> inputs(BlockRegistry::MAX_BLOCK_TYPES);
+    for (uint16_t id = 0; id < BlockRegistry::MAX_BLOCK_TYPES; ++id) {
+        inputs[id].solid = registry.isBlockSolid(id);
+        inputs[id].transparent = registry.isBlockTransparent(id);
+        inputs[id].opaque = registry.isBlockOpaque(id);
+        inputs[id].lightLevel = registry.getBlockLightLevel(id);
+        for (int face = 0; face < BlockRegistry::FACE_COUNT; ++face) {
+            inputs[id].uvs[face] = registry.getFaceUV(id, face);
+        }
+    }
+    return inputs;
+}
+
+size_t World::reloadBlockDefinitions(const std::string& blocksDirectory, const std::function<void()>& rebuildTextures) {
+    AZV_PROFILE_ZONE("World::reloadBlockDefinitions");
+    auto start = std::chrono::steady_clock::now();
+    // Workers read the registry while generating and meshing; nothing new is queued while we wait
+    chunkGenerationPool_->waitIdle();
+    meshBuildingPool_->waitIdle();
+
+    BlockRegistry& registry = BlockRegistry::getInstance();
+    std::vector<BlockMeshInputs> before = captureBlockMeshInputs(registry);
+    if (!registry.reloadDefinitions(blocksDirectory)) {
+        AZV_LOG_ERROR(World) << "Block definition reload from " << blocksDirectory << " failed";
+        return 0;
+    }
+    if (rebuildTextures) {
+        rebuildTextures();
+    }
+    std::vector<BlockMeshInputs> after = captureBlockMeshInputs(registry);
+
+    std::vector<bool> changedTypes(BlockRegistry::MAX_BLOCK_TYPES, false);
+    std::vector<bool> cullingTypes(BlockRegistry::MAX_BLOCK_TYPES, false);
+    std::vector<bool> lightTypes(BlockRegistry::MAX_BLOCK_TYPES, false);
+    size_t changedCount = 0;
+    for (size_t id = 0; id < before.size(); ++id) {
+        const BlockMeshInputs& a = before[id];
+        const BlockMeshInputs& b = after[id];
+        // Opacity also shades the ambient occlusion of faces next to the block, across chunk borders
+        cullingTypes[id] = a.solid != b.solid || a.transparent != b.transparent || a.opaque != b.opaque;
+        lightTypes[id] = a.opaque != b.opaque || a.lightLevel != b.lightLevel;
+        bool uvsChanged = false;
+        for (int face = 0; face < BlockRegistry::FACE_COUNT; ++face) {
+            uvsChanged |= a.uvs[face].u0 != b.uvs[face].u0 || a.uvs[face].v0 != b.uvs[face].v0 ||
+                          a.uvs[face].u1 != b.uvs[face].u1 || a.uvs[face].v1 != b.uvs[face].v1;
+        }
+        changedTypes[id] = cullingTypes[id] || uvsChanged;
+        changedCount += changedTypes[id] || lightTypes[id] ? 1 : 0;
+    }
+
+    size_t markedChunks = 0;
+    if (changedCount > 0) {
+        for (auto& planet : planets_) {
+            if (planet) {
+                markedChunks += planet->markChunksUsingBlocks(changedTypes, cullingTypes, lightTypes);
+            }
+        }
+        rebuildEditedChunks();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    AZV_LOG_INFO(World) << "Reloaded block definitions: " << changedCount << " block types changed, "
+                        << markedChunks << " chunks re-meshed in " << ms << " ms";
+    return markedChunks;
+}
+
 /* Commenting out leftover flat-world save function
 void World::saveAllChunks() const {
-    std::cout << "Saving all chunks..." << std::endl;
+    AZV_LOG_INFO(World) << "Saving all chunks...";
     for (auto const& [pos, chunk] : chunks) { // 'chunks' member no longer exists
         if (chunk) {
             chunk->saveToFile(CHUNK_DATA_DIR); // CHUNK_DATA_DIR is also not a member, was a global
         }
     }
-    std::cout << "All chunks saved." << std::endl;
+    AZV_LOG_INFO(World) << "All chunks saved.";
 }
 */ 
\ No newline at end of file